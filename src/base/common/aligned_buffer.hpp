@@ -0,0 +1,109 @@
+#ifndef __ALIGNED_BUFFER_HPP__
+#define __ALIGNED_BUFFER_HPP__
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * @brief   按缓存行对齐的可复用缓冲区
+ * @tparam  T                                   元素类型（平凡类型）
+ * 1. 64 字节对齐，满足 SSE/AVX 对齐加载和避免伪共享
+ * 2. Resize 只在容量不足时重新分配，逐帧复用时不产生额外分配
+ * 3. 不初始化内容，由调用者写入
+ */
+template <typename T>
+class AlignedBuffer
+{
+public:
+    static constexpr size_t kAlignment = 64;
+
+    AlignedBuffer() = default;
+    explicit AlignedBuffer(size_t count)
+    {
+        Resize(count);
+    }
+    ~AlignedBuffer()
+    {
+        Release();
+    }
+
+    AlignedBuffer(const AlignedBuffer&)            = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+    {
+        Swap(other);
+    }
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    void Resize(size_t count)
+    {
+        if (count > m_capacity)
+        {
+            Release();
+            m_data     = static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(kAlignment)));
+            m_capacity = count;
+        }
+        m_size = count;
+    }
+
+    T* Data()
+    {
+        return m_data;
+    }
+
+    const T* Data() const
+    {
+        return m_data;
+    }
+
+    size_t Size() const
+    {
+        return m_size;
+    }
+
+    T& operator[](size_t index)
+    {
+        return m_data[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return m_data[index];
+    }
+
+private:
+    void Release()
+    {
+        if (m_data)
+        {
+            ::operator delete(m_data, std::align_val_t(kAlignment));
+        }
+        m_data     = nullptr;
+        m_size     = 0;
+        m_capacity = 0;
+    }
+
+    void Swap(AlignedBuffer& other)
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+private:
+    T*     m_data     = nullptr; // 数据
+    size_t m_size     = 0;       // 当前大小（元素个数）
+    size_t m_capacity = 0;       // 已分配容量（元素个数）
+};
+
+#endif
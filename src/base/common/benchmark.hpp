@@ -0,0 +1,34 @@
+#ifndef __BENCHMARK_HPP__
+#define __BENCHMARK_HPP__
+
+#include <chrono>
+
+/**
+ * @brief   测量 func 执行 iterations 次的平均耗时
+ * @param   func                    [IN]        被测函数
+ * @param   iterations              [IN]        执行次数
+ * @return  单次平均耗时（秒）
+ */
+template <typename Func>
+inline double benchmark_seconds(Func&& func, int iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        func();
+    }
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    return cost.count() / (iterations > 0 ? iterations : 1);
+}
+
+/**
+ * @brief   测量 func 处理 bytes 字节数据的吞吐
+ * @return  吞吐（GB/s）
+ */
+template <typename Func>
+inline double benchmark_throughput(Func&& func, size_t bytes, int iterations)
+{
+    return static_cast<double>(bytes) / benchmark_seconds(func, iterations) / 1e9;
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef __COLOR_HPP__
+#define __COLOR_HPP__
+
+/**
+ * @brief   RGB 转 BT.601 有限范围 YUV（8 位定点）
+ *  Y = ( 66R + 129G +  25B + 128) >> 8 + 16
+ *  U = (-38R -  74G + 112B + 128) >> 8 + 128
+ *  V = (112R -  94G -  18B + 128) >> 8 + 128
+ * 输入为 [0, 255] 时结果落在 Y [16, 235]、UV [16, 240]，不需要再截断
+ */
+inline void color_rgb_to_yuv(int r, int g, int b, int& y, int& u, int& v)
+{
+    y = ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+    u = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+    v = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+}
+
+/**
+ * @brief   预乘 RGBA 转预乘 YUV：Y' = a * Y，与先除 alpha 再转换再乘回 alpha 等价
+ * 转换是仿射的，线性部分直接作用在预乘分量上，偏移量按 alpha 缩放即可
+ * @param   r                       [IN]        预乘红色分量 R * a / 255
+ * @param   a                       [IN]        alpha [0, 255]
+ */
+inline void color_rgb_to_yuv_premultiplied(int r, int g, int b, int a, int& y, int& u, int& v)
+{
+    y = ((66 * r + 129 * g + 25 * b + 128) >> 8) + (16 * a + 127) / 255;
+    u = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + (128 * a + 127) / 255;
+    v = ((112 * r - 94 * g - 18 * b + 128) >> 8) + (128 * a + 127) / 255;
+}
+
+#endif
@@ -0,0 +1,548 @@
+#ifndef __LOUDNESS_HPP__
+#define __LOUDNESS_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "aligned_buffer.hpp"
+#include "simd.h"
+
+/**
+ * @brief   EBU R128 / ITU-R BS.1770-4 响度计（流式）
+ * 1. K 计权为两级双二阶（高搁架 + RLB 高通），系数按采样率由模拟原型推导；
+ *    声道按 4 个一组放进 SIMD 的 4 路（SSE2/NEON），每组的滤波状态和能量累加都在寄存器中，
+ *    输入先按块解交织为帧优先、组对齐的布局，不足 4 的位置补零
+ * 2. 每 100 ms 结算一个子块的加权均方，瞬时响度为最近 4 个子块（400 ms），短期响度为最近 30 个（3 s）；
+ *    综合响度对 400 ms 块做 -70 LUFS 绝对门限和 -10 LU 相对门限，响度范围（LRA）对短期值做 -20 LU 相对门限后取 10% ~ 95% 分位差
+ * 3. 真峰值：采样率低于 96 kHz 时 4 倍、低于 192 kHz 时 2 倍过采样，每相位 12 抽头的多相 FIR
+ *    （Blackman 窗 sinc），同样按声道组向量化，每个输入采样只加载一次、同时累加所有相位
+ * 4. 6 声道按 5.1（FL FR FC LFE BL BR）加权：LFE 为 0，环绕为 1.41，其他布局所有声道为 1
+ * 输入为交织 float，满幅 [-1.0, 1.0)；没有足够数据时响度返回 -inf
+ */
+class LoudnessMeter
+{
+public:
+    static constexpr int    kBlockFrames  = 1024;  // 每次解交织的帧数
+    static constexpr int    kPeakTaps     = 12;    // 真峰值每相位抽头数
+    static constexpr double kAbsoluteGate = -70.0; // 绝对门限，LUFS
+    static constexpr double kPi           = 3.14159265358979323846;
+
+    /**
+     * @param   sampleRate              [IN]        采样率
+     * @param   channels                [IN]        声道数
+     */
+    LoudnessMeter(int sampleRate, int channels)
+        : m_channels(std::max(channels, 1))
+        , m_stride((m_channels + 3) / 4 * 4)
+        , m_step(std::max((sampleRate + 5) / 10, 1))
+        , m_factor(sampleRate < 96000 ? 4 : sampleRate < 192000 ? 2 : 1)
+        , m_weights(m_stride, 0.0)
+        , m_lanes(static_cast<size_t>(kPeakTaps - 1 + kBlockFrames) * m_stride)
+        , m_state(static_cast<size_t>(m_stride) * 4)
+        , m_sum(m_stride)
+        , m_peak(m_stride)
+        , m_sample_peak(m_stride)
+        , m_peak_taps(static_cast<size_t>(kPeakTaps) * m_factor * 4)
+    {
+        for (int c = 0; c < m_channels; c++)
+        {
+            m_weights[c] = 1.0;
+        }
+        if (m_channels == 6)
+        {
+            m_weights[3] = 0.0;
+            m_weights[4] = 1.41;
+            m_weights[5] = 1.41;
+        }
+        DesignKWeighting(sampleRate);
+        DesignTruePeak();
+        Reset();
+    }
+
+    /**
+     * @brief   清空所有状态和历史，声道权重保持不变
+     */
+    void Reset()
+    {
+        memset(m_lanes.Data(), 0, m_lanes.Size() * sizeof(float));
+        memset(m_state.Data(), 0, m_state.Size() * sizeof(float));
+        memset(m_sum.Data(), 0, m_sum.Size() * sizeof(float));
+        memset(m_peak.Data(), 0, m_peak.Size() * sizeof(float));
+        memset(m_sample_peak.Data(), 0, m_sample_peak.Size() * sizeof(float));
+        m_filled = 0;
+        m_recent.clear();
+        m_blocks.clear();
+        m_short.clear();
+        m_max_momentary  = 0.0;
+        m_max_short_term = 0.0;
+    }
+
+    /**
+     * @brief   修改声道权重（默认见类说明），0 表示不参与响度计算
+     */
+    void SetChannelWeight(int channel, double weight)
+    {
+        if (channel >= 0 && channel < m_channels)
+        {
+            m_weights[channel] = weight;
+        }
+    }
+
+    int Channels() const
+    {
+        return m_channels;
+    }
+
+    /**
+     * @brief   输入交织数据
+     * @param   in                      [IN]        输入，frames * channels 个采样
+     * @param   frames                  [IN]        帧数
+     */
+    void Process(const float* in, int frames)
+    {
+        const int history = kPeakTaps - 1;
+        for (int i = 0; i < frames; i += kBlockFrames)
+        {
+            int    n     = std::min(kBlockFrames, frames - i);
+            float* lanes = m_lanes.Data() + static_cast<size_t>(history) * m_stride;
+            for (int f = 0; f < n; f++)
+            {
+                const float* src = in + static_cast<size_t>(i + f) * m_channels;
+                float*       dst = lanes + static_cast<size_t>(f) * m_stride;
+                for (int c = 0; c < m_channels; c++)
+                {
+                    dst[c] = src[c];
+                }
+            }
+
+            for (int g = 0; g < m_stride; g += 4)
+            {
+                TruePeak(lanes + g, n, g);
+            }
+            // K 计权与能量累加，按 100 ms 子块边界切分
+            for (int f = 0; f < n;)
+            {
+                int count = std::min(n - f, m_step - m_filled);
+                for (int g = 0; g < m_stride; g += 4)
+                {
+                    Filter(lanes + static_cast<size_t>(f) * m_stride + g, count, g);
+                }
+                f += count;
+                m_filled += count;
+                if (m_filled == m_step)
+                {
+                    FinishSubBlock();
+                }
+            }
+
+            // 保留最后 history 帧作为下一块的真峰值历史
+            memmove(m_lanes.Data(), m_lanes.Data() + static_cast<size_t>(n) * m_stride, static_cast<size_t>(history) * m_stride * sizeof(float));
+        }
+    }
+
+    /**
+     * @brief   瞬时响度（最近 400 ms），LUFS
+     */
+    double Momentary() const
+    {
+        return m_recent.size() >= 4 ? Lufs(Mean(m_recent.end() - 4, m_recent.end())) : -Infinity();
+    }
+
+    /**
+     * @brief   短期响度（最近 3 s），LUFS
+     */
+    double ShortTerm() const
+    {
+        return m_recent.size() >= 30 ? Lufs(Mean(m_recent.end() - 30, m_recent.end())) : -Infinity();
+    }
+
+    double MaxMomentary() const
+    {
+        return Lufs(m_max_momentary);
+    }
+
+    double MaxShortTerm() const
+    {
+        return Lufs(m_max_short_term);
+    }
+
+    /**
+     * @brief   综合响度（门限后的 400 ms 块能量均值），LUFS
+     */
+    double Integrated() const
+    {
+        double absolute = Energy(kAbsoluteGate);
+        double relative = GatedMean(m_blocks, absolute) * 0.1;
+        return Lufs(GatedMean(m_blocks, std::max(absolute, relative)));
+    }
+
+    /**
+     * @brief   响度范围，LU
+     */
+    double LoudnessRange() const
+    {
+        double              absolute = Energy(kAbsoluteGate);
+        double              relative = GatedMean(m_short, absolute) * 0.01;
+        std::vector<double> values;
+        for (double e : m_short)
+        {
+            if (e > absolute && e > relative)
+            {
+                values.push_back(e);
+            }
+        }
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        auto percentile = [&](double p) {
+            return values[static_cast<size_t>((values.size() - 1) * p + 0.5)];
+        };
+        return Lufs(percentile(0.95)) - Lufs(percentile(0.10));
+    }
+
+    /**
+     * @brief   所有声道的最大真峰值，dBTP
+     */
+    double TruePeak() const
+    {
+        return Decibel(*std::max_element(m_peak.Data(), m_peak.Data() + m_stride));
+    }
+
+    /**
+     * @brief   所有声道的最大采样峰值，dBFS
+     */
+    double SamplePeak() const
+    {
+        return Decibel(*std::max_element(m_sample_peak.Data(), m_sample_peak.Data() + m_stride));
+    }
+
+private:
+    static double Infinity()
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    static double Lufs(double energy)
+    {
+        return energy > 0.0 ? -0.691 + 10.0 * std::log10(energy) : -Infinity();
+    }
+
+    static double Energy(double lufs)
+    {
+        return std::pow(10.0, (lufs + 0.691) / 10.0);
+    }
+
+    static double Decibel(float peak)
+    {
+        return peak > 0.0f ? 20.0 * std::log10(peak) : -Infinity();
+    }
+
+    template <typename Iterator>
+    static double Mean(Iterator begin, Iterator end)
+    {
+        double sum = 0.0;
+        for (Iterator it = begin; it != end; ++it)
+        {
+            sum += *it;
+        }
+        return begin == end ? 0.0 : sum / (end - begin);
+    }
+
+    static double GatedMean(const std::vector<double>& energies, double gate)
+    {
+        double sum   = 0.0;
+        size_t count = 0;
+        for (double e : energies)
+        {
+            if (e > gate)
+            {
+                sum += e;
+                count++;
+            }
+        }
+        return count ? sum / count : 0.0;
+    }
+
+    /**
+     * BS.1770 的两级滤波器：高搁架（约 +4 dB，1.68 kHz）与 RLB 高通（38 Hz）
+     */
+    void DesignKWeighting(int sampleRate)
+    {
+        double f0 = 1681.974450955533;
+        double g  = 3.999843853973347;
+        double q  = 0.7071752369554196;
+        double k  = std::tan(kPi * f0 / sampleRate);
+        double vh = std::pow(10.0, g / 20.0);
+        double vb = std::pow(vh, 0.4996667741545416);
+        double a0 = 1.0 + k / q + k * k;
+        m_coef[0] = static_cast<float>((vh + vb * k / q + k * k) / a0);
+        m_coef[1] = static_cast<float>(2.0 * (k * k - vh) / a0);
+        m_coef[2] = static_cast<float>((vh - vb * k / q + k * k) / a0);
+        m_coef[3] = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        m_coef[4] = static_cast<float>((1.0 - k / q + k * k) / a0);
+
+        f0        = 38.13547087602444;
+        q         = 0.5003270373238773;
+        k         = std::tan(kPi * f0 / sampleRate);
+        a0        = 1.0 + k / q + k * k;
+        m_coef[5] = 1.0f;
+        m_coef[6] = -2.0f;
+        m_coef[7] = 1.0f;
+        m_coef[8] = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        m_coef[9] = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+
+    /**
+     * 原型为 kPeakTaps * factor 抽头、截止在原奈奎斯特频率的 sinc，每相位归一化直流增益；
+     * 系数按 [抽头][相位] 展开成 4 路相同的值，内循环直接加载
+     */
+    void DesignTruePeak()
+    {
+        int                 length = kPeakTaps * m_factor;
+        std::vector<double> h(length);
+        for (int n = 0; n < length; n++)
+        {
+            double t      = (n - (length - 1) / 2.0) / m_factor;
+            double sinc   = t == 0.0 ? 1.0 : std::sin(kPi * t) / (kPi * t);
+            double x      = 2.0 * kPi * n / (length - 1);
+            double window = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+            h[n]          = sinc * window;
+        }
+        for (int p = 0; p < m_factor; p++)
+        {
+            double sum = 0.0;
+            for (int k = 0; k < kPeakTaps; k++)
+            {
+                sum += h[k * m_factor + p];
+            }
+            for (int k = 0; k < kPeakTaps; k++)
+            {
+                float* dst = m_peak_taps.Data() + (static_cast<size_t>(k) * m_factor + p) * 4;
+                std::fill(dst, dst + 4, static_cast<float>(h[k * m_factor + p] / sum));
+            }
+        }
+    }
+
+    /**
+     * 一组 4 个声道的 K 计权，src 为帧优先布局（步长 m_stride），平方和累加到 m_sum
+     */
+    void Filter(const float* src, int frames, int group)
+    {
+        const float* c     = m_coef;
+        float*       state = m_state.Data() + static_cast<size_t>(group) * 4;
+        float*       sum   = m_sum.Data() + group;
+#if SIMD_SSE2
+        __m128 b0 = _mm_set1_ps(c[0]), b1 = _mm_set1_ps(c[1]), b2 = _mm_set1_ps(c[2]), a1 = _mm_set1_ps(c[3]), a2 = _mm_set1_ps(c[4]);
+        __m128 d1 = _mm_set1_ps(c[8]), d2 = _mm_set1_ps(c[9]);
+        __m128 s0 = _mm_loadu_ps(state), s1 = _mm_loadu_ps(state + 4), s2 = _mm_loadu_ps(state + 8), s3 = _mm_loadu_ps(state + 12);
+        __m128 acc = _mm_loadu_ps(sum);
+        for (int f = 0; f < frames; f++)
+        {
+            // 转置直接 II 型；第二级分子为 1, -2, 1
+            __m128 x  = _mm_loadu_ps(src + static_cast<size_t>(f) * m_stride);
+            __m128 y1 = _mm_add_ps(_mm_mul_ps(b0, x), s0);
+            s0        = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(b1, x), s1), _mm_mul_ps(a1, y1));
+            s1        = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y1));
+            __m128 y2 = _mm_add_ps(y1, s2);
+            s2        = _mm_sub_ps(_mm_sub_ps(s3, _mm_add_ps(y1, y1)), _mm_mul_ps(d1, y2));
+            s3        = _mm_sub_ps(y1, _mm_mul_ps(d2, y2));
+            acc       = _mm_add_ps(acc, _mm_mul_ps(y2, y2));
+        }
+        _mm_storeu_ps(state, s0);
+        _mm_storeu_ps(state + 4, s1);
+        _mm_storeu_ps(state + 8, s2);
+        _mm_storeu_ps(state + 12, s3);
+        _mm_storeu_ps(sum, acc);
+#elif SIMD_NEON
+        float32x4_t b0 = vdupq_n_f32(c[0]), b1 = vdupq_n_f32(c[1]), b2 = vdupq_n_f32(c[2]), a1 = vdupq_n_f32(c[3]), a2 = vdupq_n_f32(c[4]);
+        float32x4_t d1 = vdupq_n_f32(c[8]), d2 = vdupq_n_f32(c[9]);
+        float32x4_t s0 = vld1q_f32(state), s1 = vld1q_f32(state + 4), s2 = vld1q_f32(state + 8), s3 = vld1q_f32(state + 12);
+        float32x4_t acc = vld1q_f32(sum);
+        for (int f = 0; f < frames; f++)
+        {
+            float32x4_t x  = vld1q_f32(src + static_cast<size_t>(f) * m_stride);
+            float32x4_t y1 = vaddq_f32(vmulq_f32(b0, x), s0);
+            s0             = vsubq_f32(vaddq_f32(vmulq_f32(b1, x), s1), vmulq_f32(a1, y1));
+            s1             = vsubq_f32(vmulq_f32(b2, x), vmulq_f32(a2, y1));
+            float32x4_t y2 = vaddq_f32(y1, s2);
+            s2             = vsubq_f32(vsubq_f32(s3, vaddq_f32(y1, y1)), vmulq_f32(d1, y2));
+            s3             = vsubq_f32(y1, vmulq_f32(d2, y2));
+            acc            = vaddq_f32(acc, vmulq_f32(y2, y2));
+        }
+        vst1q_f32(state, s0);
+        vst1q_f32(state + 4, s1);
+        vst1q_f32(state + 8, s2);
+        vst1q_f32(state + 12, s3);
+        vst1q_f32(sum, acc);
+#else
+        for (int lane = 0; lane < 4; lane++)
+        {
+            float s0 = state[lane], s1 = state[4 + lane], s2 = state[8 + lane], s3 = state[12 + lane];
+            float acc = sum[lane];
+            for (int i = 0; i < frames; i++)
+            {
+                float x  = src[static_cast<size_t>(i) * m_stride + lane];
+                float y1 = c[0] * x + s0;
+                s0       = c[1] * x + s1 - c[3] * y1;
+                s1       = c[2] * x - c[4] * y1;
+                float y2 = y1 + s2;
+                s2       = s3 - (y1 + y1) - c[8] * y2;
+                s3       = y1 - c[9] * y2;
+                acc      = acc + y2 * y2;
+            }
+            state[lane]      = s0;
+            state[4 + lane]  = s1;
+            state[8 + lane]  = s2;
+            state[12 + lane] = s3;
+            sum[lane]        = acc;
+        }
+#endif
+    }
+
+    /**
+     * 一组 4 个声道的采样峰值与过采样峰值；src 之前有 kPeakTaps - 1 帧历史
+     */
+    void TruePeak(const float* src, int frames, int group)
+    {
+        float*       peak   = m_peak.Data() + group;
+        float*       sample = m_sample_peak.Data() + group;
+        const float* taps   = m_peak_taps.Data();
+#if SIMD_SSE2
+        const __m128 sign = _mm_set1_ps(-0.0f);
+        __m128       tp   = _mm_loadu_ps(peak);
+        __m128       sp   = _mm_loadu_ps(sample);
+        for (int f = 0; f < frames; f++)
+        {
+            __m128 acc[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+            for (int k = 0; k < kPeakTaps; k++)
+            {
+                __m128       x = _mm_loadu_ps(src + static_cast<ptrdiff_t>(f - k) * m_stride);
+                const float* h = taps + static_cast<size_t>(k) * m_factor * 4;
+                for (int p = 0; p < m_factor; p++)
+                {
+                    acc[p] = _mm_add_ps(acc[p], _mm_mul_ps(x, _mm_load_ps(h + p * 4)));
+                }
+            }
+            for (int p = 0; p < m_factor; p++)
+            {
+                tp = _mm_max_ps(tp, _mm_andnot_ps(sign, acc[p]));
+            }
+            sp = _mm_max_ps(sp, _mm_andnot_ps(sign, _mm_loadu_ps(src + static_cast<size_t>(f) * m_stride)));
+        }
+        _mm_storeu_ps(peak, _mm_max_ps(tp, sp));
+        _mm_storeu_ps(sample, sp);
+#elif SIMD_NEON
+        float32x4_t tp = vld1q_f32(peak);
+        float32x4_t sp = vld1q_f32(sample);
+        for (int f = 0; f < frames; f++)
+        {
+            float32x4_t acc[4] = {vdupq_n_f32(0.0f), vdupq_n_f32(0.0f), vdupq_n_f32(0.0f), vdupq_n_f32(0.0f)};
+            for (int k = 0; k < kPeakTaps; k++)
+            {
+                float32x4_t  x = vld1q_f32(src + static_cast<ptrdiff_t>(f - k) * m_stride);
+                const float* h = taps + static_cast<size_t>(k) * m_factor * 4;
+                for (int p = 0; p < m_factor; p++)
+                {
+                    acc[p] = vaddq_f32(acc[p], vmulq_f32(x, vld1q_f32(h + p * 4)));
+                }
+            }
+            for (int p = 0; p < m_factor; p++)
+            {
+                tp = vmaxq_f32(tp, vabsq_f32(acc[p]));
+            }
+            sp = vmaxq_f32(sp, vabsq_f32(vld1q_f32(src + static_cast<size_t>(f) * m_stride)));
+        }
+        vst1q_f32(peak, vmaxq_f32(tp, sp));
+        vst1q_f32(sample, sp);
+#else
+        for (int lane = 0; lane < 4; lane++)
+        {
+            float tp = peak[lane];
+            float sp = sample[lane];
+            for (int i = 0; i < frames; i++)
+            {
+                for (int p = 0; p < m_factor; p++)
+                {
+                    float acc = 0.0f;
+                    for (int k = 0; k < kPeakTaps; k++)
+                    {
+                        acc += src[static_cast<ptrdiff_t>(i - k) * m_stride + lane] * taps[(static_cast<size_t>(k) * m_factor + p) * 4];
+                    }
+                    tp = std::max(tp, std::fabs(acc));
+                }
+                sp = std::max(sp, std::fabs(src[static_cast<size_t>(i) * m_stride + lane]));
+            }
+            peak[lane]   = std::max(tp, sp);
+            sample[lane] = sp;
+        }
+#endif
+    }
+
+    /**
+     * 结算 100 ms 子块：加权均方进入最近 30 个子块的窗口，更新 400 ms 块和 3 s 短期值
+     */
+    void FinishSubBlock()
+    {
+        double energy = 0.0;
+        for (int c = 0; c < m_channels; c++)
+        {
+            energy += m_weights[c] * m_sum[c] / m_step;
+        }
+        memset(m_sum.Data(), 0, m_sum.Size() * sizeof(float));
+        m_filled = 0;
+
+        // 静音后滤波状态指数衰减，提前清零避免进入非规格化数
+        for (size_t i = 0; i < m_state.Size(); i++)
+        {
+            if (std::fabs(m_state[i]) < 1e-15f)
+            {
+                m_state[i] = 0.0f;
+            }
+        }
+
+        m_recent.push_back(energy);
+        if (m_recent.size() > 30)
+        {
+            m_recent.erase(m_recent.begin());
+        }
+        if (m_recent.size() >= 4)
+        {
+            double momentary = Mean(m_recent.end() - 4, m_recent.end());
+            m_blocks.push_back(momentary);
+            m_max_momentary = std::max(m_max_momentary, momentary);
+        }
+        if (m_recent.size() >= 30)
+        {
+            double shortTerm = Mean(m_recent.begin(), m_recent.end());
+            m_short.push_back(shortTerm);
+            m_max_short_term = std::max(m_max_short_term, shortTerm);
+        }
+    }
+
+private:
+    int                  m_channels;       // 声道数
+    int                  m_stride;         // 声道数向上取整到 4
+    int                  m_step;           // 100 ms 子块帧数
+    int                  m_factor;         // 真峰值过采样倍数
+    float                m_coef[10];       // K 计权两级系数：b0 b1 b2 a1 a2 x 2
+    std::vector<double>  m_weights;        // 声道权重
+    AlignedBuffer<float> m_lanes;          // 解交织的块（帧优先，步长 m_stride），前 kPeakTaps - 1 帧为历史
+    AlignedBuffer<float> m_state;          // 滤波状态，每组 4 个向量
+    AlignedBuffer<float> m_sum;            // 当前子块的平方和
+    AlignedBuffer<float> m_peak;           // 每声道真峰值
+    AlignedBuffer<float> m_sample_peak;    // 每声道采样峰值
+    AlignedBuffer<float> m_peak_taps;      // 真峰值多相系数（展开为 4 路）
+    int                  m_filled;         // 当前子块已累加的帧数
+    std::vector<double>  m_recent;         // 最近 30 个子块的能量
+    std::vector<double>  m_blocks;         // 所有 400 ms 块的能量（综合响度门限用）
+    std::vector<double>  m_short;          // 所有 3 s 短期能量（响度范围用）
+    double               m_max_momentary;  // 最大瞬时能量
+    double               m_max_short_term; // 最大短期能量
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef __PARALLEL_HPP__
+#define __PARALLEL_HPP__
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief   获取可用的工作线程数
+ * @return  硬件线程数（至少为1）
+ * hardware_concurrency 在 Linux 上每次都要读 sysfs，结果只取一次
+ */
+inline int parallel_thread_count()
+{
+    static const int count = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    return count;
+}
+
+/**
+ * @brief   按行带（row band）并行执行
+ * @param   rows                    [IN]        总行数
+ * @param   func                    [IN]        回调 void(int begin, int end)，处理 [begin, end) 行
+ * @param   min_rows                [IN]        每个线程最少处理的行数，避免小图开线程得不偿失
+ * 最后一个行带在调用线程上执行，行数不足时直接串行
+ */
+template <typename Func>
+inline void parallel_for_rows(int rows, Func&& func, int min_rows = 16)
+{
+    if (rows <= 0)
+    {
+        return;
+    }
+    int bands = std::min(parallel_thread_count(), (rows + min_rows - 1) / std::max(min_rows, 1));
+    if (bands <= 1)
+    {
+        func(0, rows);
+        return;
+    }
+
+    int                      step = (rows + bands - 1) / bands;
+    std::vector<std::thread> threads;
+    threads.reserve(bands - 1);
+    int begin = 0;
+    for (int i = 0; i < bands - 1 && begin + step < rows; i++)
+    {
+        threads.emplace_back([&func, begin, step] { func(begin, begin + step); });
+        begin += step;
+    }
+    func(begin, rows);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+#endif
@@ -0,0 +1,376 @@
+#ifndef __RESAMPLE_HPP__
+#define __RESAMPLE_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "aligned_buffer.hpp"
+#include "simd.h"
+
+/**
+ * @brief   n 个 float 的点积（FIR 内循环），SSE2/NEON 两组累加器各 4 路
+ * 求和顺序固定，结果与标量实现相差舍入误差
+ */
+inline float resample_dot(const float* x, const float* h, int n)
+{
+    int   i   = 0;
+    float sum = 0.0f;
+#if SIMD_SSE2
+    __m128 a0 = _mm_setzero_ps();
+    __m128 a1 = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8)
+    {
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(h + i)));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(h + i + 4)));
+    }
+    a0  = _mm_add_ps(a0, a1);
+    a0  = _mm_add_ps(a0, _mm_movehl_ps(a0, a0));
+    a0  = _mm_add_ss(a0, _mm_shuffle_ps(a0, a0, 1));
+    sum = _mm_cvtss_f32(a0);
+#elif SIMD_NEON
+    float32x4_t a0 = vdupq_n_f32(0.0f);
+    float32x4_t a1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= n; i += 8)
+    {
+        a0 = vmlaq_f32(a0, vld1q_f32(x + i), vld1q_f32(h + i));
+        a1 = vmlaq_f32(a1, vld1q_f32(x + i + 4), vld1q_f32(h + i + 4));
+    }
+    a0            = vaddq_f32(a0, a1);
+    float32x2_t s = vadd_f32(vget_low_f32(a0), vget_high_f32(a0));
+    sum           = vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+    for (; i < n; i++)
+    {
+        sum += x[i] * h[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief   有理数比例的多相带限重采样（流式）
+ * 1. 输入/输出采样率约分为 up / down，输出第 n 个采样位于输入时间 n * down / up；
+ *    相位数不超过 kMaxPhases 时每个相位一组系数，否则按 kMaxPhases 量化相位并在相邻两组之间线性插值
+ * 2. 原型滤波器为 Kaiser 窗的 sinc，截止频率取两个采样率中较低奈奎斯特频率的 kRolloff 倍；
+ *    降采样时抽头数按 down / up 放大，每组系数归一化保证直流增益为 1
+ * 3. 内部按声道保存输入历史，块之间延续相位和历史，分块调用与一次性调用结果相同；
+ *    Flush 补零输出尾部，总输出帧数为 ceil(输入帧数 * up / down)
+ * 4. 采样率相同时直通，只做平面/交织转换；输出缓冲区不足时剩余输入同样保存在历史中，下次调用或 Flush 时输出
+ * 输出始终为交织 float，不做钳位
+ */
+class Resampler
+{
+public:
+    static constexpr int    kDefaultTaps = 64;   // 上采样或等比时每个相位的抽头数
+    static constexpr int    kMaxTaps     = 1024; // 大倍率降采样时抽头数上限
+    static constexpr int    kMaxPhases   = 1024; // 系数表相位数上限
+    static constexpr double kRolloff     = 0.92; // 截止频率 / 奈奎斯特频率
+    static constexpr double kKaiserBeta  = 8.0;  // Kaiser 窗参数，约 80 dB 阻带衰减
+    static constexpr double kPi          = 3.14159265358979323846;
+
+    /**
+     * @param   inRate                  [IN]        输入采样率
+     * @param   outRate                 [IN]        输出采样率
+     * @param   channels                [IN]        声道数
+     * @param   taps                    [IN]        每个相位的抽头数（向上取整到 8 的倍数）
+     */
+    Resampler(int inRate, int outRate, int channels, int taps = kDefaultTaps)
+        : m_in_rate(std::max(inRate, 1))
+        , m_out_rate(std::max(outRate, 1))
+        , m_channels(std::max(channels, 1))
+        , m_history(m_channels)
+    {
+        int g     = std::gcd(m_in_rate, m_out_rate);
+        m_up      = m_out_rate / g;
+        m_down    = m_in_rate / g;
+        m_bypass  = m_up == m_down;
+        double ds = std::max(1.0, static_cast<double>(m_down) / m_up);
+        m_taps    = std::min((static_cast<int>(std::ceil(std::max(taps, 8) * ds)) + 7) / 8 * 8, kMaxTaps);
+        m_half    = m_taps / 2;
+        m_phases  = std::min(m_up, kMaxPhases);
+        if (!m_bypass)
+        {
+            BuildBank(ds);
+        }
+        Reset();
+    }
+
+    /**
+     * @brief   清空历史和相位，之后的输出与新建的重采样器相同
+     */
+    void Reset()
+    {
+        // 预置 half - 1 个零，使第一个输出以第一个输入采样为中心；直通时历史只存放未输出的输入
+        int preload = m_bypass ? 0 : m_half - 1;
+        for (auto& history : m_history)
+        {
+            history.assign(preload, 0.0f);
+        }
+        m_count     = preload;
+        m_pos       = preload;
+        m_phase     = 0;
+        m_in_total  = 0;
+        m_out_total = 0;
+    }
+
+    int InputRate() const
+    {
+        return m_in_rate;
+    }
+
+    int OutputRate() const
+    {
+        return m_out_rate;
+    }
+
+    int Channels() const
+    {
+        return m_channels;
+    }
+
+    /**
+     * @brief   再输入 frames 帧时最多产生的输出帧数，调用方按它分配输出缓冲区
+     */
+    int MaxOutput(int frames) const
+    {
+        if (m_bypass)
+        {
+            return m_count + frames;
+        }
+        return static_cast<int>((static_cast<int64_t>(m_count - m_pos + frames) * m_up + m_phase) / m_down) + 2;
+    }
+
+    /**
+     * @brief   输入结束后 Flush 还会输出的帧数
+     */
+    int RemainingOutput() const
+    {
+        if (m_bypass)
+        {
+            return m_count;
+        }
+        return static_cast<int>((m_in_total * m_up + m_down - 1) / m_down - m_out_total);
+    }
+
+    /**
+     * @brief   输入平面数据
+     * @param   planes                  [IN]        每个声道一个平面，channels 个指针
+     * @param   frames                  [IN]        输入帧数
+     * @param   out                     [OUT]       输出（交织）
+     * @param   capacity                [IN]        输出最多帧数，不足时剩余输出留到下次调用
+     * @return  输出帧数
+     */
+    int Process(const float* const* planes, int frames, float* out, int capacity)
+    {
+        if (m_bypass && m_count == 0 && frames <= capacity)
+        {
+            for (int i = 0; i < frames; i++)
+            {
+                for (int c = 0; c < m_channels; c++)
+                {
+                    out[i * m_channels + c] = planes[c][i];
+                }
+            }
+            m_in_total += frames;
+            m_out_total += frames;
+            return frames;
+        }
+        for (int c = 0; c < m_channels; c++)
+        {
+            m_history[c].insert(m_history[c].end(), planes[c], planes[c] + frames);
+        }
+        m_count += frames;
+        m_in_total += frames;
+        return m_bypass ? Pass(out, capacity) : Produce(out, capacity, INT64_MAX);
+    }
+
+    /**
+     * @brief   输入交织数据，参数同 Process
+     */
+    int ProcessInterleaved(const float* in, int frames, float* out, int capacity)
+    {
+        if (m_bypass && m_count == 0 && frames <= capacity)
+        {
+            memcpy(out, in, static_cast<size_t>(frames) * m_channels * sizeof(float));
+            m_in_total += frames;
+            m_out_total += frames;
+            return frames;
+        }
+        for (int c = 0; c < m_channels; c++)
+        {
+            std::vector<float>& history = m_history[c];
+            history.resize(m_count + frames);
+            for (int i = 0; i < frames; i++)
+            {
+                history[m_count + i] = in[i * m_channels + c];
+            }
+        }
+        m_count += frames;
+        m_in_total += frames;
+        return m_bypass ? Pass(out, capacity) : Produce(out, capacity, INT64_MAX);
+    }
+
+    /**
+     * @brief   输入结束，补零输出剩余的采样
+     * @param   out                     [OUT]       输出（交织）
+     * @param   capacity                [IN]        输出最多帧数，RemainingOutput() 即可容纳全部输出
+     * @return  输出帧数
+     */
+    int Flush(float* out, int capacity)
+    {
+        if (m_bypass)
+        {
+            return Pass(out, capacity);
+        }
+        for (auto& history : m_history)
+        {
+            history.resize(m_count + m_half + 1, 0.0f);
+        }
+        m_count += m_half + 1;
+        int64_t total = (m_in_total * m_up + m_down - 1) / m_down;
+        return Produce(out, capacity, total);
+    }
+
+private:
+    static double BesselI0(double x)
+    {
+        double sum  = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 64 && term > sum * 1e-12; k++)
+        {
+            term *= (x / (2 * k)) * (x / (2 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    /**
+     * 第 p 组系数对应相位 p / phases，第 j 个抽头作用于输入 pos - half + 1 + j，
+     * 到输出时刻的距离 t = p / phases + half - 1 - j；插值模式多建一组 p = phases
+     */
+    void BuildBank(double ds)
+    {
+        int    rows   = m_phases + (m_phases < m_up ? 1 : 0);
+        double cutoff = kRolloff / ds; // 相对输入奈奎斯特频率
+        double norm   = BesselI0(kKaiserBeta);
+        m_bank.Resize(static_cast<size_t>(rows) * m_taps);
+        m_blend.Resize(m_taps);
+        for (int p = 0; p < rows; p++)
+        {
+            float* coef = m_bank.Data() + static_cast<size_t>(p) * m_taps;
+            double sum  = 0.0;
+            for (int j = 0; j < m_taps; j++)
+            {
+                double t      = static_cast<double>(p) / m_phases + m_half - 1 - j;
+                double x      = t / m_half;
+                double window = std::fabs(x) < 1.0 ? BesselI0(kKaiserBeta * std::sqrt(1.0 - x * x)) / norm : 0.0;
+                double arg    = kPi * cutoff * t;
+                double sinc   = std::fabs(arg) < 1e-9 ? 1.0 : std::sin(arg) / arg;
+                double value  = cutoff * sinc * window;
+                coef[j]       = static_cast<float>(value);
+                sum += value;
+            }
+            for (int j = 0; j < m_taps; j++)
+            {
+                coef[j] = static_cast<float>(coef[j] / sum);
+            }
+        }
+    }
+
+    const float* Coefficients()
+    {
+        if (m_phases == m_up)
+        {
+            return m_bank.Data() + static_cast<size_t>(m_phase) * m_taps;
+        }
+        int64_t      scaled = static_cast<int64_t>(m_phase) * m_phases;
+        int          row    = static_cast<int>(scaled / m_up);
+        float        w      = static_cast<float>(scaled % m_up) / m_up;
+        const float* a      = m_bank.Data() + static_cast<size_t>(row) * m_taps;
+        const float* b      = a + m_taps;
+        for (int j = 0; j < m_taps; j++)
+        {
+            m_blend[j] = a[j] + w * (b[j] - a[j]);
+        }
+        return m_blend.Data();
+    }
+
+    /**
+     * 直通：按顺序输出历史中未输出的输入
+     */
+    int Pass(float* out, int capacity)
+    {
+        int n = std::min(m_count, capacity);
+        for (int c = 0; c < m_channels; c++)
+        {
+            const float* history = m_history[c].data();
+            for (int i = 0; i < n; i++)
+            {
+                out[i * m_channels + c] = history[i];
+            }
+        }
+        for (auto& history : m_history)
+        {
+            history.erase(history.begin(), history.begin() + n);
+        }
+        m_count -= n;
+        m_out_total += n;
+        return n;
+    }
+
+    int Produce(float* out, int capacity, int64_t limit)
+    {
+        int n = 0;
+        while (n < capacity && m_pos + m_half < m_count && m_out_total < limit)
+        {
+            const float* coef  = Coefficients();
+            int          start = m_pos - m_half + 1;
+            for (int c = 0; c < m_channels; c++)
+            {
+                out[n * m_channels + c] = resample_dot(m_history[c].data() + start, coef, m_taps);
+            }
+            n++;
+            m_out_total++;
+            m_phase += m_down;
+            m_pos += m_phase / m_up;
+            m_phase %= m_up;
+        }
+
+        // 丢弃之后不再用到的历史
+        int drop = std::min(m_pos - (m_half - 1), m_count);
+        if (drop > 0)
+        {
+            for (auto& history : m_history)
+            {
+                history.erase(history.begin(), history.begin() + drop);
+            }
+            m_count -= drop;
+            m_pos -= drop;
+        }
+        return n;
+    }
+
+private:
+    int                             m_in_rate;   // 输入采样率
+    int                             m_out_rate;  // 输出采样率
+    int                             m_channels;  // 声道数
+    int                             m_up;        // 约分后的输出采样率
+    int                             m_down;      // 约分后的输入采样率
+    bool                            m_bypass;    // 采样率相同，直通
+    int                             m_taps;      // 每组系数的抽头数
+    int                             m_half;      // 抽头数的一半
+    int                             m_phases;    // 系数组数
+    AlignedBuffer<float>            m_bank;      // 多相系数表
+    AlignedBuffer<float>            m_blend;     // 相位插值后的系数
+    std::vector<std::vector<float>> m_history;   // 每个声道的输入历史
+    int                             m_count;     // 历史采样数（直通时为尚未输出的输入帧数）
+    int                             m_pos;       // 下一个输出对应的输入位置（整数部分）
+    int64_t                         m_phase;     // 下一个输出的相位（分子，分母为 m_up）
+    int64_t                         m_in_total;  // 累计输入帧数
+    int64_t                         m_out_total; // 累计输出帧数
+};
+
+#endif
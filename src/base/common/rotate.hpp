@@ -0,0 +1,429 @@
+#ifndef __ROTATE_HPP__
+#define __ROTATE_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "parallel.hpp"
+#include "simd.h"
+
+/**
+ * @brief   旋转/翻转方式，覆盖 EXIF 的全部 8 种方向
+ */
+enum RotateMode
+{
+    ROTATE_0          = 0, // 不变（拷贝）
+    ROTATE_90         = 1, // 顺时针 90 度
+    ROTATE_180        = 2, // 180 度
+    ROTATE_270        = 3, // 顺时针 270 度（逆时针 90 度）
+    ROTATE_FLIP_H     = 4, // 水平翻转（左右镜像）
+    ROTATE_FLIP_V     = 5, // 垂直翻转（上下镜像）
+    ROTATE_TRANSPOSE  = 6, // 转置（沿主对角线）
+    ROTATE_TRANSVERSE = 7, // 反转置（沿副对角线）
+};
+
+/**
+ * @brief   旋转后宽高是否互换
+ */
+inline bool rotate_swaps_axes(RotateMode mode)
+{
+    return mode == ROTATE_90 || mode == ROTATE_270 || mode == ROTATE_TRANSPOSE || mode == ROTATE_TRANSVERSE;
+}
+
+/**
+ * @brief   旋转方式的名字，同时用作输出文件扩展名
+ */
+inline const char* rotate_mode_name(RotateMode mode)
+{
+    switch (mode)
+    {
+    case ROTATE_90: return "rot90";
+    case ROTATE_180: return "rot180";
+    case ROTATE_270: return "rot270";
+    case ROTATE_FLIP_H: return "fliph";
+    case ROTATE_FLIP_V: return "flipv";
+    case ROTATE_TRANSPOSE: return "transpose";
+    case ROTATE_TRANSVERSE: return "transverse";
+    default: return "rot0";
+    }
+}
+
+/**
+ * @brief   8x8 字节块转置：dst[x][y] = src[y][x]（SSE2 三级 unpack / NEON 三级 vtrn）
+ */
+inline void rotate_transpose_8x8_u8(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride)
+{
+#if SIMD_SSE2
+    __m128i r[8];
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * srcStride));
+    }
+    __m128i a0 = _mm_unpacklo_epi8(r[0], r[1]);
+    __m128i a1 = _mm_unpacklo_epi8(r[2], r[3]);
+    __m128i a2 = _mm_unpacklo_epi8(r[4], r[5]);
+    __m128i a3 = _mm_unpacklo_epi8(r[6], r[7]);
+    __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+    __m128i c[4];
+    c[0] = _mm_unpacklo_epi32(b0, b2); // 第 0、1 列
+    c[1] = _mm_unpackhi_epi32(b0, b2); // 第 2、3 列
+    c[2] = _mm_unpacklo_epi32(b1, b3); // 第 4、5 列
+    c[3] = _mm_unpackhi_epi32(b1, b3); // 第 6、7 列
+    for (int i = 0; i < 4; i++)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (2 * i) * dstStride), c[i]);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (2 * i + 1) * dstStride), _mm_srli_si128(c[i], 8));
+    }
+#elif SIMD_NEON
+    uint8x8_t r[8];
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = vld1_u8(src + i * srcStride);
+    }
+    uint8x8x2_t  t01 = vtrn_u8(r[0], r[1]);
+    uint8x8x2_t  t23 = vtrn_u8(r[2], r[3]);
+    uint8x8x2_t  t45 = vtrn_u8(r[4], r[5]);
+    uint8x8x2_t  t67 = vtrn_u8(r[6], r[7]);
+    uint16x4x2_t s02 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]), vreinterpret_u16_u8(t23.val[0]));
+    uint16x4x2_t s13 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]), vreinterpret_u16_u8(t23.val[1]));
+    uint16x4x2_t s46 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]), vreinterpret_u16_u8(t67.val[0]));
+    uint16x4x2_t s57 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]), vreinterpret_u16_u8(t67.val[1]));
+    uint32x2x2_t q04 = vtrn_u32(vreinterpret_u32_u16(s02.val[0]), vreinterpret_u32_u16(s46.val[0]));
+    uint32x2x2_t q15 = vtrn_u32(vreinterpret_u32_u16(s13.val[0]), vreinterpret_u32_u16(s57.val[0]));
+    uint32x2x2_t q26 = vtrn_u32(vreinterpret_u32_u16(s02.val[1]), vreinterpret_u32_u16(s46.val[1]));
+    uint32x2x2_t q37 = vtrn_u32(vreinterpret_u32_u16(s13.val[1]), vreinterpret_u32_u16(s57.val[1]));
+    vst1_u8(dst + 0 * dstStride, vreinterpret_u8_u32(q04.val[0]));
+    vst1_u8(dst + 1 * dstStride, vreinterpret_u8_u32(q15.val[0]));
+    vst1_u8(dst + 2 * dstStride, vreinterpret_u8_u32(q26.val[0]));
+    vst1_u8(dst + 3 * dstStride, vreinterpret_u8_u32(q37.val[0]));
+    vst1_u8(dst + 4 * dstStride, vreinterpret_u8_u32(q04.val[1]));
+    vst1_u8(dst + 5 * dstStride, vreinterpret_u8_u32(q15.val[1]));
+    vst1_u8(dst + 6 * dstStride, vreinterpret_u8_u32(q26.val[1]));
+    vst1_u8(dst + 7 * dstStride, vreinterpret_u8_u32(q37.val[1]));
+#else
+    for (int y = 0; y < 8; y++)
+    {
+        for (int x = 0; x < 8; x++)
+        {
+            dst[x * dstStride + y] = src[y * srcStride + x];
+        }
+    }
+#endif
+}
+
+/**
+ * @brief   8x8 的 16 位块转置（NV12/NV21 的 UV 对按一个像素处理）
+ */
+inline void rotate_transpose_8x8_u16(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride)
+{
+#if SIMD_SSE2
+    __m128i r[8];
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * srcStride));
+    }
+    __m128i a[8], b[8];
+    for (int i = 0; i < 4; i++)
+    {
+        a[2 * i]     = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]); // 两行的第 0 ~ 3 列
+        a[2 * i + 1] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]); // 两行的第 4 ~ 7 列
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        b[4 * i]     = _mm_unpacklo_epi32(a[4 * i], a[4 * i + 2]);     // 四行的第 0、1 列
+        b[4 * i + 1] = _mm_unpackhi_epi32(a[4 * i], a[4 * i + 2]);     // 四行的第 2、3 列
+        b[4 * i + 2] = _mm_unpacklo_epi32(a[4 * i + 1], a[4 * i + 3]); // 四行的第 4、5 列
+        b[4 * i + 3] = _mm_unpackhi_epi32(a[4 * i + 1], a[4 * i + 3]); // 四行的第 6、7 列
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (2 * i) * dstStride), _mm_unpacklo_epi64(b[i], b[i + 4]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (2 * i + 1) * dstStride), _mm_unpackhi_epi64(b[i], b[i + 4]));
+    }
+#elif SIMD_NEON
+    uint16x8_t r[8];
+    for (int i = 0; i < 8; i++)
+    {
+        r[i] = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i * srcStride));
+    }
+    uint16x8x2_t t01 = vtrnq_u16(r[0], r[1]);
+    uint16x8x2_t t23 = vtrnq_u16(r[2], r[3]);
+    uint16x8x2_t t45 = vtrnq_u16(r[4], r[5]);
+    uint16x8x2_t t67 = vtrnq_u16(r[6], r[7]);
+    uint32x4x2_t s02 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0])); // 第 0/4 列、第 2/6 列
+    uint32x4x2_t s13 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1])); // 第 1/5 列、第 3/7 列
+    uint32x4x2_t s46 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t s57 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+    const uint32x4_t top[4]    = {s02.val[0], s13.val[0], s02.val[1], s13.val[1]};
+    const uint32x4_t bottom[4] = {s46.val[0], s57.val[0], s46.val[1], s57.val[1]};
+    for (int i = 0; i < 4; i++)
+    {
+        uint16_t* lo = reinterpret_cast<uint16_t*>(dst + i * dstStride);
+        uint16_t* hi = reinterpret_cast<uint16_t*>(dst + (i + 4) * dstStride);
+        vst1q_u16(lo, vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(top[i]), vget_low_u32(bottom[i]))));
+        vst1q_u16(hi, vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(top[i]), vget_high_u32(bottom[i]))));
+    }
+#else
+    for (int y = 0; y < 8; y++)
+    {
+        for (int x = 0; x < 8; x++)
+        {
+            memcpy(dst + x * dstStride + y * 2, src + y * srcStride + x * 2, 2);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief   4x4 的 32 位块转置（RGBA）
+ */
+inline void rotate_transpose_4x4_u32(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride)
+{
+#if SIMD_SSE2
+    __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + srcStride));
+    __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * srcStride));
+    __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * srcStride));
+    __m128i a0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i a1 = _mm_unpackhi_epi32(r0, r1);
+    __m128i a2 = _mm_unpacklo_epi32(r2, r3);
+    __m128i a3 = _mm_unpackhi_epi32(r2, r3);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(a0, a2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + dstStride), _mm_unpackhi_epi64(a0, a2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * dstStride), _mm_unpacklo_epi64(a1, a3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * dstStride), _mm_unpackhi_epi64(a1, a3));
+#elif SIMD_NEON
+    uint32x4x2_t t01 = vtrnq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(src)), vld1q_u32(reinterpret_cast<const uint32_t*>(src + srcStride)));
+    uint32x4x2_t t23 = vtrnq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(src + 2 * srcStride)), vld1q_u32(reinterpret_cast<const uint32_t*>(src + 3 * srcStride)));
+    vst1q_u32(reinterpret_cast<uint32_t*>(dst), vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+    vst1q_u32(reinterpret_cast<uint32_t*>(dst + dstStride), vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+    vst1q_u32(reinterpret_cast<uint32_t*>(dst + 2 * dstStride), vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+    vst1q_u32(reinterpret_cast<uint32_t*>(dst + 3 * dstStride), vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+#else
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            memcpy(dst + x * dstStride + y * 4, src + y * srcStride + x * 4, 4);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief   转置一个不超过分块大小的区域：整块用 8x8 / 4x4 内核，右侧和底部余下的像素逐个拷贝
+ * @tparam  Bpp                                 每像素字节数（1 / 2 / 3 / 4），3 字节没有块内核，逐像素拷贝
+ */
+template <int Bpp>
+inline void rotate_transpose_tile(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride, int width, int height)
+{
+    constexpr int kBlock = Bpp == 4 ? 4 : 8;
+
+    int blockWidth  = 0;
+    int blockHeight = 0;
+    if constexpr (Bpp != 3)
+    {
+        blockWidth  = width / kBlock * kBlock;
+        blockHeight = height / kBlock * kBlock;
+        for (int y = 0; y < blockHeight; y += kBlock)
+        {
+            for (int x = 0; x < blockWidth; x += kBlock)
+            {
+                const uint8_t* s = src + y * srcStride + x * Bpp;
+                uint8_t*       d = dst + x * dstStride + y * Bpp;
+                if constexpr (Bpp == 1)
+                {
+                    rotate_transpose_8x8_u8(s, srcStride, d, dstStride);
+                }
+                else if constexpr (Bpp == 2)
+                {
+                    rotate_transpose_8x8_u16(s, srcStride, d, dstStride);
+                }
+                else
+                {
+                    rotate_transpose_4x4_u32(s, srcStride, d, dstStride);
+                }
+            }
+        }
+    }
+
+    // 右侧余下的列（所有行）和底部余下的行（块覆盖的列）
+    for (int y = 0; y < height; y++)
+    {
+        const uint8_t* s     = src + y * srcStride;
+        int            begin = y < blockHeight ? blockWidth : 0;
+        for (int x = begin; x < width; x++)
+        {
+            memcpy(dst + x * dstStride + y * Bpp, s + x * Bpp, Bpp);
+        }
+    }
+}
+
+/**
+ * @brief   整个平面转置：按 32x32 像素分块，源和目标在块内都只涉及 32 行，避免大图逐列访问时 TLB 和缓存抖动；
+ *          目标行（源列）按行带多线程
+ * 行跨度可以为负，用于组合出旋转和反转置
+ */
+template <int Bpp>
+inline void rotate_transpose(const uint8_t* src, ptrdiff_t srcStride, uint8_t* dst, ptrdiff_t dstStride, int width, int height)
+{
+    constexpr int kTile = 32;
+
+    auto rows = [&](int begin, int end) {
+        for (int tx = begin; tx < end; tx += kTile)
+        {
+            int tileWidth = std::min(kTile, end - tx);
+            for (int ty = 0; ty < height; ty += kTile)
+            {
+                rotate_transpose_tile<Bpp>(src + ty * srcStride + tx * Bpp, srcStride, dst + tx * dstStride + ty * Bpp, dstStride, tileWidth, std::min(kTile, height - ty));
+            }
+        }
+    };
+    parallel_for_rows(width, rows, kTile);
+}
+
+/**
+ * @brief   一行像素左右颠倒：dst[x] = src[width - 1 - x]
+ */
+template <int Bpp>
+inline void rotate_reverse_row(uint8_t* dst, const uint8_t* src, int width)
+{
+    int x = 0;
+#if SIMD_SSE2
+    if constexpr (Bpp != 3)
+    {
+        // 每次 16 字节：先颠倒 4 个 32 位，再按需要颠倒 16 位和字节
+        constexpr int kStep = 16 / Bpp;
+        for (; x + kStep <= width; x += kStep)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (width - x - kStep) * Bpp));
+            v         = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+            if constexpr (Bpp <= 2)
+            {
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            }
+            if constexpr (Bpp == 1)
+            {
+                v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * Bpp), v);
+        }
+    }
+#elif SIMD_NEON
+    if constexpr (Bpp != 3)
+    {
+        constexpr int kStep = 16 / Bpp;
+        for (; x + kStep <= width; x += kStep)
+        {
+            uint8x16_t v = vld1q_u8(src + (width - x - kStep) * Bpp);
+            if constexpr (Bpp == 1)
+            {
+                v = vrev64q_u8(v);
+            }
+            else if constexpr (Bpp == 2)
+            {
+                v = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(v)));
+            }
+            else
+            {
+                v = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(v)));
+            }
+            vst1q_u8(dst + x * Bpp, vcombine_u8(vget_high_u8(v), vget_low_u8(v)));
+        }
+    }
+#endif
+    for (; x < width; x++)
+    {
+        memcpy(dst + x * Bpp, src + (width - 1 - x) * Bpp, Bpp);
+    }
+}
+
+/**
+ * @brief   旋转/翻转一个平面
+ * 1. 转置类（90 / 270 / 转置 / 反转置）统一为分块转置：90 度把源按行倒序读（负行跨度），
+ *    270 度把目标按行倒序写，反转置两者都倒序
+ * 2. 翻转类（180 / 水平 / 垂直）逐行处理，水平方向用 SIMD 颠倒字节序，按行带多线程
+ * @tparam  Bpp                                 每像素字节数：1（平面）、2（UV 交织）、3（RGB24）、4（RGBA）
+ * @param   src                     [IN]        源平面
+ * @param   srcStride               [IN]        源平面行跨度（字节）
+ * @param   dst                     [OUT]       目标平面，转置类的宽高为 height x width，不能与 src 重叠
+ * @param   dstStride               [IN]        目标平面行跨度（字节）
+ * @param   width                   [IN]        源平面宽度（像素）
+ * @param   height                  [IN]        源平面高度
+ * @param   mode                    [IN]        旋转方式
+ */
+template <int Bpp>
+inline void rotate_plane(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, RotateMode mode)
+{
+    ptrdiff_t ss = srcStride;
+    ptrdiff_t ds = dstStride;
+    if (rotate_swaps_axes(mode))
+    {
+        if (mode == ROTATE_90 || mode == ROTATE_TRANSVERSE)
+        {
+            src += (height - 1) * ss;
+            ss = -ss;
+        }
+        if (mode == ROTATE_270 || mode == ROTATE_TRANSVERSE)
+        {
+            dst += (width - 1) * ds;
+            ds = -ds;
+        }
+        rotate_transpose<Bpp>(src, ss, dst, ds, width, height);
+        return;
+    }
+
+    bool reverseRows = mode == ROTATE_180 || mode == ROTATE_FLIP_V;
+    bool reverseCols = mode == ROTATE_180 || mode == ROTATE_FLIP_H;
+
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            const uint8_t* s = src + y * ss;
+            uint8_t*       d = dst + (reverseRows ? height - 1 - y : y) * ds;
+            if (reverseCols)
+            {
+                rotate_reverse_row<Bpp>(d, s, width);
+            }
+            else
+            {
+                memcpy(d, s, static_cast<size_t>(width) * Bpp);
+            }
+        }
+    };
+    parallel_for_rows(height, rows, 64);
+}
+
+/**
+ * @brief   逐像素的标量实现，用于校验 rotate_plane
+ */
+template <int Bpp>
+inline void rotate_plane_c(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, RotateMode mode)
+{
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            int dx = x, dy = y;
+            switch (mode)
+            {
+            case ROTATE_90: dx = height - 1 - y, dy = x; break;
+            case ROTATE_180: dx = width - 1 - x, dy = height - 1 - y; break;
+            case ROTATE_270: dx = y, dy = width - 1 - x; break;
+            case ROTATE_FLIP_H: dx = width - 1 - x; break;
+            case ROTATE_FLIP_V: dy = height - 1 - y; break;
+            case ROTATE_TRANSPOSE: dx = y, dy = x; break;
+            case ROTATE_TRANSVERSE: dx = height - 1 - y, dy = width - 1 - x; break;
+            default: break;
+            }
+            memcpy(dst + static_cast<ptrdiff_t>(dy) * dstStride + dx * Bpp, src + static_cast<ptrdiff_t>(y) * srcStride + x * Bpp, Bpp);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef __SIMD_H__
+#define __SIMD_H__
+
+/**
+ * @brief   指令集检测
+ * SIMD_SSE2    x86-64 默认具备，MSVC x64 同样可用
+ * SIMD_SSSE3   编译器已全局开启 SSSE3（-mssse3 / -march=native）
+ * SIMD_AVX2    编译器已全局开启 AVX2（-mavx2 / -march=native 或 MSVC /arch:AVX2）
+ * SIMD_NEON    ARMv7 NEON / AArch64
+ * SIMD_X86     x86 平台，可以用 SIMD_TARGET 编译更高指令集的内核并在运行时分派
+ * 每个内核都保留标量实现，宏未定义时自动回退
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SIMD_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+    #define SIMD_SSSE3 1
+    #include <tmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+    #define SIMD_AVX2 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define SIMD_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+/**
+ * @brief   为单个函数开启指定指令集（GCC/Clang），MSVC 无需开启即可使用内建函数
+ */
+#if defined(__GNUC__) && defined(SIMD_X86)
+    #define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define SIMD_TARGET(isa)
+#endif
+
+#if defined(SIMD_X86)
+/**
+ * @brief   运行时检测 CPU 是否支持 SSSE3
+ */
+inline bool simd_cpu_has_ssse3()
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+    #else
+    return __builtin_cpu_supports("ssse3");
+    #endif
+}
+
+/**
+ * @brief   运行时检测 CPU（及操作系统）是否支持 AVX2
+ */
+inline bool simd_cpu_has_avx2()
+{
+    #if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+    #else
+    return __builtin_cpu_supports("avx2");
+    #endif
+}
+#endif
+
+#endif
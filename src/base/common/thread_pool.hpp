@@ -0,0 +1,96 @@
+#ifndef __THREAD_POOL_HPP__
+#define __THREAD_POOL_HPP__
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "parallel.hpp"
+
+/**
+ * @brief   固定大小线程池
+ * 1. 构造时创建线程，析构时执行完队列中剩余任务后退出
+ * 2. Submit 返回 std::future，调用者按提交顺序 get() 即可得到有序结果
+ */
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int threads = parallel_thread_count())
+    {
+        threads = threads > 0 ? threads : 1;
+        for (int i = 0; i < threads; i++)
+        {
+            m_threads.emplace_back(&ThreadPool::Worker, this);
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename Func>
+    auto Submit(Func&& func) -> std::future<std::invoke_result_t<Func>>
+    {
+        using Result = std::invoke_result_t<Func>;
+        auto task    = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        auto future  = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace([task] { (*task)(); });
+        }
+        m_cv.notify_one();
+        return future;
+    }
+
+    int Size() const
+    {
+        return static_cast<int>(m_threads.size());
+    }
+
+private:
+    void Worker()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+
+private:
+    std::vector<std::thread>          m_threads;      // 工作线程
+    std::queue<std::function<void()>> m_tasks;        // 任务队列
+    std::mutex                        m_mutex;        // 互斥锁
+    std::condition_variable           m_cv;           // 条件变量
+    bool                              m_stop = false; // 退出标志
+};
+
+#endif
@@ -0,0 +1,271 @@
+#ifndef __TIMESTRETCH_HPP__
+#define __TIMESTRETCH_HPP__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "aligned_buffer.hpp"
+#include "resample.hpp"
+
+/**
+ * @brief   WSOLA 变速不变调（流式）
+ * 1. 帧长 N 约 20 ms，Hann 窗 50% 重叠相加，合成跳距 Hs = N / 2 固定，分析跳距 Ha = Hs * speed；
+ *    每帧在名义位置 ±Hs/2 内搜索与上一帧自然延续波形最相似的位置，避免相位不连续
+ * 2. 相似度为归一化互相关（声道平均后的单声道），先按步长 2 粗搜再在最佳点两侧细搜，
+ *    点积与重采样共用 resample_dot（SSE2/NEON），候选能量滑动更新
+ * 3. 计算量只与输出长度有关：每输出 Hs 帧做一次搜索，与倍速无关；speed 为 1 时跳过搜索，
+ *    直接取自然延续位置，输出与输入一致（延迟补偿后逐采样相同，只差舍入）
+ * 4. 输入保留到名义位置前 Hs/2 为止，延迟不超过一帧；倍速可以在任意两次调用之间修改
+ * 输入/输出均为交织 float
+ */
+class TimeStretcher
+{
+public:
+    static constexpr double kMinSpeed = 0.5;
+    static constexpr double kMaxSpeed = 4.0;
+
+    /**
+     * @param   sampleRate              [IN]        采样率，决定帧长
+     * @param   channels                [IN]        声道数
+     */
+    TimeStretcher(int sampleRate, int channels)
+        : m_channels(std::max(channels, 1))
+        , m_frame((std::max(sampleRate, 400) / 50 + 7) / 8 * 8)
+        , m_hop(m_frame / 2)
+        , m_radius(m_hop / 2)
+        , m_window(m_frame)
+        , m_overlap(static_cast<size_t>(m_frame) * m_channels)
+    {
+        const double kPi = 3.14159265358979323846;
+        for (int i = 0; i < m_frame; i++)
+        {
+            m_window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / m_frame));
+        }
+        Reset();
+    }
+
+    /**
+     * @brief   清空输入和重叠缓冲，倍速保持不变
+     */
+    void Reset()
+    {
+        // 输入前补 Hs 个零、第一帧从 -Hs 开始，输出丢弃前 Hs 帧，补偿窗的淡入
+        m_input.assign(static_cast<size_t>(m_hop) * m_channels, 0.0f);
+        m_mono.assign(m_hop, 0.0f);
+        memset(m_overlap.Data(), 0, m_overlap.Size() * sizeof(float));
+        m_base       = -m_hop;
+        m_nominal    = -m_hop;
+        m_prev       = INT64_MIN;
+        m_skip       = m_hop;
+        m_out_total  = 0;
+        m_out_target = 0.0;
+    }
+
+    /**
+     * @brief   设置倍速，钳位到 [0.5, 4]
+     */
+    void SetSpeed(double speed)
+    {
+        m_speed = std::clamp(speed, kMinSpeed, kMaxSpeed);
+    }
+
+    double Speed() const
+    {
+        return m_speed;
+    }
+
+    /**
+     * @brief   帧长（帧数），即最大额外延迟
+     */
+    int FrameLength() const
+    {
+        return m_frame;
+    }
+
+    /**
+     * @brief   再输入 frames 帧时最多产生的输出帧数
+     */
+    int MaxOutput(int frames) const
+    {
+        double pending = static_cast<double>(m_base + Count() + frames) - m_nominal;
+        return (static_cast<int>(std::max(pending, 0.0) / (m_hop * m_speed)) + 2) * m_hop;
+    }
+
+    /**
+     * @brief   输入交织数据
+     * @param   in                      [IN]        输入，frames * channels 个采样
+     * @param   frames                  [IN]        输入帧数
+     * @param   out                     [OUT]       输出（交织）
+     * @param   capacity                [IN]        输出最多帧数，按整跳距输出，剩余留到下次调用
+     * @return  输出帧数
+     */
+    int Process(const float* in, int frames, float* out, int capacity)
+    {
+        Append(in, frames);
+        m_out_target += frames / m_speed;
+        return Produce(out, capacity, INT64_MAX);
+    }
+
+    /**
+     * @brief   输入结束，补零输出剩余的采样，总输出约为各段输入帧数 / 倍速之和
+     * @param   out                     [OUT]       输出（交织）
+     * @param   capacity                [IN]        输出最多帧数
+     * @return  输出帧数
+     */
+    int Flush(float* out, int capacity)
+    {
+        int pad = m_frame + m_radius + static_cast<int>(std::ceil(m_hop * m_speed)) + 1;
+        m_input.resize(m_input.size() + static_cast<size_t>(pad) * m_channels, 0.0f);
+        m_mono.resize(m_mono.size() + pad, 0.0f);
+        return Produce(out, capacity, std::llround(m_out_target));
+    }
+
+private:
+    int64_t Count() const
+    {
+        return static_cast<int64_t>(m_mono.size());
+    }
+
+    void Append(const float* in, int frames)
+    {
+        m_input.insert(m_input.end(), in, in + static_cast<size_t>(frames) * m_channels);
+        size_t start = m_mono.size();
+        m_mono.resize(start + frames);
+        float scale = 1.0f / m_channels;
+        for (int i = 0; i < frames; i++)
+        {
+            float sum = 0.0f;
+            for (int c = 0; c < m_channels; c++)
+            {
+                sum += in[i * m_channels + c];
+            }
+            m_mono[start + i] = sum * scale;
+        }
+    }
+
+    /**
+     * 在 [nominal - radius, nominal + radius] 内找与 prev + Hs 起的 Hs 帧最相似的位置
+     */
+    int64_t Search(int64_t nominal)
+    {
+        int64_t natural = m_prev + m_hop;
+        if (m_speed == 1.0)
+        {
+            return natural;
+        }
+        int64_t      low    = std::max(nominal - m_radius, m_base);
+        int64_t      high   = nominal + m_radius;
+        const float* target = m_mono.data() + (natural - m_base);
+        const float* mono   = m_mono.data() - m_base;
+        int          length = m_hop;
+
+        auto score = [&](int64_t c, double energy) {
+            return resample_dot(target, mono + c, length) / std::sqrt(energy + 1e-9);
+        };
+        auto energy = [&](int64_t c) {
+            double sum = 0.0;
+            for (int i = 0; i < length; i++)
+            {
+                sum += static_cast<double>(mono[c + i]) * mono[c + i];
+            }
+            return sum;
+        };
+
+        // 粗搜：能量每步滑动两个采样
+        int64_t best      = low;
+        double  bestScore = -1e30;
+        double  e         = energy(low);
+        for (int64_t c = low; c <= high; c += 2)
+        {
+            double s = score(c, e);
+            if (s > bestScore)
+            {
+                bestScore = s;
+                best      = c;
+            }
+            for (int k = 0; k < 2; k++)
+            {
+                e += static_cast<double>(mono[c + k + length]) * mono[c + k + length] - static_cast<double>(mono[c + k]) * mono[c + k];
+            }
+        }
+        // 细搜：最佳点两侧各一个采样
+        for (int64_t c = std::max(best - 1, low); c <= std::min(best + 1, high); c += 2)
+        {
+            double s = score(c, energy(c));
+            if (s > bestScore)
+            {
+                bestScore = s;
+                best      = c;
+            }
+        }
+        return best;
+    }
+
+    int Produce(float* out, int capacity, int64_t limit)
+    {
+        int n = 0;
+        while (m_out_total < limit && capacity - n >= m_hop)
+        {
+            int64_t nominal = static_cast<int64_t>(std::floor(m_nominal));
+            if (nominal + m_radius + m_frame > m_base + Count())
+            {
+                break;
+            }
+            int64_t pos = m_prev == INT64_MIN ? nominal : Search(nominal);
+
+            // 加窗重叠相加，前 Hs 帧已完整
+            const float* src = m_input.data() + (pos - m_base) * m_channels;
+            float*       acc = m_overlap.Data();
+            for (int i = 0; i < m_frame; i++)
+            {
+                for (int c = 0; c < m_channels; c++)
+                {
+                    acc[i * m_channels + c] += src[i * m_channels + c] * m_window[i];
+                }
+            }
+            int emit = static_cast<int>(std::min<int64_t>(m_hop - m_skip, limit - m_out_total));
+            memcpy(out + static_cast<size_t>(n) * m_channels, acc + static_cast<size_t>(m_skip) * m_channels, static_cast<size_t>(emit) * m_channels * sizeof(float));
+            memmove(acc, acc + static_cast<size_t>(m_hop) * m_channels, static_cast<size_t>(m_frame - m_hop) * m_channels * sizeof(float));
+            memset(acc + static_cast<size_t>(m_frame - m_hop) * m_channels, 0, static_cast<size_t>(m_hop) * m_channels * sizeof(float));
+            n += emit;
+            m_out_total += emit;
+            m_skip = 0;
+
+            m_prev = pos;
+            m_nominal += m_hop * m_speed;
+        }
+
+        // 丢弃之后不再用到的输入
+        int64_t keep = std::min(m_prev == INT64_MIN ? m_base : m_prev + m_hop, static_cast<int64_t>(std::floor(m_nominal)) - m_radius);
+        int64_t drop = std::clamp<int64_t>(keep - m_base, 0, Count());
+        if (drop > 0)
+        {
+            m_input.erase(m_input.begin(), m_input.begin() + drop * m_channels);
+            m_mono.erase(m_mono.begin(), m_mono.begin() + drop);
+            m_base += drop;
+        }
+        return n;
+    }
+
+private:
+    int                  m_channels;    // 声道数
+    int                  m_frame;       // 帧长 N
+    int                  m_hop;         // 合成跳距 Hs = N / 2
+    int                  m_radius;      // 搜索半径
+    double               m_speed = 1.0; // 倍速
+    AlignedBuffer<float> m_window;      // Hann 窗
+    AlignedBuffer<float> m_overlap;     // 重叠相加缓冲（交织，N 帧）
+    std::vector<float>   m_input;       // 输入（交织）
+    std::vector<float>   m_mono;        // 输入的单声道混合，用于搜索
+    int64_t              m_base;        // m_input 第一帧在输入流中的位置
+    double               m_nominal;     // 下一帧的名义输入位置
+    int64_t              m_prev;        // 上一帧实际使用的输入位置
+    int                  m_skip;        // 待丢弃的输出帧数（延迟补偿）
+    int64_t              m_out_total;   // 累计输出帧数
+    double               m_out_target;  // 按倍速折算的应输出帧数
+};
+
+#endif
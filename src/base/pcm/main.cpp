@@ -1,6 +1,16 @@
 #include <string>
 
 #include "pcm.h"
+#include "pcm_block.h"
+#include "pcm_detect.h"
+#include "pcm_edit.h"
+#include "pcm_format.h"
+#include "pcm_loudness.h"
+#include "pcm_mixer.h"
+#include "pcm_resample.h"
+#include "pcm_spectrum.h"
+#include "pcm_timestretch.h"
+#include "pcm_wav.h"
 
 int main(int argc, char* argv[])
 {
@@ -23,8 +33,70 @@ int main(int argc, char* argv[])
     // 从PCM16LE单声道音频采样数据中截取一部分数据
     simplest_pcm16le_cut_singlechannel(pcm_drum, 2360, 120);
 
+    // 从PCM16LE双声道音频采样数据中截取三段拼接，段之间交叉淡化 50 毫秒
+    simplest_pcm16le_concat({{pcm_16le, 0, 44100 * 3, 0}, {pcm_16le, 44100 * 10, 44100 * 3, 2205}, {pcm_16le, 44100 * 20, 44100 * 3, 2205}}, 2, pcm_16le + ".concat");
+
     // 将PCM16LE双声道音频采样数据转换为WAVE格式音频数据
     simplest_pcm16le_to_wave(pcm_16le, 2, 44100);
 
+    // 解析WAVE文件，导出data块为PCM数据
+    simplest_wave_to_pcm(pcm_16le + ".wav");
+
+    // 转换为32位浮点，再加抖动转回16位
+    simplest_pcm_convert(pcm_16le, SAMPLE_FORMAT_S16, SAMPLE_FORMAT_F32, 2, false);
+    simplest_pcm_convert(pcm_16le + ".f32le", SAMPLE_FORMAT_F32, SAMPLE_FORMAT_S16, 2, true);
+
+    // 将PCM16LE双声道音频采样数据从44.1kHz重采样到48kHz
+    simplest_pcm16le_resample(pcm_16le, 2, 44100, 48000);
+
+    // 将PCM16LE双声道音频采样数据变速不变调（1.5倍速）
+    simplest_pcm16le_timestretch(pcm_16le, 2, 44100, 1.5);
+
+    // 测量PCM16LE双声道音频采样数据的响度（EBU R128）
+    simplest_pcm16le_loudness(pcm_16le, 2, 44100);
+
+    // 分析PCM16LE双声道音频采样数据的频谱（频带能量、主频、静音帧）
+    simplest_pcm16le_spectrum(pcm_16le, 2, 44100);
+
+    // 检测PCM16LE双声道音频与WAV文件中的静音和削顶区间
+    simplest_pcm16le_detect(pcm_16le, 2, 44100);
+    simplest_pcm16le_detect(pcm_16le + ".wav", 2, 44100);
+
+    // 双声道音乐与单声道鼓点混音，鼓点声像偏右
+    ChannelMatrix matrix(2, 3);
+    ChannelMatrix pan = ChannelMatrix::Pan(0.5f, 0.3f);
+    matrix.At(0, 0)   = 0.7f;
+    matrix.At(1, 1)   = 0.7f;
+    matrix.At(0, 2)   = pan.At(0, 0);
+    matrix.At(1, 2)   = pan.At(1, 0);
+    simplest_pcm16le_mix({pcm_16le, pcm_drum}, {2, 1}, matrix, pcm_16le + ".mix");
+
+    // 截取与拼接测试
+    pcm_edit_benchmark(pcm_16le);
+
+    // 块处理内核与整文件处理的吞吐测试
+    pcm_block_benchmark(pcm_16le);
+
+    // 采样格式转换吞吐测试
+    sample_format_benchmark();
+
+    // 重采样测试
+    resample_benchmark();
+
+    // 变速不变调测试
+    timestretch_benchmark();
+
+    // 混音测试
+    mixer_benchmark();
+
+    // 响度测试
+    loudness_benchmark();
+
+    // 频谱分析测试
+    spectrum_benchmark();
+
+    // 静音与削顶检测测试
+    detect_benchmark();
+
     return 0;
 }
\ No newline at end of file
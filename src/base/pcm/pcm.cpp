@@ -1,35 +1,41 @@
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 
 #include <spdlog/spdlog.h>
 
+#include "base/common/aligned_buffer.hpp"
 #include "pcm.h"
+#include "pcm_block.h"
+#include "pcm_edit.h"
+#include "pcm_format.h"
+#include "pcm_resample.h"
+#include "pcm_wav.h"
 
 int simplest_pcm16le_split(const std::string& pcm_16le)
 {
     SPDLOG_INFO("Splitting PCM16LE file: {}", pcm_16le);
-    std::ifstream pcm16le(pcm_16le, std::ios::in | std::ios::binary);
     std::ofstream left(pcm_16le + ".left", std::ios::out | std::ios::binary);
     std::ofstream right(pcm_16le + ".right", std::ios::out | std::ios::binary);
-    if (!pcm16le.is_open())
-    {
-        SPDLOG_ERROR("Failed to open file: {}", pcm_16le);
-        return -1;
-    }
 
-    int  count      = 0;
-    int  sampleSize = 4;
-    char sample[4]  = {0};
-    while (pcm16le.read(sample, sampleSize))
+    PcmBlockEngine         engine(2);
+    AlignedBuffer<int16_t> l(engine.BlockFrames());
+    AlignedBuffer<int16_t> r(engine.BlockFrames());
+
+    int64_t count = engine.Run(pcm_16le, [&](const uint8_t* data, int frames) {
+        pcm_s16_split(reinterpret_cast<const int16_t*>(data), l.Data(), r.Data(), frames);
+        left.write(reinterpret_cast<const char*>(l.Data()), frames * sizeof(int16_t));
+        right.write(reinterpret_cast<const char*>(r.Data()), frames * sizeof(int16_t));
+        return true;
+    });
+    if (count < 0)
     {
-        left.write(sample, sampleSize / 2);
-        right.write(sample + sampleSize / 2, sampleSize / 2);
-        count++;
+        return -1;
     }
     SPDLOG_INFO("Sample count: {}", count);
 
-    pcm16le.close();
     left.close();
     right.close();
 
@@ -39,106 +45,75 @@ int simplest_pcm16le_split(const std::string& pcm_16le)
 int simplest_pcm16le_halfvolumeleft(const std::string& pcm_16le)
 {
     SPDLOG_INFO("Half volume left channel: {}", pcm_16le);
-    std::ifstream pcm16le(pcm_16le, std::ios::in | std::ios::binary);
     std::ofstream halfLeft(pcm_16le + ".halfLeft", std::ios::out | std::ios::binary);
-    if (!pcm16le.is_open())
-    {
-        SPDLOG_ERROR("Failed to open file: {}", pcm_16le);
-        return -1;
-    }
 
-    int  count      = 0;
-    int  sampleSize = 4;
-    char sample[4]  = {0};
-    while (pcm16le.read(sample, sampleSize))
+    PcmBlockEngine         engine(2);
+    AlignedBuffer<int16_t> block(engine.BlockFrames() * 2);
+    const float            gains[2] = {0.5f, 1.0f};
+
+    // 块缓冲区只读，拷贝到输出缓冲区后原地乘增益
+    int64_t count = engine.Run(pcm_16le, [&](const uint8_t* data, int frames) {
+        memcpy(block.Data(), data, frames * engine.FrameBytes());
+        pcm_s16_gain(block.Data(), frames, 2, gains);
+        halfLeft.write(reinterpret_cast<const char*>(block.Data()), frames * engine.FrameBytes());
+        return true;
+    });
+    if (count < 0)
     {
-        *(uint16_t*)sample = *(uint16_t*)sample / 2;
-        halfLeft.write(sample, sampleSize / 2);
-        halfLeft.write(sample + sampleSize / 2, sampleSize / 2);
-        count++;
+        return -1;
     }
     SPDLOG_INFO("Sample count: {}", count);
 
+    halfLeft.close();
+
     return 0;
 }
 
 int simplest_pcm16le_doublespeed(const std::string& pcm_16le)
 {
     SPDLOG_INFO("Double speed: {}", pcm_16le);
-    std::fstream pcm16le(pcm_16le, std::ios::in | std::ios::out | std::ios::binary);
-    std::fstream doubleSpeed(pcm_16le + ".doubleSpeed", std::ios::in | std::ios::out | std::ios::binary);
-    if (!pcm16le.is_open())
-    {
-        SPDLOG_ERROR("Failed to open file: {}", pcm_16le);
-        return -1;
-    }
-
-    int  count      = 0;
-    int  sampleSize = 4;
-    char sample[4]  = {0};
-    while (pcm16le.read(sample, sampleSize))
-    {
-        if (count % 2 == 0)
-        {
-            doubleSpeed.write(sample, sampleSize);
-        }
-        count++;
-    }
-    SPDLOG_INFO("Sample count: {}", count);
 
-    return 0;
+    // 2:1 带限重采样，按原采样率播放即为两倍速，抗混叠滤波避免直接抽取带来的混叠
+    return pcm_s16_resample_file(pcm_16le, pcm_16le + ".doubleSpeed", 2, 2, 1);
 }
 
 int simplest_pcm16le_to_pcm8(const std::string& pcm_16le)
 {
     SPDLOG_INFO("Convert PCM16LE to PCM8: {}", pcm_16le);
-    std::ifstream pcm16le(pcm_16le, std::ios::in | std::ios::binary);
     std::ofstream pcm8(pcm_16le + ".pcm8", std::ios::out | std::ios::binary);
-    if (!pcm16le.is_open())
-    {
-        SPDLOG_ERROR("Failed to open file: {}", pcm_16le);
-        return -1;
-    }
 
-    int  count      = 0;
-    int  sampleSize = 4;
-    char sample[4]  = {0};
-    while (pcm16le.read(sample, sampleSize))
+    // 8 位量化噪声明显，降位深时加 TPDF 抖动
+    PcmBlockEngine         engine(2);
+    SampleConverter        converter(SAMPLE_FORMAT_S16, SAMPLE_FORMAT_U8, 2, true);
+    AlignedBuffer<uint8_t> block(engine.BlockFrames() * 2);
+
+    int64_t count = engine.Run(pcm_16le, [&](const uint8_t* data, int frames) {
+        converter.Convert(data, block.Data(), frames);
+        pcm8.write(reinterpret_cast<const char*>(block.Data()), frames * 2);
+        return true;
+    });
+    if (count < 0)
     {
-        *(uint16_t*)sample       = *(uint16_t*)sample / (2 << 8);
-        *(uint16_t*)(sample + 2) = *(uint16_t*)(sample + 2) / (2 << 8);
-        pcm8.write(sample, sampleSize / 2);
-        pcm8.write(sample + sampleSize / 2, sampleSize / 2);
-        count++;
+        return -1;
     }
     SPDLOG_INFO("Sample count: {}", count);
 
+    pcm8.close();
+
     return 0;
 }
 
 int simplest_pcm16le_cut_singlechannel(const std::string& pcm_drum, int start_num, int dur_num)
 {
     SPDLOG_INFO("Cut single channel: {}", pcm_drum);
-    std::ifstream pcm16le(pcm_drum, std::ios::in | std::ios::binary);
-    std::ofstream cut(pcm_drum + ".cut", std::ios::out | std::ios::binary);
-    if (!pcm16le.is_open())
-    {
-        SPDLOG_ERROR("Failed to open file: {}", pcm_drum);
-        return -1;
-    }
 
-    int  count      = 0;
-    int  sampleSize = 2;
-    char sample[2]  = {0};
-    while (pcm16le.read(sample, sampleSize))
+    // 帧序号直接换算为偏移，只拷贝 [start_num, start_num + dur_num)，不读取区间之外的数据
+    PcmEditor editor(SAMPLE_FORMAT_S16, 1);
+    if (editor.Cut(pcm_drum, pcm_drum + ".cut", start_num, dur_num) != 0)
     {
-        if (count >= start_num && count < start_num + dur_num)
-        {
-            cut.write(sample, sampleSize);
-        }
-        count++;
+        return -1;
     }
-    SPDLOG_INFO("Sample count: {}", count);
+    SPDLOG_INFO("Sample count: {}", editor.Frames(pcm_drum + ".cut"));
 
     return 0;
 }
@@ -146,44 +121,25 @@ int simplest_pcm16le_cut_singlechannel(const std::string& pcm_drum, int start_nu
 int simplest_pcm16le_to_wave(const std::string& pcm_16le, int channels, int sample_rate)
 {
     SPDLOG_INFO("Convert PCM16LE to WAVE: {}", pcm_16le);
-    std::ifstream pcm16le(pcm_16le, std::ios::in | std::ios::binary);
-    std::ofstream wave(pcm_16le + ".wav", std::ios::out | std::ios::binary);
-    if (!pcm16le.is_open())
+
+    // 按输入长度预分配，超过 4 GB 时 WavWriter 自动写 RF64
+    std::error_code ec;
+    int64_t         bytes = static_cast<int64_t>(std::filesystem::file_size(pcm_16le, ec));
+    PcmBlockEngine  engine(channels);
+    WavWriter       wave;
+    if (wave.Open(pcm_16le + ".wav", SAMPLE_FORMAT_S16, channels, sample_rate, ec ? 0 : bytes / engine.FrameBytes()) != 0)
     {
-        SPDLOG_ERROR("Failed to open file: {}", pcm_16le);
         return -1;
     }
 
-    // wave header
-    WavHeader waveHeader;
-    memcpy(waveHeader.riff, "RIFF", 4);
-    waveHeader.file_size = 0;
-    memcpy(waveHeader.wave, "WAVE", 4);
-    memcpy(waveHeader.fmt, "fmt ", 4);
-    waveHeader.fmt_size        = 16;
-    waveHeader.audio_format    = 1;
-    waveHeader.num_channels    = channels;
-    waveHeader.sample_rate     = sample_rate;
-    waveHeader.bits_per_sample = 16;
-    waveHeader.byte_rate       = sample_rate * channels * (waveHeader.bits_per_sample / 8);
-    waveHeader.block_align     = channels * (waveHeader.bits_per_sample / 8);
-    memcpy(waveHeader.data, "data", 4);
-    waveHeader.data_size = 0;
-
-    wave.seekp(sizeof(WavHeader));
-    int  sampleSize = 4;
-    char sample[4]  = {0};
-    while (pcm16le.read(sample, sampleSize))
+    int64_t count = engine.Run(pcm_16le, [&](const uint8_t* data, int frames) {
+        return wave.Write(data, frames) == 0;
+    });
+    if (count < 0)
     {
-        wave.write(sample, sampleSize);
-        waveHeader.data_size += sampleSize;
+        return -1;
     }
-    waveHeader.file_size = waveHeader.data_size + sizeof(WavHeader) - 8;
-    wave.seekp(0);
-    wave.write((char*)&waveHeader, sizeof(WavHeader));
-
-    pcm16le.close();
-    wave.close();
+    SPDLOG_INFO("Sample count: {}", count);
 
-    return 0;
-}
\ No newline at end of file
+    return wave.Close();
+}
@@ -1,6 +1,7 @@
 #ifndef __PCM_H__
 #define __PCM_H__
 
+#include <cstdint>
 #include <string>
 
 #pragma pack(1)
@@ -50,7 +51,7 @@ int simplest_pcm16le_halfvolumeleft(const std::string& pcm_16le);
 int simplest_pcm16le_doublespeed(const std::string& pcm_16le);
 
 /**
- * @brief   将PCM16LE双声道音频采样数据转换为PCM8音频采样数据
+ * @brief   将PCM16LE双声道音频采样数据转换为PCM8音频采样数据（无符号 8 位，加 TPDF 抖动）
  * @param   pcm_16le                [IN]        pcm16le 输入文件路径
  * @return  0                                   成功
  *          其他                                失败
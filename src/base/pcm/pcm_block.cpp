@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/benchmark.hpp"
+#include "base/common/simd.h"
+#include "pcm_block.h"
+
+namespace
+{
+    constexpr int kGainShift    = 12; // 增益 Q12 定点
+    constexpr int kGainChannels = 8;  // SIMD 增益支持的最大声道数
+
+    int16_t saturate16(int value)
+    {
+        return static_cast<int16_t>(std::clamp(value, -32768, 32767));
+    }
+
+    int gain_q12(float gain)
+    {
+        return std::clamp(static_cast<int>(std::lround(gain * (1 << kGainShift))), -32768, 32767);
+    }
+
+    void split_c(const int16_t* src, int16_t* left, int16_t* right, int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            left[i]  = src[2 * i];
+            right[i] = src[2 * i + 1];
+        }
+    }
+
+    void gain_c(int16_t* samples, int begin, int end, const int* gains, int channels)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            samples[i] = saturate16((samples[i] * gains[i % channels] + (1 << (kGainShift - 1))) >> kGainShift);
+        }
+    }
+} // namespace
+
+PcmBlockEngine::PcmBlockEngine(int channels, int sampleBytes, size_t blockBytes)
+    : m_frame_bytes(std::max(channels * sampleBytes, 1))
+    , m_block_frames(static_cast<int>(std::max<size_t>(blockBytes / m_frame_bytes, 1)))
+    , m_block(static_cast<size_t>(m_block_frames) * m_frame_bytes)
+{
+}
+
+int64_t PcmBlockEngine::Run(const std::string& filename, const BlockFunc& func)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    // 每次请求整数帧，只有文件末尾可能读到不完整的帧
+    int64_t total = 0;
+    while (file)
+    {
+        file.read(reinterpret_cast<char*>(m_block.Data()), m_block.Size());
+        int frames = static_cast<int>(file.gcount() / m_frame_bytes);
+        if (frames == 0)
+        {
+            break;
+        }
+        total += frames;
+        if (!func(m_block.Data(), frames))
+        {
+            break;
+        }
+    }
+
+    return total;
+}
+
+void pcm_s16_split(const int16_t* src, int16_t* left, int16_t* right, int frames)
+{
+    int i = 0;
+#if SIMD_SSE2
+    // 每个 32 位是一帧：左声道在低 16 位，右声道在高 16 位，符号扩展后用有符号饱和打包（不会饱和）
+    for (; i + 8 <= frames; i += 8)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i + 8));
+        __m128i l = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+        __m128i r = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i), l);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i), r);
+    }
+#elif SIMD_NEON
+    for (; i + 8 <= frames; i += 8)
+    {
+        int16x8x2_t v = vld2q_s16(src + 2 * i);
+        vst1q_s16(left + i, v.val[0]);
+        vst1q_s16(right + i, v.val[1]);
+    }
+#endif
+    split_c(src, left, right, i, frames);
+}
+
+void pcm_s16_gain(int16_t* samples, int frames, int channels, const float* gains)
+{
+    if (channels < 1 || frames <= 0)
+    {
+        return;
+    }
+    if (channels > kGainChannels)
+    {
+        // 增益模式放不进 8 个向量，走标量
+        std::vector<int> q(channels);
+        for (int c = 0; c < channels; c++)
+        {
+            q[c] = gain_q12(gains[c]);
+        }
+        gain_c(samples, 0, frames * channels, q.data(), channels);
+        return;
+    }
+
+    int q[kGainChannels];
+    for (int c = 0; c < channels; c++)
+    {
+        q[c] = gain_q12(gains[c]);
+    }
+
+    int i     = 0;
+    int count = frames * channels;
+#if SIMD_SSE2 || SIMD_NEON
+    // channels 个向量正好是 8 帧，增益模式按向量序号轮换
+    int16_t pattern[kGainChannels][8];
+    for (int k = 0; k < channels; k++)
+    {
+        for (int j = 0; j < 8; j++)
+        {
+            pattern[k][j] = static_cast<int16_t>(q[(k * 8 + j) % channels]);
+        }
+    }
+#endif
+#if SIMD_SSE2
+    const __m128i round = _mm_set1_epi32(1 << (kGainShift - 1));
+    for (; i + 8 * channels <= count; i += 8 * channels)
+    {
+        for (int k = 0; k < channels; k++)
+        {
+            __m128i* p  = reinterpret_cast<__m128i*>(samples + i + 8 * k);
+            __m128i  v  = _mm_loadu_si128(p);
+            __m128i  g  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern[k]));
+            __m128i  lo = _mm_mullo_epi16(v, g);
+            __m128i  hi = _mm_mulhi_epi16(v, g);
+            __m128i  p0 = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), round), kGainShift);
+            __m128i  p1 = _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(lo, hi), round), kGainShift);
+            _mm_storeu_si128(p, _mm_packs_epi32(p0, p1));
+        }
+    }
+#elif SIMD_NEON
+    for (; i + 8 * channels <= count; i += 8 * channels)
+    {
+        for (int k = 0; k < channels; k++)
+        {
+            int16_t*  p = samples + i + 8 * k;
+            int16x8_t v = vld1q_s16(p);
+            int16x8_t g = vld1q_s16(pattern[k]);
+            int16x4_t a = vqrshrn_n_s32(vmull_s16(vget_low_s16(v), vget_low_s16(g)), kGainShift);
+            int16x4_t b = vqrshrn_n_s32(vmull_s16(vget_high_s16(v), vget_high_s16(g)), kGainShift);
+            vst1q_s16(p, vcombine_s16(a, b));
+        }
+    }
+#endif
+    gain_c(samples, i, count, q, channels);
+}
+
+int pcm_block_benchmark(const std::string& pcm_16le)
+{
+    constexpr int kFrames     = 4 << 20; // 4M 帧双声道，16 MiB
+    constexpr int kIterations = 20;
+    int           ret         = 0;
+
+    AlignedBuffer<int16_t> src(kFrames * 2), work(kFrames * 2), reference(kFrames * 2);
+    AlignedBuffer<int16_t> left(kFrames), right(kFrames);
+    for (int i = 0; i < kFrames * 2; i++)
+    {
+        src[i] = static_cast<int16_t>(i * 2654435761u >> 16);
+    }
+    size_t bytes = static_cast<size_t>(kFrames) * 4;
+
+    // 拆分声道
+    double scalar = benchmark_throughput([&] { split_c(src.Data(), reference.Data(), reference.Data() + kFrames, 0, kFrames); }, bytes, kIterations);
+    double simd   = benchmark_throughput([&] { pcm_s16_split(src.Data(), left.Data(), right.Data(), kFrames); }, bytes, kIterations);
+    if (memcmp(left.Data(), reference.Data(), bytes / 2) != 0 || memcmp(right.Data(), reference.Data() + kFrames, bytes / 2) != 0)
+    {
+        SPDLOG_ERROR("PCM split: SIMD result mismatch");
+        ret = -1;
+    }
+    SPDLOG_INFO("PCM split: {:.2f} -> {:.2f} GB/s", scalar, simd);
+
+    // 增益（5.1 声道模式覆盖非 2 的幂声道数），各重复一次后对比
+    const float gains[6] = {0.5f, 1.0f, 1.5f, -0.75f, 3.0f, 0.0f};
+    const int   q[6]     = {gain_q12(gains[0]), gain_q12(gains[1]), gain_q12(gains[2]), gain_q12(gains[3]), gain_q12(gains[4]), gain_q12(gains[5])};
+    int         count    = kFrames * 2 / 6 * 6;
+    memcpy(work.Data(), src.Data(), bytes);
+    memcpy(reference.Data(), src.Data(), bytes);
+    pcm_s16_gain(work.Data(), count / 6, 6, gains);
+    gain_c(reference.Data(), 0, count, q, 6);
+    if (memcmp(work.Data(), reference.Data(), count * sizeof(int16_t)) != 0)
+    {
+        SPDLOG_ERROR("PCM gain: SIMD result mismatch");
+        ret = -1;
+    }
+    scalar = benchmark_throughput([&] { gain_c(reference.Data(), 0, count, q, 6); }, bytes, kIterations);
+    simd   = benchmark_throughput([&] { pcm_s16_gain(work.Data(), count / 6, 6, gains); }, bytes, kIterations);
+    SPDLOG_INFO("PCM gain 5.1: {:.2f} -> {:.2f} GB/s", scalar, simd);
+
+    // 整文件拆分声道：逐帧 read/write 对比按块处理
+    std::ifstream probe(pcm_16le, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!probe.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", pcm_16le);
+        return -1;
+    }
+    size_t fileBytes = static_cast<size_t>(probe.tellg());
+    probe.close();
+
+    std::string    leftName  = pcm_16le + ".bench.left";
+    std::string    rightName = pcm_16le + ".bench.right";
+    PcmBlockEngine engine(2);
+
+    auto perFrame = [&] {
+        std::ifstream iFile(pcm_16le, std::ios::in | std::ios::binary);
+        std::ofstream lFile(leftName, std::ios::out | std::ios::binary);
+        std::ofstream rFile(rightName, std::ios::out | std::ios::binary);
+        char          sample[4];
+        while (iFile.read(sample, 4))
+        {
+            lFile.write(sample, 2);
+            rFile.write(sample + 2, 2);
+        }
+    };
+    auto blocked = [&] {
+        std::ofstream lFile(leftName, std::ios::out | std::ios::binary);
+        std::ofstream rFile(rightName, std::ios::out | std::ios::binary);
+        engine.Run(pcm_16le, [&](const uint8_t* data, int frames) {
+            pcm_s16_split(reinterpret_cast<const int16_t*>(data), left.Data(), right.Data(), frames);
+            lFile.write(reinterpret_cast<const char*>(left.Data()), frames * 2);
+            rFile.write(reinterpret_cast<const char*>(right.Data()), frames * 2);
+            return true;
+        });
+    };
+    scalar = benchmark_throughput(perFrame, fileBytes, 3);
+    simd   = benchmark_throughput(blocked, fileBytes, 3);
+    SPDLOG_INFO("PCM split file {:.1f} MB: per-frame {:.3f} GB/s, block {:.3f} GB/s", fileBytes / 1e6, scalar, simd);
+    std::remove(leftName.c_str());
+    std::remove(rightName.c_str());
+
+    return ret;
+}
@@ -0,0 +1,92 @@
+#ifndef __PCM_BLOCK_H__
+#define __PCM_BLOCK_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "base/common/aligned_buffer.hpp"
+
+/**
+ * @brief   按块读取 PCM 文件并逐块回调
+ * 1. 每次 read 一整块（默认 64 KiB，按帧对齐），块缓冲区 64 字节对齐、在多次 Run 之间复用
+ * 2. 回调拿到的是整帧数据，文件末尾不完整的帧丢弃（与逐帧 read 的旧实现一致）
+ * 3. 回调返回 false 时提前结束，不再读取文件剩余部分
+ */
+class PcmBlockEngine
+{
+public:
+    static constexpr size_t kDefaultBlockBytes = 64 * 1024;
+
+    /**
+     * @brief   块回调
+     * @param   data                    [IN]        块数据（交织），64 字节对齐
+     * @param   frames                  [IN]        块内帧数
+     * @return  true 继续，false 结束
+     */
+    typedef std::function<bool(const uint8_t* data, int frames)> BlockFunc;
+
+    /**
+     * @param   channels                [IN]        声道数
+     * @param   sampleBytes             [IN]        每个采样的字节数
+     * @param   blockBytes              [IN]        块大小（字节），向下取整到整帧
+     */
+    PcmBlockEngine(int channels, int sampleBytes = 2, size_t blockBytes = kDefaultBlockBytes);
+    ~PcmBlockEngine() = default;
+
+    /**
+     * @brief   逐块处理文件
+     * @param   filename                [IN]        PCM 文件路径
+     * @param   func                    [IN]        块回调
+     * @return  处理的帧数，文件打开失败时返回 -1
+     */
+    int64_t Run(const std::string& filename, const BlockFunc& func);
+
+    int FrameBytes() const
+    {
+        return m_frame_bytes;
+    }
+
+    /**
+     * @brief   每块最多的帧数，调用方按它分配输出缓冲区
+     */
+    int BlockFrames() const
+    {
+        return m_block_frames;
+    }
+
+private:
+    int                    m_frame_bytes;  // 每帧字节数
+    int                    m_block_frames; // 每块帧数
+    AlignedBuffer<uint8_t> m_block;        // 块缓冲区
+};
+
+/**
+ * @brief   双声道 s16 解交织为左、右声道
+ * @param   src                     [IN]        交织数据，frames * 2 个采样
+ * @param   left                    [OUT]       左声道，frames 个采样
+ * @param   right                   [OUT]       右声道，frames 个采样
+ * @param   frames                  [IN]        帧数
+ */
+void pcm_s16_split(const int16_t* src, int16_t* left, int16_t* right, int frames);
+
+/**
+ * @brief   交织 s16 数据按声道乘增益（原地），结果饱和到 [-32768, 32767]
+ * 增益量化为 Q12 定点（范围 [-8, 8)），SIMD 每次处理 8 帧，按声道数展开增益模式
+ * @param   samples                 [IN/OUT]    交织数据
+ * @param   frames                  [IN]        帧数
+ * @param   channels                [IN]        声道数，1 ~ 8 走 SIMD，更多声道走标量
+ * @param   gains                   [IN]        每个声道的增益，channels 个
+ */
+void pcm_s16_gain(int16_t* samples, int frames, int channels, const float* gains);
+
+/**
+ * @brief   块处理吞吐测试：各内核对比标量实现，以及整文件拆分声道对比逐帧读写
+ * @param   pcm_16le                [IN]        pcm16le 双声道文件路径
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致或文件打开失败
+ */
+int pcm_block_benchmark(const std::string& pcm_16le);
+
+#endif
@@ -0,0 +1,497 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "pcm_detect.h"
+#include "pcm_wav.h"
+
+namespace
+{
+    constexpr int kReadBlocks = 256; // 每次从文件读取的块数
+
+    /**
+     * 交织 16 位采样的平方和与最大、最小值
+     */
+    void block_stats(const int16_t* in, int count, float& energy, int& low, int& high)
+    {
+        int   i   = 0;
+        float sum = 0.0f;
+        int   mx  = -32768;
+        int   mn  = 32767;
+#if SIMD_SSE2
+        __m128  sum0 = _mm_setzero_ps(), sum1 = _mm_setzero_ps();
+        __m128i vmax = _mm_set1_epi16(-32768), vmin = _mm_set1_epi16(32767);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            vmax       = _mm_max_epi16(vmax, v);
+            vmin       = _mm_min_epi16(vmin, v);
+            __m128 lo  = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+            __m128 hi  = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+            sum0       = _mm_add_ps(sum0, _mm_mul_ps(lo, lo));
+            sum1       = _mm_add_ps(sum1, _mm_mul_ps(hi, hi));
+        }
+        alignas(16) float   sums[4];
+        alignas(16) int16_t maxs[8], mins[8];
+        _mm_store_ps(sums, _mm_add_ps(sum0, sum1));
+        _mm_store_si128(reinterpret_cast<__m128i*>(maxs), vmax);
+        _mm_store_si128(reinterpret_cast<__m128i*>(mins), vmin);
+        sum = sums[0] + sums[1] + sums[2] + sums[3];
+        for (int k = 0; k < 8; k++)
+        {
+            mx = std::max<int>(mx, maxs[k]);
+            mn = std::min<int>(mn, mins[k]);
+        }
+#elif SIMD_NEON
+        float32x4_t sum0 = vdupq_n_f32(0.0f), sum1 = vdupq_n_f32(0.0f);
+        int16x8_t   vmax = vdupq_n_s16(-32768), vmin = vdupq_n_s16(32767);
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t   v  = vld1q_s16(in + i);
+            vmax           = vmaxq_s16(vmax, v);
+            vmin           = vminq_s16(vmin, v);
+            float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+            float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+            sum0           = vmlaq_f32(sum0, lo, lo);
+            sum1           = vmlaq_f32(sum1, hi, hi);
+        }
+        sum = vaddvq_f32(vaddq_f32(sum0, sum1));
+        mx  = vmaxvq_s16(vmax);
+        mn  = vminvq_s16(vmin);
+#endif
+        for (; i < count; i++)
+        {
+            float x = in[i];
+            sum += x * x;
+            mx = std::max<int>(mx, in[i]);
+            mn = std::min<int>(mn, in[i]);
+        }
+        energy = sum;
+        low    = mn;
+        high   = mx;
+    }
+} // namespace
+
+/**
+ * 顺序扫描一个分块 [start, end)，长度不足但与分块边界相接的区间也输出
+ */
+class PcmDetector::Scanner
+{
+public:
+    Scanner(const PcmDetector& detector, int64_t start, int64_t end, std::vector<Run>& runs)
+        : m_detector(detector)
+        , m_start(start)
+        , m_end(end)
+        , m_position(start)
+        , m_silence_start(-1)
+        , m_clip_start(detector.m_channels, -1)
+        , m_runs(runs)
+    {
+    }
+
+    /**
+     * frames 除最后一次外须为块长的整数倍
+     */
+    void Feed(const int16_t* data, int64_t frames)
+    {
+        int channels = m_detector.m_channels;
+        int clip     = m_detector.m_options.clip_level;
+        for (int64_t i = 0; i < frames; i += m_detector.m_block_frames)
+        {
+            int            n     = static_cast<int>(std::min<int64_t>(m_detector.m_block_frames, frames - i));
+            const int16_t* block = data + i * channels;
+            float          energy;
+            int            low, high;
+            block_stats(block, n * channels, energy, low, high);
+
+            bool silent = energy < m_detector.m_silence_sum * n * channels;
+            if (silent && m_silence_start < 0)
+            {
+                m_silence_start = m_position;
+            }
+            else if (!silent && m_silence_start >= 0)
+            {
+                Close(PCM_REGION_SILENCE, 0, m_silence_start, m_position);
+                m_silence_start = -1;
+            }
+
+            if (high >= clip || low <= -clip)
+            {
+                for (int f = 0; f < n; f++)
+                {
+                    for (int c = 0; c < channels; c++)
+                    {
+                        int x = block[f * channels + c];
+                        if (x >= clip || x <= -clip)
+                        {
+                            if (m_clip_start[c] < 0)
+                            {
+                                m_clip_start[c] = m_position + f;
+                            }
+                        }
+                        else if (m_clip_start[c] >= 0)
+                        {
+                            Close(PCM_REGION_CLIPPING, c, m_clip_start[c], m_position + f);
+                            m_clip_start[c] = -1;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                CloseClips(m_position);
+            }
+            m_position += n;
+        }
+    }
+
+    void Finish()
+    {
+        if (m_silence_start >= 0)
+        {
+            Close(PCM_REGION_SILENCE, 0, m_silence_start, m_end);
+            m_silence_start = -1;
+        }
+        CloseClips(m_end);
+    }
+
+private:
+    void CloseClips(int64_t end)
+    {
+        for (int c = 0; c < m_detector.m_channels; c++)
+        {
+            if (m_clip_start[c] >= 0)
+            {
+                Close(PCM_REGION_CLIPPING, c, m_clip_start[c], end);
+                m_clip_start[c] = -1;
+            }
+        }
+    }
+
+    void Close(PcmRegionType type, int channel, int64_t start, int64_t end)
+    {
+        int64_t minimum = type == PCM_REGION_SILENCE ? m_detector.m_min_silence : m_detector.m_options.min_clip_run;
+        if (end - start >= minimum || start == m_start || end == m_end)
+        {
+            m_runs.push_back({{type, start, end}, channel});
+        }
+    }
+
+private:
+    const PcmDetector&   m_detector;      // 检测参数
+    int64_t              m_start;         // 分块起始帧
+    int64_t              m_end;           // 分块结束帧
+    int64_t              m_position;      // 当前帧
+    int64_t              m_silence_start; // 当前静音区间起点，-1 为无
+    std::vector<int64_t> m_clip_start;    // 各声道当前满幅区间起点，-1 为无
+    std::vector<Run>&    m_runs;          // 输出
+};
+
+PcmDetector::PcmDetector(int channels, int sampleRate, const PcmDetectOptions& options)
+    : m_channels(std::max(channels, 1))
+    , m_sample_rate(std::max(sampleRate, 1))
+    , m_options(options)
+{
+    m_block_frames = std::max(1, static_cast<int>(std::lround(m_options.block * m_sample_rate)));
+    m_chunk_frames = std::max<int64_t>(1, std::llround(m_options.chunk * m_sample_rate / m_block_frames)) * m_block_frames;
+    m_min_silence  = std::llround(m_options.min_silence * m_sample_rate);
+    m_silence_sum  = static_cast<float>(std::pow(std::pow(10.0, m_options.silence_db / 20.0) * 32768.0, 2.0));
+    m_options.clip_level   = std::clamp(m_options.clip_level, 1, 32767);
+    m_options.min_clip_run = std::max(m_options.min_clip_run, 1);
+}
+
+template <typename Feed>
+bool PcmDetector::Scan(int64_t frames, Feed&& feed, std::vector<PcmRegion>& regions) const
+{
+    int64_t                       chunks = (frames + m_chunk_frames - 1) / m_chunk_frames;
+    std::vector<std::vector<Run>> runs(chunks);
+    std::atomic<bool>             ok(true);
+
+    parallel_for_rows(static_cast<int>(chunks), [&](int begin, int end) {
+        for (int i = begin; i < end && ok; i++)
+        {
+            int64_t start = i * m_chunk_frames;
+            Scanner scanner(*this, start, std::min(start + m_chunk_frames, frames), runs[i]);
+            if (!feed(scanner, start, std::min(start + m_chunk_frames, frames)))
+            {
+                ok = false;
+            }
+            scanner.Finish();
+        }
+    }, 1);
+
+    std::vector<Run> all;
+    for (auto& chunk : runs)
+    {
+        all.insert(all.end(), chunk.begin(), chunk.end());
+    }
+    Stitch(all, regions);
+    return ok;
+}
+
+void PcmDetector::Stitch(std::vector<Run>& runs, std::vector<PcmRegion>& regions) const
+{
+    // 同类型、同声道且首尾相接的区间合并，再按最短长度过滤
+    std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b) {
+        if (a.region.type != b.region.type)
+        {
+            return a.region.type < b.region.type;
+        }
+        return a.channel != b.channel ? a.channel < b.channel : a.region.start < b.region.start;
+    });
+    std::vector<Run> merged;
+    for (const auto& run : runs)
+    {
+        Run* last = merged.empty() ? nullptr : &merged.back();
+        if (last && last->region.type == run.region.type && last->channel == run.channel && last->region.end == run.region.start)
+        {
+            last->region.end = run.region.end;
+        }
+        else
+        {
+            merged.push_back(run);
+        }
+    }
+
+    std::vector<PcmRegion> clips;
+    regions.clear();
+    for (const auto& run : merged)
+    {
+        int64_t length = run.region.end - run.region.start;
+        if (run.region.type == PCM_REGION_SILENCE && length >= m_min_silence)
+        {
+            regions.push_back(run.region);
+        }
+        else if (run.region.type == PCM_REGION_CLIPPING && length >= m_options.min_clip_run)
+        {
+            clips.push_back(run.region);
+        }
+    }
+
+    // 各声道的削顶区间合并为帧区间
+    std::sort(clips.begin(), clips.end(), [](const PcmRegion& a, const PcmRegion& b) { return a.start < b.start; });
+    size_t silences = regions.size();
+    for (const auto& clip : clips)
+    {
+        if (regions.size() > silences && clip.start <= regions.back().end)
+        {
+            regions.back().end = std::max(regions.back().end, clip.end);
+        }
+        else
+        {
+            regions.push_back(clip);
+        }
+    }
+    std::sort(regions.begin(), regions.end(), [](const PcmRegion& a, const PcmRegion& b) {
+        return a.start != b.start ? a.start < b.start : a.type < b.type;
+    });
+}
+
+void PcmDetector::Detect(const int16_t* samples, int64_t frames, std::vector<PcmRegion>& regions) const
+{
+    Scan(frames, [&](Scanner& scanner, int64_t start, int64_t end) {
+        scanner.Feed(samples + start * m_channels, end - start);
+        return true;
+    }, regions);
+}
+
+int PcmDetector::Detect(const std::string& file, std::vector<PcmRegion>& regions) const
+{
+    regions.clear();
+
+    // WAV 取 data 块的位置，裸 PCM 为整个文件
+    int64_t offset = 0;
+    int64_t bytes  = 0;
+    {
+        std::ifstream in(file, std::ios::in | std::ios::binary);
+        if (!in.is_open())
+        {
+            SPDLOG_ERROR("Failed to open file: {}", file);
+            return -1;
+        }
+        char magic[4] = {};
+        in.read(magic, sizeof(magic));
+        in.seekg(0, std::ios::end);
+        bytes = static_cast<int64_t>(in.tellg());
+        if (!memcmp(magic, "RIFF", 4) || !memcmp(magic, "RF64", 4) || !memcmp(magic, "BW64", 4))
+        {
+            WavReader reader;
+            if (reader.Open(file) != 0)
+            {
+                return -1;
+            }
+            if (reader.Format() != SAMPLE_FORMAT_S16 || reader.Channels() != m_channels)
+            {
+                SPDLOG_ERROR("Unsupported WAV for detection: {} ({} channels, {} bits)", file, reader.Channels(), sample_format_bits(reader.Format()));
+                return -1;
+            }
+            offset = reader.DataOffset();
+            bytes  = reader.DataBytes();
+        }
+    }
+
+    int frameBytes = m_channels * 2;
+    bool ok        = Scan(bytes / frameBytes, [&](Scanner& scanner, int64_t start, int64_t end) {
+        std::ifstream in(file, std::ios::in | std::ios::binary);
+        if (!in.is_open())
+        {
+            return false;
+        }
+        in.seekg(offset + start * frameBytes);
+        AlignedBuffer<int16_t> buffer(static_cast<size_t>(kReadBlocks) * m_block_frames * m_channels);
+        for (int64_t position = start; position < end;)
+        {
+            int64_t frames = std::min<int64_t>(static_cast<int64_t>(kReadBlocks) * m_block_frames, end - position);
+            in.read(reinterpret_cast<char*>(buffer.Data()), frames * frameBytes);
+            if (in.gcount() != frames * frameBytes)
+            {
+                return false;
+            }
+            scanner.Feed(buffer.Data(), frames);
+            position += frames;
+        }
+        return true;
+    }, regions);
+    if (!ok)
+    {
+        SPDLOG_ERROR("Failed to read file: {}", file);
+        return -1;
+    }
+    return 0;
+}
+
+int detect_benchmark()
+{
+    constexpr int     kSampleRate = 44100;
+    constexpr int     kChannels   = 2;
+    constexpr int64_t kFrames     = static_cast<int64_t>(kSampleRate) * 600;
+    constexpr int     kBlock      = 441;
+    constexpr int64_t kBoundary   = static_cast<int64_t>(kSampleRate) * 60; // 默认分块边界
+
+    // 440 Hz 正弦（-10 dBFS 左右）中插入静音与满幅采样
+    std::vector<int16_t> in(static_cast<size_t>(kFrames) * kChannels);
+    for (int64_t i = 0; i < kFrames; i++)
+    {
+        int16_t x             = static_cast<int16_t>(10000.0 * std::sin(2.0 * 3.14159265358979323846 * 440.0 * i / kSampleRate));
+        in[i * kChannels]     = x;
+        in[i * kChannels + 1] = static_cast<int16_t>(-x);
+    }
+    auto silence = [&](int64_t begin, int64_t end) {
+        std::fill(in.begin() + begin * kChannels, in.begin() + end * kChannels, 0);
+    };
+    auto clip = [&](int channel, int64_t begin, int64_t count, int16_t value) {
+        for (int64_t i = begin; i < begin + count; i++)
+        {
+            in[i * kChannels + channel] = value;
+        }
+    };
+    silence(200 * kBlock, 350 * kBlock);                       // 1.5 秒，检出
+    silence(1000 * kBlock, 1030 * kBlock);                     // 0.3 秒，不足最短长度
+    silence(kBoundary - 40 * kBlock, kBoundary + 40 * kBlock); // 跨分块边界，两侧各 0.4 秒
+    clip(1, 500000, 5, 32767);                                 // 检出
+    clip(0, 700000, 2, 32767);                                 // 不足 3 个采样
+    clip(1, 900000, 3, -32768);                                // 负向满幅
+    clip(0, 1200000, 4, 32767);                                // 两个声道重叠，合并为一个区间
+    clip(1, 1200002, 5, -32768);
+    clip(0, 2 * kBoundary - 2, 4, 32767);                      // 跨分块边界，两侧各 2 个
+
+    std::vector<PcmRegion> expect = {
+        {PCM_REGION_SILENCE, 200 * kBlock, 350 * kBlock},
+        {PCM_REGION_CLIPPING, 500000, 500005},
+        {PCM_REGION_CLIPPING, 900000, 900003},
+        {PCM_REGION_CLIPPING, 1200000, 1200007},
+        {PCM_REGION_SILENCE, kBoundary - 40 * kBlock, kBoundary + 40 * kBlock},
+        {PCM_REGION_CLIPPING, 2 * kBoundary - 2, 2 * kBoundary + 2},
+    };
+    auto same = [](const std::vector<PcmRegion>& a, const std::vector<PcmRegion>& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](const PcmRegion& x, const PcmRegion& y) {
+            return x.type == y.type && x.start == y.start && x.end == y.end;
+        });
+    };
+
+    int              ret = 0;
+    PcmDetectOptions options;
+    const double     chunks[] = {60.0, 0.77, 1e6};
+    for (double chunk : chunks)
+    {
+        options.chunk = chunk;
+        PcmDetector            detector(kChannels, kSampleRate, options);
+        std::vector<PcmRegion> regions;
+        detector.Detect(in.data(), kFrames, regions);
+        if (!same(regions, expect))
+        {
+            SPDLOG_ERROR("Detect: {} regions with {} s chunks, expect {}", regions.size(), chunk, expect.size());
+            for (const auto& region : regions)
+            {
+                SPDLOG_ERROR("    {} [{}, {})", region.type == PCM_REGION_SILENCE ? "silence" : "clipping", region.start, region.end);
+            }
+            ret = -1;
+        }
+    }
+
+    PcmDetector            detector(kChannels, kSampleRate);
+    std::vector<PcmRegion> regions;
+    double                 throughput = benchmark_throughput([&] { detector.Detect(in.data(), kFrames, regions); }, in.size() * sizeof(int16_t), 3);
+    SPDLOG_INFO("Detect 10 min stereo: {} regions, {:.2f} GB/s ({:.0f}x realtime) on {} threads", regions.size(), throughput, throughput * 1e9 / (kSampleRate * kChannels * 2), parallel_thread_count());
+
+    return ret;
+}
+
+int simplest_pcm16le_detect(const std::string& file, int channels, int sample_rate)
+{
+    SPDLOG_INFO("Detect silence and clipping: {}", file);
+
+    // WAV 的声道数与采样率以文件为准
+    WavReader reader;
+    {
+        std::ifstream in(file, std::ios::in | std::ios::binary);
+        char          magic[4] = {};
+        in.read(magic, sizeof(magic));
+        if ((!memcmp(magic, "RIFF", 4) || !memcmp(magic, "RF64", 4) || !memcmp(magic, "BW64", 4)) && reader.Open(file) == 0)
+        {
+            channels    = reader.Channels();
+            sample_rate = reader.SampleRate();
+            reader.Close();
+        }
+    }
+
+    PcmDetector            detector(channels, sample_rate);
+    std::vector<PcmRegion> regions;
+    int                    ret     = 0;
+    double                 seconds = benchmark_seconds([&] { ret = detector.Detect(file, regions); }, 1);
+    if (ret != 0)
+    {
+        return -1;
+    }
+
+    std::ofstream csv(file + ".qc.csv", std::ios::out);
+    csv << "type,start,end,duration" << std::endl;
+    csv << std::fixed << std::setprecision(3);
+    int silences = 0, clips = 0;
+    for (const auto& region : regions)
+    {
+        bool silent = region.type == PCM_REGION_SILENCE;
+        csv << (silent ? "silence" : "clipping") << "," << detector.Seconds(region.start) << "," << detector.Seconds(region.end) << "," << detector.Seconds(region.end - region.start) << std::endl;
+        if (silent)
+        {
+            silences++;
+        }
+        else
+        {
+            clips++;
+        }
+    }
+    csv.close();
+    SPDLOG_INFO("{} silent regions, {} clipped regions, scanned in {:.3f} s", silences, clips, seconds);
+
+    return 0;
+}
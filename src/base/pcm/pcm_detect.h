@@ -0,0 +1,125 @@
+#ifndef __PCM_DETECT_H__
+#define __PCM_DETECT_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum PcmRegionType
+{
+    PCM_REGION_SILENCE  = 0, // 静音
+    PCM_REGION_CLIPPING = 1, // 削顶
+};
+
+// 检测到的区间，[start, end) 以帧为单位
+typedef struct PcmRegion
+{
+    PcmRegionType type;  // 区间类型
+    int64_t       start; // 起始帧
+    int64_t       end;   // 结束帧（不含）
+} PcmRegion;
+
+// 检测参数
+typedef struct PcmDetectOptions
+{
+    double silence_db   = -60.0; // 块 RMS 低于该值（dBFS）视为静音
+    double min_silence  = 0.5;   // 最短静音时长（秒）
+    double block        = 0.01;  // 块长（秒）
+    int    clip_level   = 32767; // |x| 不小于该值视为到达满幅
+    int    min_clip_run = 3;     // 同一声道连续到达满幅的采样数不少于该值视为削顶
+    double chunk        = 60.0;  // 分块时长（秒），各分块由不同线程扫描
+} PcmDetectOptions;
+
+/**
+ * @brief   PCM16LE 静音与削顶检测
+ * 1. 文件按 chunk 秒切成若干分块，由 parallel_for_rows 分给多个线程，每个线程用自己的文件句柄顺序读取，
+ *    读取粒度为整数个块；计算量很小，整体速度由磁盘读取决定
+ * 2. 每个块（默认 10 ms）用 SSE2/NEON 一次求出所有声道的平方和与最大、最小值：
+ *    平方和与门限能量比较判断静音，不取对数；只有最大、最小值到达满幅的块才逐采样统计各声道的连续满幅长度
+ * 3. 分块内的区间长度不足时丢弃，但与分块边界相接的区间总是保留；全部分块完成后，
+ *    首尾相接的同类区间（削顶按声道）先合并再按最短长度过滤，结果与不分块扫描一致；
+ *    各声道的削顶区间最后合并为帧区间
+ */
+class PcmDetector
+{
+public:
+    /**
+     * @param   channels                [IN]        声道数
+     * @param   sampleRate              [IN]        采样率
+     * @param   options                 [IN]        检测参数
+     */
+    PcmDetector(int channels, int sampleRate, const PcmDetectOptions& options = PcmDetectOptions());
+    ~PcmDetector() = default;
+
+    int BlockFrames() const
+    {
+        return m_block_frames;
+    }
+
+    /**
+     * @brief   检测文件：RIFF/RF64 开头时按 WAV 解析（必须为 16 位整数且声道数与构造时一致），否则按裸 PCM16LE 处理
+     * @param   file                    [IN]        输入文件路径
+     * @param   regions                 [OUT]       按起始帧排序的区间
+     * @return  0                                   成功
+     *          其他                                打开失败或格式不支持
+     */
+    int Detect(const std::string& file, std::vector<PcmRegion>& regions) const;
+
+    /**
+     * @brief   检测内存中的交织 16 位采样，分块与并行方式同文件
+     * @param   samples                 [IN]        交织采样
+     * @param   frames                  [IN]        帧数
+     * @param   regions                 [OUT]       按起始帧排序的区间
+     */
+    void Detect(const int16_t* samples, int64_t frames, std::vector<PcmRegion>& regions) const;
+
+    /**
+     * @brief   帧序号换算为秒
+     */
+    double Seconds(int64_t frame) const
+    {
+        return static_cast<double>(frame) / m_sample_rate;
+    }
+
+private:
+    // 分块内的原始区间，削顶区间带声道号
+    typedef struct Run
+    {
+        PcmRegion region;
+        int       channel;
+    } Run;
+
+    class Scanner;
+
+    template <typename Feed>
+    bool Scan(int64_t frames, Feed&& feed, std::vector<PcmRegion>& regions) const;
+    void Stitch(std::vector<Run>& runs, std::vector<PcmRegion>& regions) const;
+
+private:
+    int              m_channels;     // 声道数
+    int              m_sample_rate;  // 采样率
+    PcmDetectOptions m_options;      // 检测参数
+    int              m_block_frames; // 块长（帧）
+    int64_t          m_chunk_frames; // 分块长度（帧），块长的整数倍
+    int64_t          m_min_silence;  // 最短静音（帧）
+    float            m_silence_sum;  // 单帧单声道的门限能量（采样值平方）
+};
+
+/**
+ * @brief   检测测试：静音与削顶位置、跨分块边界的区间与不分块结果一致，以及内存扫描速度
+ * @return  0                                   成功
+ *          其他                                结果不一致
+ */
+int detect_benchmark();
+
+/**
+ * @brief   检测PCM16LE（或 16 位 WAV）音频的静音与削顶区间，带时间戳写入 <file>.qc.csv
+ * @param   file                    [IN]        输入文件路径
+ * @param   channels                [IN]        声道数（WAV 以文件为准）
+ * @param   sample_rate             [IN]        采样率（WAV 以文件为准）
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm16le_detect(const std::string& file, int channels, int sample_rate);
+
+#endif
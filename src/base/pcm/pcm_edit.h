@@ -0,0 +1,127 @@
+#ifndef __PCM_EDIT_H__
+#define __PCM_EDIT_H__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/common/aligned_buffer.hpp"
+#include "pcm_format.h"
+
+// 拼接的一段
+typedef struct PcmSegment
+{
+    std::string file;      // 源 PCM 文件
+    int64_t     start;     // 起始帧
+    int64_t     frames;    // 帧数，小于 0 表示到文件末尾
+    int         crossfade; // 与前一段交叉淡化的帧数，0 为无缝拼接
+} PcmSegment;
+
+/**
+ * @brief   按帧编辑裸 PCM 文件：截取、拼接、交叉淡化
+ * 1. 帧序号直接换算为字节偏移（frame * channels * 每采样字节数），不读取区间之外的数据；
+ *    超出文件的部分按文件长度截断
+ * 2. 区间数据由内核直接拷贝：Linux 优先 copy_file_range（同一文件系统上可能只改元数据），
+ *    不支持时退回 sendfile，都不可用（其他平台、跨设备等）时用 1 MiB 缓冲区 pread/write
+ * 3. 多段拼接一次完成，输出文件只打开一次、顺序写入；同一源文件的句柄在编辑器内缓存，
+ *    从长录音中截取大量短片段时不会反复 open
+ * 4. 交叉淡化区间为前一段的最后 N 帧与当前段的前 N 帧按等功率曲线（cos/sin）相加，
+ *    经 SampleConverter 转为 float 计算后饱和写回，输出长度为各段之和减去所有淡化长度
+ */
+class PcmEditor
+{
+public:
+    static constexpr int kFadeFrames     = 4096;    // 交叉淡化每次处理的帧数
+    static constexpr int kCopyBlockBytes = 1 << 20; // 缓冲拷贝的块大小
+
+    /**
+     * @param   format                  [IN]        采样格式
+     * @param   channels                [IN]        声道数
+     */
+    PcmEditor(SampleFormat format, int channels);
+    ~PcmEditor();
+
+    PcmEditor(const PcmEditor&)            = delete;
+    PcmEditor& operator=(const PcmEditor&) = delete;
+
+    int FrameBytes() const
+    {
+        return m_frame_bytes;
+    }
+
+    /**
+     * @brief   帧序号对应的字节偏移
+     */
+    int64_t ByteOffset(int64_t frame) const
+    {
+        return frame * m_frame_bytes;
+    }
+
+    /**
+     * @brief   文件的整帧数，只查询长度，不把文件加入源文件缓存
+     * @return  帧数，文件打开失败时返回 -1
+     */
+    int64_t Frames(const std::string& file);
+
+    /**
+     * @brief   截取 [start, start + frames) 写入 output，output 不能与 input 相同
+     * @return  0                                   成功
+     *          其他                                失败
+     */
+    int Cut(const std::string& input, const std::string& output, int64_t start, int64_t frames);
+
+    /**
+     * @brief   多段拼接写入 output
+     * @param   segments                [IN]        各段，淡化长度不超过相邻两段的可用长度
+     * @param   output                  [IN]        输出文件路径，不能与任何一段的源文件相同
+     * @return  0                                   成功
+     *          其他                                失败
+     */
+    int Concat(const std::vector<PcmSegment>& segments, const std::string& output);
+
+    /**
+     * @brief   累计由内核直接拷贝（copy_file_range / sendfile）的字节数
+     */
+    int64_t ZeroCopyBytes() const
+    {
+        return m_zero_copy_bytes;
+    }
+
+private:
+    int Source(const std::string& file);
+    int Crossfade(int out, int tail, int64_t tailOffset, int head, int64_t headOffset, int frames);
+    int64_t CopyRange(int in, int64_t offset, int out, int64_t bytes);
+
+private:
+    SampleFormat               m_format;          // 采样格式
+    int                        m_channels;        // 声道数
+    int                        m_frame_bytes;     // 每帧字节数
+    std::map<std::string, int> m_sources;         // 已打开的源文件
+    SampleConverter            m_decoder;         // 淡化区间解码为 float
+    SampleConverter            m_encoder;         // 淡化结果编码回原格式
+    AlignedBuffer<uint8_t>     m_buffer;          // 缓冲拷贝 / 淡化区间原始数据
+    AlignedBuffer<float>       m_tail;            // 前一段淡出部分
+    AlignedBuffer<float>       m_head;            // 当前段淡入部分
+    int64_t                    m_zero_copy_bytes; // 内核直接拷贝的字节数
+};
+
+/**
+ * @brief   截取吞吐测试：逐块扫描到区间末尾对比按偏移直接拷贝，以及无缝拼接和交叉淡化的正确性
+ * @param   pcm_16le                [IN]        pcm16le 双声道文件路径
+ * @return  0                                   成功
+ *          其他                                结果不一致或文件打开失败
+ */
+int pcm_edit_benchmark(const std::string& pcm_16le);
+
+/**
+ * @brief   把多段PCM16LE音频采样数据拼接为一个文件
+ * @param   segments                [IN]        各段
+ * @param   channels                [IN]        声道数
+ * @param   output                  [IN]        输出文件路径
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm16le_concat(const std::vector<PcmSegment>& segments, int channels, const std::string& output);
+
+#endif
@@ -0,0 +1,764 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/benchmark.hpp"
+#include "base/common/simd.h"
+#include "pcm_block.h"
+#include "pcm_format.h"
+
+namespace
+{
+    /**
+     * @brief   整数格式的满幅与钳位范围：编码时 v * scale 钳位到 [low, high] 后取整
+     * s32 的上限取 float 能表示的、不超过 2^31 - 1 的最大值
+     */
+    struct FormatRange
+    {
+        float scale;
+        float low;
+        float high;
+    };
+
+    FormatRange format_range(SampleFormat format)
+    {
+        switch (format)
+        {
+        case SAMPLE_FORMAT_U8:
+            return {128.0f, -128.0f, 127.0f};
+        case SAMPLE_FORMAT_S16:
+            return {32768.0f, -32768.0f, 32767.0f};
+        case SAMPLE_FORMAT_S24:
+            return {8388608.0f, -8388608.0f, 8388607.0f};
+        case SAMPLE_FORMAT_S32:
+            return {2147483648.0f, -2147483648.0f, 2147483520.0f};
+        default:
+            return {1.0f, -1.0f, 1.0f};
+        }
+    }
+
+    uint32_t hash32(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    int32_t load_s24(const uint8_t* p)
+    {
+        uint32_t v = static_cast<uint32_t>(p[0]) << 8 | static_cast<uint32_t>(p[1]) << 16 | static_cast<uint32_t>(p[2]) << 24;
+        return static_cast<int32_t>(v) >> 8;
+    }
+
+    void store_s24(uint8_t* p, int32_t value)
+    {
+        p[0] = static_cast<uint8_t>(value);
+        p[1] = static_cast<uint8_t>(value >> 8);
+        p[2] = static_cast<uint8_t>(value >> 16);
+    }
+
+    /**
+     * 与 SIMD 的 max/min + cvtps 一致：NaN 钳位到下限，按当前舍入模式（就近取偶）取整
+     */
+    int32_t quantize(float value, const FormatRange& range, const float* noise, int i)
+    {
+        float v = value * range.scale;
+        if (noise)
+        {
+            v += noise[i];
+        }
+        v = v > range.low ? v : range.low;
+        v = v < range.high ? v : range.high;
+        return static_cast<int32_t>(std::nearbyint(v));
+    }
+
+    // ---------------------------------------------------------------- TPDF 抖动
+
+    /**
+     * 每个 xorshift32 输出拆成两个 16 位均匀分布，相加后减去均值得到 (-1, 1) LSB 的三角分布；
+     * 按 4 个一组生成，count 向上取整到 4 的倍数
+     */
+    void dither_fill_c(uint32_t* state, float* noise, int begin, int end)
+    {
+        for (int i = begin; i < end; i += 4)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                state[k] ^= state[k] << 13;
+                state[k] ^= state[k] >> 17;
+                state[k] ^= state[k] << 5;
+                int n        = static_cast<int>(state[k] & 0xFFFF) + static_cast<int>(state[k] >> 16) - 65535;
+                noise[i + k] = static_cast<float>(n) * (1.0f / 65536.0f);
+            }
+        }
+    }
+
+    void dither_fill(uint32_t* state, float* noise, int count)
+    {
+        int i = 0;
+#if SIMD_SSE2
+        __m128i       s    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+        const __m128i mask = _mm_set1_epi32(0xFFFF);
+        const __m128i bias = _mm_set1_epi32(65535);
+        const __m128  unit = _mm_set1_ps(1.0f / 65536.0f);
+        for (; i < count; i += 4)
+        {
+            s         = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+            s         = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+            s         = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+            __m128i n = _mm_sub_epi32(_mm_add_epi32(_mm_and_si128(s, mask), _mm_srli_epi32(s, 16)), bias);
+            _mm_storeu_ps(noise + i, _mm_mul_ps(_mm_cvtepi32_ps(n), unit));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), s);
+#elif SIMD_NEON
+        uint32x4_t        s    = vld1q_u32(state);
+        const uint32x4_t  mask = vdupq_n_u32(0xFFFF);
+        const int32x4_t   bias = vdupq_n_s32(65535);
+        const float32x4_t unit = vdupq_n_f32(1.0f / 65536.0f);
+        for (; i < count; i += 4)
+        {
+            s           = veorq_u32(s, vshlq_n_u32(s, 13));
+            s           = veorq_u32(s, vshrq_n_u32(s, 17));
+            s           = veorq_u32(s, vshlq_n_u32(s, 5));
+            int32x4_t n = vsubq_s32(vreinterpretq_s32_u32(vaddq_u32(vandq_u32(s, mask), vshrq_n_u32(s, 16))), bias);
+            vst1q_f32(noise + i, vmulq_f32(vcvtq_f32_s32(n), unit));
+        }
+        vst1q_u32(state, s);
+#endif
+        dither_fill_c(state, noise, i, count);
+    }
+
+    // ---------------------------------------------------------------- 解码：格式 -> 归一化 f32
+
+    void decode_c(SampleFormat format, const uint8_t* src, float* dst, int begin, int end)
+    {
+        switch (format)
+        {
+        case SAMPLE_FORMAT_U8:
+            for (int i = begin; i < end; i++)
+            {
+                dst[i] = static_cast<float>(src[i] - 128) * (1.0f / 128.0f);
+            }
+            break;
+        case SAMPLE_FORMAT_S16:
+            for (int i = begin; i < end; i++)
+            {
+                int16_t v;
+                memcpy(&v, src + 2 * i, 2);
+                dst[i] = static_cast<float>(v) * (1.0f / 32768.0f);
+            }
+            break;
+        case SAMPLE_FORMAT_S24:
+            for (int i = begin; i < end; i++)
+            {
+                dst[i] = static_cast<float>(load_s24(src + 3 * i)) * (1.0f / 8388608.0f);
+            }
+            break;
+        case SAMPLE_FORMAT_S32:
+            for (int i = begin; i < end; i++)
+            {
+                int32_t v;
+                memcpy(&v, src + 4 * i, 4);
+                dst[i] = static_cast<float>(v) * (1.0f / 2147483648.0f);
+            }
+            break;
+        case SAMPLE_FORMAT_F32:
+            memcpy(dst + begin, src + 4 * static_cast<size_t>(begin), static_cast<size_t>(end - begin) * 4);
+            break;
+        }
+    }
+
+#if defined(SIMD_X86) && SIMD_SSE2
+    /**
+     * 每次 16 个采样（48 字节）：alignr 把每组 12 字节移到寄存器低端，
+     * pshufb 放进 32 位通道的高 3 字节（低字节清零），左对齐的值按 s32 归一化，与标量结果相同
+     */
+    SIMD_TARGET("ssse3")
+    int decode_s24_ssse3(const uint8_t* src, float* dst, int count)
+    {
+        const __m128i shuffle = _mm_setr_epi8(-128, 0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11);
+        const __m128  unit    = _mm_set1_ps(1.0f / 2147483648.0f);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i* p     = reinterpret_cast<const __m128i*>(src + 3 * i);
+            __m128i        v0    = _mm_loadu_si128(p);
+            __m128i        v1    = _mm_loadu_si128(p + 1);
+            __m128i        v2    = _mm_loadu_si128(p + 2);
+            __m128i        in[4] = {v0, _mm_alignr_epi8(v1, v0, 12), _mm_alignr_epi8(v2, v1, 8), _mm_srli_si128(v2, 4)};
+            for (int k = 0; k < 4; k++)
+            {
+                __m128i v = _mm_shuffle_epi8(in[k], shuffle);
+                _mm_storeu_ps(dst + i + 4 * k, _mm_mul_ps(_mm_cvtepi32_ps(v), unit));
+            }
+        }
+        return i;
+    }
+#endif
+
+    void decode(SampleFormat format, const uint8_t* src, float* dst, int count)
+    {
+        int i = 0;
+        switch (format)
+        {
+        case SAMPLE_FORMAT_U8:
+        {
+#if SIMD_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i bias = _mm_set1_epi16(128);
+            const __m128  unit = _mm_set1_ps(1.0f / 128.0f);
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i v    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i w[2] = {_mm_sub_epi16(_mm_unpacklo_epi8(v, zero), bias), _mm_sub_epi16(_mm_unpackhi_epi8(v, zero), bias)};
+                for (int k = 0; k < 2; k++)
+                {
+                    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(zero, w[k]), 16);
+                    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(zero, w[k]), 16);
+                    _mm_storeu_ps(dst + i + 8 * k, _mm_mul_ps(_mm_cvtepi32_ps(lo), unit));
+                    _mm_storeu_ps(dst + i + 8 * k + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), unit));
+                }
+            }
+#elif SIMD_NEON
+            const float32x4_t unit = vdupq_n_f32(1.0f / 128.0f);
+            for (; i + 16 <= count; i += 16)
+            {
+                int8x16_t v    = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(src + i), vdupq_n_u8(0x80)));
+                int16x8_t w[2] = {vmovl_s8(vget_low_s8(v)), vmovl_s8(vget_high_s8(v))};
+                for (int k = 0; k < 2; k++)
+                {
+                    vst1q_f32(dst + i + 8 * k, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(w[k]))), unit));
+                    vst1q_f32(dst + i + 8 * k + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(w[k]))), unit));
+                }
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_S16:
+        {
+#if SIMD_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128  unit = _mm_set1_ps(1.0f / 32768.0f);
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+                __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(zero, v), 16);
+                __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(zero, v), 16);
+                _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), unit));
+                _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), unit));
+            }
+#elif SIMD_NEON
+            const float32x4_t unit = vdupq_n_f32(1.0f / 32768.0f);
+            for (; i + 8 <= count; i += 8)
+            {
+                int16x8_t v = vreinterpretq_s16_u8(vld1q_u8(src + 2 * i));
+                vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), unit));
+                vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), unit));
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_S24:
+        {
+#if defined(SIMD_X86) && SIMD_SSE2
+            if (simd_cpu_has_ssse3())
+            {
+                i = decode_s24_ssse3(src, dst, count);
+            }
+#elif SIMD_NEON
+            // vld3 按字节解交织，低两字节零扩展、高字节符号扩展后拼成 32 位
+            const float32x4_t unit = vdupq_n_f32(1.0f / 8388608.0f);
+            for (; i + 16 <= count; i += 16)
+            {
+                uint8x16x3_t b     = vld3q_u8(src + 3 * i);
+                uint16x8_t   lo[2] = {vorrq_u16(vmovl_u8(vget_low_u8(b.val[0])), vshll_n_u8(vget_low_u8(b.val[1]), 8)),
+                                      vorrq_u16(vmovl_u8(vget_high_u8(b.val[0])), vshll_n_u8(vget_high_u8(b.val[1]), 8))};
+                int16x8_t    hi[2] = {vmovl_s8(vget_low_s8(vreinterpretq_s8_u8(b.val[2]))), vmovl_s8(vget_high_s8(vreinterpretq_s8_u8(b.val[2])))};
+                for (int k = 0; k < 2; k++)
+                {
+                    int32x4_t v0 = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_low_s16(hi[k])), 16), vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(lo[k]))));
+                    int32x4_t v1 = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_high_s16(hi[k])), 16), vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(lo[k]))));
+                    vst1q_f32(dst + i + 8 * k, vmulq_f32(vcvtq_f32_s32(v0), unit));
+                    vst1q_f32(dst + i + 8 * k + 4, vmulq_f32(vcvtq_f32_s32(v1), unit));
+                }
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_S32:
+        {
+#if SIMD_SSE2
+            const __m128 unit = _mm_set1_ps(1.0f / 2147483648.0f);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+                _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(v), unit));
+            }
+#elif SIMD_NEON
+            const float32x4_t unit = vdupq_n_f32(1.0f / 2147483648.0f);
+            for (; i + 4 <= count; i += 4)
+            {
+                vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vreinterpretq_s32_u8(vld1q_u8(src + 4 * i))), unit));
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_F32:
+            break;
+        }
+        decode_c(format, src, dst, i, count);
+    }
+
+    // ---------------------------------------------------------------- 编码：归一化 f32 -> 格式
+
+    void encode_c(SampleFormat format, const float* src, const float* noise, uint8_t* dst, int begin, int end)
+    {
+        FormatRange range = format_range(format);
+        switch (format)
+        {
+        case SAMPLE_FORMAT_U8:
+            for (int i = begin; i < end; i++)
+            {
+                dst[i] = static_cast<uint8_t>(quantize(src[i], range, noise, i) + 128);
+            }
+            break;
+        case SAMPLE_FORMAT_S16:
+            for (int i = begin; i < end; i++)
+            {
+                int16_t v = static_cast<int16_t>(quantize(src[i], range, noise, i));
+                memcpy(dst + 2 * i, &v, 2);
+            }
+            break;
+        case SAMPLE_FORMAT_S24:
+            for (int i = begin; i < end; i++)
+            {
+                store_s24(dst + 3 * i, quantize(src[i], range, noise, i));
+            }
+            break;
+        case SAMPLE_FORMAT_S32:
+            for (int i = begin; i < end; i++)
+            {
+                int32_t v = quantize(src[i], range, noise, i);
+                memcpy(dst + 4 * i, &v, 4);
+            }
+            break;
+        case SAMPLE_FORMAT_F32:
+            memcpy(dst + 4 * static_cast<size_t>(begin), src + begin, static_cast<size_t>(end - begin) * 4);
+            break;
+        }
+    }
+
+#if SIMD_SSE2
+    /**
+     * 4 个采样缩放、加抖动、钳位后取整；maxps 在 NaN 时返回第二个操作数，与标量一致
+     */
+    inline __m128i quantize_sse2(const float* src, const float* noise, int i, const FormatRange& range)
+    {
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(src + i), _mm_set1_ps(range.scale));
+        if (noise)
+        {
+            v = _mm_add_ps(v, _mm_loadu_ps(noise + i));
+        }
+        v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(range.low)), _mm_set1_ps(range.high));
+        return _mm_cvtps_epi32(v);
+    }
+#elif SIMD_NEON && defined(__aarch64__)
+    /**
+     * vcvtnq 就近取偶，只在 AArch64 上可用；vmaxnm 在 NaN 时返回另一个操作数
+     */
+    inline int32x4_t quantize_neon(const float* src, const float* noise, int i, const FormatRange& range)
+    {
+        float32x4_t v = vmulq_f32(vld1q_f32(src + i), vdupq_n_f32(range.scale));
+        if (noise)
+        {
+            v = vaddq_f32(v, vld1q_f32(noise + i));
+        }
+        v = vminnmq_f32(vmaxnmq_f32(v, vdupq_n_f32(range.low)), vdupq_n_f32(range.high));
+        return vcvtnq_s32_f32(v);
+    }
+#endif
+
+#if defined(SIMD_X86) && SIMD_SSE2
+    /**
+     * 每次 16 个采样：pshufb 把 4 个 32 位值的低 3 字节压到寄存器低 12 字节，
+     * 再用字节移位把 4 组 12 字节拼成 3 个完整的 16 字节写出
+     */
+    SIMD_TARGET("ssse3")
+    int encode_s24_ssse3(const float* src, const float* noise, uint8_t* dst, int count)
+    {
+        const __m128i     shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128);
+        const FormatRange range   = format_range(SAMPLE_FORMAT_S24);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i p[4];
+            for (int k = 0; k < 4; k++)
+            {
+                p[k] = _mm_shuffle_epi8(quantize_sse2(src, noise, i + 4 * k, range), shuffle);
+            }
+            __m128i* out = reinterpret_cast<__m128i*>(dst + 3 * i);
+            _mm_storeu_si128(out, _mm_or_si128(p[0], _mm_slli_si128(p[1], 12)));
+            _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(p[1], 4), _mm_slli_si128(p[2], 8)));
+            _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(p[2], 8), _mm_slli_si128(p[3], 4)));
+        }
+        return i;
+    }
+#endif
+
+    void encode(SampleFormat format, const float* src, const float* noise, uint8_t* dst, int count)
+    {
+        FormatRange range = format_range(format);
+        int         i     = 0;
+        switch (format)
+        {
+        case SAMPLE_FORMAT_U8:
+        {
+#if SIMD_SSE2
+            const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i a = _mm_packs_epi32(quantize_sse2(src, noise, i, range), quantize_sse2(src, noise, i + 4, range));
+                __m128i b = _mm_packs_epi32(quantize_sse2(src, noise, i + 8, range), quantize_sse2(src, noise, i + 12, range));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(_mm_packs_epi16(a, b), bias));
+            }
+#elif SIMD_NEON && defined(__aarch64__)
+            const uint8x16_t bias = vdupq_n_u8(0x80);
+            for (; i + 16 <= count; i += 16)
+            {
+                int16x8_t a = vcombine_s16(vqmovn_s32(quantize_neon(src, noise, i, range)), vqmovn_s32(quantize_neon(src, noise, i + 4, range)));
+                int16x8_t b = vcombine_s16(vqmovn_s32(quantize_neon(src, noise, i + 8, range)), vqmovn_s32(quantize_neon(src, noise, i + 12, range)));
+                vst1q_u8(dst + i, veorq_u8(vreinterpretq_u8_s8(vcombine_s8(vqmovn_s16(a), vqmovn_s16(b))), bias));
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_S16:
+        {
+#if SIMD_SSE2
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i v = _mm_packs_epi32(quantize_sse2(src, noise, i, range), quantize_sse2(src, noise, i + 4, range));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), v);
+            }
+#elif SIMD_NEON && defined(__aarch64__)
+            for (; i + 8 <= count; i += 8)
+            {
+                int16x8_t v = vcombine_s16(vqmovn_s32(quantize_neon(src, noise, i, range)), vqmovn_s32(quantize_neon(src, noise, i + 4, range)));
+                vst1q_u8(dst + 2 * i, vreinterpretq_u8_s16(v));
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_S24:
+        {
+#if defined(SIMD_X86) && SIMD_SSE2
+            if (simd_cpu_has_ssse3())
+            {
+                i = encode_s24_ssse3(src, noise, dst, count);
+            }
+#elif SIMD_NEON && defined(__aarch64__)
+            // 按字节拆成 3 个寄存器，vst3 交织写出
+            for (; i + 16 <= count; i += 16)
+            {
+                int32x4_t    v[4] = {quantize_neon(src, noise, i, range), quantize_neon(src, noise, i + 4, range), quantize_neon(src, noise, i + 8, range),
+                                     quantize_neon(src, noise, i + 12, range)};
+                uint8x16x3_t b;
+                for (int k = 0; k < 3; k++)
+                {
+                    int32x4_t  shift = vdupq_n_s32(-8 * k);
+                    uint16x8_t lo    = vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(vshlq_s32(v[0], shift))), vmovn_u32(vreinterpretq_u32_s32(vshlq_s32(v[1], shift))));
+                    uint16x8_t hi    = vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(vshlq_s32(v[2], shift))), vmovn_u32(vreinterpretq_u32_s32(vshlq_s32(v[3], shift))));
+                    b.val[k]         = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+                }
+                vst3q_u8(dst + 3 * i, b);
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_S32:
+        {
+#if SIMD_SSE2
+            for (; i + 4 <= count; i += 4)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), quantize_sse2(src, noise, i, range));
+            }
+#elif SIMD_NEON && defined(__aarch64__)
+            for (; i + 4 <= count; i += 4)
+            {
+                vst1q_u8(dst + 4 * i, vreinterpretq_u8_s32(quantize_neon(src, noise, i, range)));
+            }
+#endif
+            break;
+        }
+        case SAMPLE_FORMAT_F32:
+            break;
+        }
+        encode_c(format, src, noise, dst, i, count);
+    }
+} // namespace
+
+int sample_format_bytes(SampleFormat format)
+{
+    switch (format)
+    {
+    case SAMPLE_FORMAT_U8:
+        return 1;
+    case SAMPLE_FORMAT_S16:
+        return 2;
+    case SAMPLE_FORMAT_S24:
+        return 3;
+    default:
+        return 4;
+    }
+}
+
+int sample_format_bits(SampleFormat format)
+{
+    switch (format)
+    {
+    case SAMPLE_FORMAT_U8:
+        return 8;
+    case SAMPLE_FORMAT_S16:
+        return 16;
+    case SAMPLE_FORMAT_S32:
+        return 32;
+    default:
+        return 24;
+    }
+}
+
+const char* sample_format_name(SampleFormat format)
+{
+    switch (format)
+    {
+    case SAMPLE_FORMAT_U8:
+        return "u8";
+    case SAMPLE_FORMAT_S16:
+        return "s16le";
+    case SAMPLE_FORMAT_S24:
+        return "s24le";
+    case SAMPLE_FORMAT_S32:
+        return "s32le";
+    default:
+        return "f32le";
+    }
+}
+
+SampleConverter::SampleConverter(SampleFormat srcFormat, SampleFormat dstFormat, int channels, bool dither, uint32_t seed)
+    : m_src_format(srcFormat)
+    , m_dst_format(dstFormat)
+    , m_channels(std::max(channels, 1))
+    , m_dither(dither && dstFormat != SAMPLE_FORMAT_F32 && (srcFormat == SAMPLE_FORMAT_F32 || sample_format_bits(dstFormat) < sample_format_bits(srcFormat)))
+    , m_seed(seed)
+    , m_samples(kChunkSamples)
+    , m_plane(kChunkSamples)
+    , m_noise(m_dither ? kChunkSamples : 0)
+{
+    Reset();
+}
+
+void SampleConverter::Reset()
+{
+    for (int i = 0; i < 4; i++)
+    {
+        m_state[i] = hash32(m_seed * 4 + i) | 1;
+    }
+}
+
+void SampleConverter::Encode(const float* src, uint8_t* dst, int count)
+{
+    const float* noise = nullptr;
+    if (m_dither)
+    {
+        dither_fill(m_state, m_noise.Data(), count);
+        noise = m_noise.Data();
+    }
+    encode(m_dst_format, src, noise, dst, count);
+}
+
+void SampleConverter::Convert(const uint8_t* src, uint8_t* dst, int frames)
+{
+    size_t srcBytes = sample_format_bytes(m_src_format);
+    size_t dstBytes = sample_format_bytes(m_dst_format);
+    int    count    = frames * m_channels;
+    if (m_src_format == m_dst_format && !m_dither)
+    {
+        memcpy(dst, src, count * srcBytes);
+        return;
+    }
+
+    for (int i = 0; i < count; i += kChunkSamples)
+    {
+        int n = std::min(kChunkSamples, count - i);
+        decode(m_src_format, src + i * srcBytes, m_samples.Data(), n);
+        Encode(m_samples.Data(), dst + i * dstBytes, n);
+    }
+}
+
+void SampleConverter::ConvertToPlanar(const uint8_t* src, uint8_t* const* dst, int frames)
+{
+    size_t srcBytes = sample_format_bytes(m_src_format);
+    size_t dstBytes = sample_format_bytes(m_dst_format);
+    if (m_src_format == m_dst_format && !m_dither)
+    {
+        for (int i = 0; i < frames; i++)
+        {
+            for (int c = 0; c < m_channels; c++)
+            {
+                memcpy(dst[c] + i * dstBytes, src + (static_cast<size_t>(i) * m_channels + c) * srcBytes, srcBytes);
+            }
+        }
+        return;
+    }
+
+    // 整块解码后按声道抽出，每个声道单独编码
+    int chunkFrames = std::max(kChunkSamples / m_channels, 1);
+    for (int i = 0; i < frames; i += chunkFrames)
+    {
+        int n = std::min(chunkFrames, frames - i);
+        decode(m_src_format, src + static_cast<size_t>(i) * m_channels * srcBytes, m_samples.Data(), n * m_channels);
+        for (int c = 0; c < m_channels; c++)
+        {
+            for (int k = 0; k < n; k++)
+            {
+                m_plane[k] = m_samples[k * m_channels + c];
+            }
+            Encode(m_plane.Data(), dst[c] + i * dstBytes, n);
+        }
+    }
+}
+
+void SampleConverter::ConvertFromPlanar(const uint8_t* const* src, uint8_t* dst, int frames)
+{
+    size_t srcBytes = sample_format_bytes(m_src_format);
+    size_t dstBytes = sample_format_bytes(m_dst_format);
+    if (m_src_format == m_dst_format && !m_dither)
+    {
+        for (int i = 0; i < frames; i++)
+        {
+            for (int c = 0; c < m_channels; c++)
+            {
+                memcpy(dst + (static_cast<size_t>(i) * m_channels + c) * dstBytes, src[c] + i * srcBytes, srcBytes);
+            }
+        }
+        return;
+    }
+
+    // 每个声道解码后交织到整块，整块一次编码
+    int chunkFrames = std::max(kChunkSamples / m_channels, 1);
+    for (int i = 0; i < frames; i += chunkFrames)
+    {
+        int n = std::min(chunkFrames, frames - i);
+        for (int c = 0; c < m_channels; c++)
+        {
+            decode(m_src_format, src[c] + i * srcBytes, m_plane.Data(), n);
+            for (int k = 0; k < n; k++)
+            {
+                m_samples[k * m_channels + c] = m_plane[k];
+            }
+        }
+        Encode(m_samples.Data(), dst + static_cast<size_t>(i) * m_channels * dstBytes, n * m_channels);
+    }
+}
+
+int sample_format_benchmark()
+{
+    constexpr int kSamples    = 1 << 20;
+    constexpr int kIterations = 20;
+    int           ret         = 0;
+
+    // 覆盖满幅外的值以检查饱和
+    AlignedBuffer<float>   src(kSamples), decoded(kSamples), reference(kSamples), noise(kSamples);
+    AlignedBuffer<uint8_t> encoded(kSamples * 4), encodedReference(kSamples * 4);
+    for (int i = 0; i < kSamples; i++)
+    {
+        src[i] = static_cast<float>(static_cast<int32_t>(hash32(i))) * (1.25f / 2147483648.0f);
+    }
+    uint32_t state[4]          = {1, 2, 3, 4};
+    uint32_t stateReference[4] = {1, 2, 3, 4};
+    dither_fill(state, noise.Data(), kSamples);
+    dither_fill_c(stateReference, reference.Data(), 0, kSamples);
+    if (memcmp(noise.Data(), reference.Data(), kSamples * sizeof(float)) != 0)
+    {
+        SPDLOG_ERROR("TPDF dither: SIMD result mismatch");
+        ret = -1;
+    }
+
+    const SampleFormat formats[] = {SAMPLE_FORMAT_U8, SAMPLE_FORMAT_S16, SAMPLE_FORMAT_S24, SAMPLE_FORMAT_S32, SAMPLE_FORMAT_F32};
+    for (SampleFormat format : formats)
+    {
+        const char* name  = sample_format_name(format);
+        size_t      bytes = static_cast<size_t>(kSamples) * sample_format_bytes(format);
+
+        // 编码（带抖动），再把编码结果解码
+        encode(format, src.Data(), noise.Data(), encoded.Data(), kSamples);
+        encode_c(format, src.Data(), noise.Data(), encodedReference.Data(), 0, kSamples);
+        if (memcmp(encoded.Data(), encodedReference.Data(), bytes) != 0)
+        {
+            SPDLOG_ERROR("PCM encode {}: SIMD result mismatch", name);
+            ret = -1;
+        }
+        decode(format, encoded.Data(), decoded.Data(), kSamples);
+        decode_c(format, encoded.Data(), reference.Data(), 0, kSamples);
+        if (memcmp(decoded.Data(), reference.Data(), kSamples * sizeof(float)) != 0)
+        {
+            SPDLOG_ERROR("PCM decode {}: SIMD result mismatch", name);
+            ret = -1;
+        }
+
+        double encodeScalar = benchmark_throughput([&] { encode_c(format, src.Data(), noise.Data(), encodedReference.Data(), 0, kSamples); }, bytes, kIterations);
+        double encodeSimd   = benchmark_throughput([&] { encode(format, src.Data(), noise.Data(), encoded.Data(), kSamples); }, bytes, kIterations);
+        double decodeScalar = benchmark_throughput([&] { decode_c(format, encoded.Data(), reference.Data(), 0, kSamples); }, bytes, kIterations);
+        double decodeSimd   = benchmark_throughput([&] { decode(format, encoded.Data(), decoded.Data(), kSamples); }, bytes, kIterations);
+        SPDLOG_INFO("PCM {}: encode {:.2f} -> {:.2f} GB/s, decode {:.2f} -> {:.2f} GB/s", name, encodeScalar, encodeSimd, decodeScalar, decodeSimd);
+    }
+
+    // 整条转换路径，吞吐按源数据字节数计
+    const SampleFormat pairs[][2] = {{SAMPLE_FORMAT_S16, SAMPLE_FORMAT_F32}, {SAMPLE_FORMAT_F32, SAMPLE_FORMAT_S16}, {SAMPLE_FORMAT_S24, SAMPLE_FORMAT_S16}, {SAMPLE_FORMAT_S16, SAMPLE_FORMAT_U8}};
+    encode(SAMPLE_FORMAT_F32, src.Data(), nullptr, encoded.Data(), kSamples);
+    for (const auto& pair : pairs)
+    {
+        SampleConverter        converter(pair[0], pair[1], 2, true);
+        AlignedBuffer<uint8_t> input(kSamples * 4);
+        SampleConverter(SAMPLE_FORMAT_F32, pair[0], 2).Convert(encoded.Data(), input.Data(), kSamples / 2);
+
+        size_t bytes = static_cast<size_t>(kSamples) * sample_format_bytes(pair[0]);
+        double speed = benchmark_throughput([&] { converter.Convert(input.Data(), encodedReference.Data(), kSamples / 2); }, bytes, kIterations);
+        SPDLOG_INFO("PCM convert {} -> {}{}: {:.2f} GB/s", sample_format_name(pair[0]), sample_format_name(pair[1]), converter.Dithering() ? " (TPDF)" : "", speed);
+    }
+
+    return ret;
+}
+
+int simplest_pcm_convert(const std::string& filename, SampleFormat srcFormat, SampleFormat dstFormat, int channels, bool dither)
+{
+    SPDLOG_INFO("Convert PCM {} -> {}: {}", sample_format_name(srcFormat), sample_format_name(dstFormat), filename);
+    std::ofstream output(filename + "." + sample_format_name(dstFormat), std::ios::out | std::ios::binary);
+
+    PcmBlockEngine         engine(channels, sample_format_bytes(srcFormat));
+    SampleConverter        converter(srcFormat, dstFormat, channels, dither);
+    AlignedBuffer<uint8_t> block(static_cast<size_t>(engine.BlockFrames()) * channels * sample_format_bytes(dstFormat));
+
+    int64_t count = engine.Run(filename, [&](const uint8_t* data, int frames) {
+        converter.Convert(data, block.Data(), frames);
+        output.write(reinterpret_cast<const char*>(block.Data()), static_cast<size_t>(frames) * channels * sample_format_bytes(dstFormat));
+        return true;
+    });
+    if (count < 0)
+    {
+        return -1;
+    }
+    SPDLOG_INFO("Sample count: {}", count);
+
+    output.close();
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#ifndef __PCM_FORMAT_H__
+#define __PCM_FORMAT_H__
+
+#include <cstdint>
+#include <string>
+
+#include "base/common/aligned_buffer.hpp"
+
+enum SampleFormat
+{
+    SAMPLE_FORMAT_U8  = 0, // 无符号 8 位，静音为 128
+    SAMPLE_FORMAT_S16 = 1, // 有符号 16 位小端
+    SAMPLE_FORMAT_S24 = 2, // 有符号 24 位小端，紧凑排列（每采样 3 字节）
+    SAMPLE_FORMAT_S32 = 3, // 有符号 32 位小端
+    SAMPLE_FORMAT_F32 = 4, // 32 位浮点，满幅为 [-1.0, 1.0)
+};
+
+/**
+ * @brief   每个采样的字节数
+ */
+int sample_format_bytes(SampleFormat format);
+
+/**
+ * @brief   每个采样的有效位数，浮点按尾数 24 位计
+ */
+int sample_format_bits(SampleFormat format);
+
+/**
+ * @brief   格式名，用作输出文件扩展名（u8 / s16le / s24le / s32le / f32le）
+ */
+const char* sample_format_name(SampleFormat format);
+
+/**
+ * @brief   采样格式转换
+ * 1. 以归一化的 f32 为中间格式：源格式按块解码到 L1 内的浮点缓冲区，再编码为目标格式，
+ *    块大小 4096 个采样，两趟都在缓存内完成，整体受内存带宽限制
+ * 2. 编码时先钳位再按当前舍入模式（就近取偶）取整，超出范围的采样饱和而不是回绕；
+ *    s16/u8 用 packs 指令收窄，s24 的 3 字节拼装走标量
+ * 3. 目标为整数且位数低于源格式时可以开启 TPDF 抖动：两个独立均匀分布之和，幅度 ±1 LSB，
+ *    由 4 路 xorshift32 生成，标量实现逐路模拟，与 SIMD 结果逐位一致；状态跨块延续
+ * 4. 同格式且不抖动时直接拷贝
+ * 解码/编码内核 SSE2 与 NEON（AArch64）实现，其他平台走标量
+ */
+class SampleConverter
+{
+public:
+    static constexpr int kChunkSamples = 4096;
+
+    /**
+     * @param   srcFormat               [IN]        源格式
+     * @param   dstFormat               [IN]        目标格式
+     * @param   channels                [IN]        声道数
+     * @param   dither                  [IN]        降低位深时是否加 TPDF 抖动
+     * @param   seed                    [IN]        抖动随机数种子
+     */
+    SampleConverter(SampleFormat srcFormat, SampleFormat dstFormat, int channels, bool dither = false, uint32_t seed = 1);
+    ~SampleConverter() = default;
+
+    /**
+     * @brief   交织转交织
+     * @param   src                     [IN]        源数据，frames * channels 个采样
+     * @param   dst                     [OUT]       目标数据，frames * channels 个采样
+     * @param   frames                  [IN]        帧数
+     */
+    void Convert(const uint8_t* src, uint8_t* dst, int frames);
+
+    /**
+     * @brief   交织转平面
+     * @param   src                     [IN]        源数据（交织）
+     * @param   dst                     [OUT]       每个声道一个平面，channels 个指针
+     * @param   frames                  [IN]        帧数
+     */
+    void ConvertToPlanar(const uint8_t* src, uint8_t* const* dst, int frames);
+
+    /**
+     * @brief   平面转交织
+     * @param   src                     [IN]        每个声道一个平面，channels 个指针
+     * @param   dst                     [OUT]       目标数据（交织）
+     * @param   frames                  [IN]        帧数
+     */
+    void ConvertFromPlanar(const uint8_t* const* src, uint8_t* dst, int frames);
+
+    /**
+     * @brief   重置抖动状态，之后的输出与新建的转换器相同
+     */
+    void Reset();
+
+    bool Dithering() const
+    {
+        return m_dither;
+    }
+
+private:
+    void Encode(const float* src, uint8_t* dst, int count);
+
+private:
+    SampleFormat         m_src_format;    // 源格式
+    SampleFormat         m_dst_format;    // 目标格式
+    int                  m_channels;      // 声道数
+    bool                 m_dither;        // 是否抖动（只在降低位深时生效）
+    uint32_t             m_seed;          // 抖动种子
+    uint32_t             m_state[4];      // 4 路 xorshift32 状态
+    AlignedBuffer<float> m_samples;       // 解码后的浮点块（交织）
+    AlignedBuffer<float> m_plane;         // 平面转换时单个声道的浮点块
+    AlignedBuffer<float> m_noise;         // 抖动噪声（以目标 LSB 为单位）
+};
+
+/**
+ * @brief   格式转换吞吐测试：各格式对的解码/编码内核及 TPDF 抖动对比标量实现
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int sample_format_benchmark();
+
+/**
+ * @brief   转换PCM文件的采样格式，写入 <filename>.<目标格式名>
+ * @param   filename                [IN]        PCM 输入文件路径
+ * @param   srcFormat               [IN]        源格式
+ * @param   dstFormat               [IN]        目标格式
+ * @param   channels                [IN]        声道数
+ * @param   dither                  [IN]        降低位深时是否加 TPDF 抖动
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm_convert(const std::string& filename, SampleFormat srcFormat, SampleFormat dstFormat, int channels, bool dither);
+
+#endif
@@ -0,0 +1,188 @@
+#include <cmath>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/loudness.hpp"
+#include "pcm_block.h"
+#include "pcm_format.h"
+#include "pcm_loudness.h"
+
+namespace
+{
+    constexpr double kPi = 3.14159265358979323846;
+
+    /**
+     * 双精度、逐声道逐采样的综合响度参考实现（BS.1770-4 原文步骤）
+     */
+    double integrated_reference(const float* in, int frames, int channels, int sampleRate, const std::vector<double>& weights)
+    {
+        // 高搁架 + RLB 高通，b0 b1 b2 a1 a2
+        double f0 = 1681.974450955533, g = 3.999843853973347, q = 0.7071752369554196;
+        double k  = std::tan(kPi * f0 / sampleRate);
+        double vh = std::pow(10.0, g / 20.0), vb = std::pow(vh, 0.4996667741545416);
+        double a0 = 1.0 + k / q + k * k;
+        double s1[5] = {(vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+        f0 = 38.13547087602444, q = 0.5003270373238773;
+        k  = std::tan(kPi * f0 / sampleRate);
+        a0 = 1.0 + k / q + k * k;
+        double s2[5] = {1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+
+        int                 step = (sampleRate + 5) / 10;
+        int                 subs = frames / step;
+        std::vector<double> energy(subs, 0.0);
+        for (int c = 0; c < channels; c++)
+        {
+            double x1 = 0, x2 = 0, y1 = 0, y2 = 0, z1 = 0, z2 = 0;
+            for (int i = 0; i < subs * step; i++)
+            {
+                double x = in[static_cast<size_t>(i) * channels + c];
+                double y = s1[0] * x + s1[1] * x1 + s1[2] * x2 - s1[3] * y1 - s1[4] * y2;
+                double z = s2[0] * y + s2[1] * y1 + s2[2] * y2 - s2[3] * z1 - s2[4] * z2;
+                x2 = x1, x1 = x, y2 = y1, y1 = y, z2 = z1, z1 = z;
+                energy[i / step] += weights[c] * z * z / step;
+            }
+        }
+
+        std::vector<double> blocks;
+        for (int i = 3; i < subs; i++)
+        {
+            blocks.push_back((energy[i] + energy[i - 1] + energy[i - 2] + energy[i - 3]) / 4.0);
+        }
+        auto gated = [&](double gate) {
+            double sum   = 0.0;
+            int    count = 0;
+            for (double e : blocks)
+            {
+                if (e > gate)
+                {
+                    sum += e;
+                    count++;
+                }
+            }
+            return count ? sum / count : 0.0;
+        };
+        double absolute = std::pow(10.0, (-70.0 + 0.691) / 10.0);
+        double relative = gated(absolute) * 0.1;
+        return -0.691 + 10.0 * std::log10(gated(std::max(absolute, relative)));
+    }
+} // namespace
+
+int loudness_benchmark()
+{
+    constexpr int kSampleRate = 48000;
+    int           ret         = 0;
+
+    auto check = [&](const char* name, double value, double expect, double tolerance) {
+        bool ok = std::fabs(value - expect) <= tolerance;
+        if (!ok)
+        {
+            SPDLOG_ERROR("Loudness {}: {:.3f}, expect {:.3f} +- {}", name, value, expect, tolerance);
+            ret = -1;
+        }
+        return ok;
+    };
+
+    // 1 kHz 正弦，两个声道都为 -23 dBFS，20 秒：综合、短期、瞬时响度均为 -23 LUFS
+    {
+        int                  frames    = kSampleRate * 20;
+        double               amplitude = std::pow(10.0, -23.0 / 20.0);
+        AlignedBuffer<float> in(static_cast<size_t>(frames) * 2);
+        for (int i = 0; i < frames; i++)
+        {
+            in[2 * i]     = static_cast<float>(amplitude * std::sin(2.0 * kPi * 1000.0 * i / kSampleRate));
+            in[2 * i + 1] = in[2 * i];
+        }
+        LoudnessMeter meter(kSampleRate, 2);
+        meter.Process(in.Data(), frames);
+        check("1 kHz integrated", meter.Integrated(), -23.0, 0.1);
+        check("1 kHz short-term", meter.ShortTerm(), -23.0, 0.1);
+        check("1 kHz momentary", meter.Momentary(), -23.0, 0.1);
+        SPDLOG_INFO("Loudness 1 kHz -23 dBFS: I {:.2f} LUFS, S {:.2f}, M {:.2f}, LRA {:.2f} LU", meter.Integrated(), meter.ShortTerm(), meter.Momentary(), meter.LoudnessRange());
+
+        // 分块输入与整段输入结果相同
+        LoudnessMeter split(kSampleRate, 2);
+        for (int i = 0, n = 1; i < frames; i += n, n = n * 3 % 5000 + 1)
+        {
+            split.Process(in.Data() + static_cast<size_t>(i) * 2, std::min(n, frames - i));
+        }
+        if (split.Integrated() != meter.Integrated() || split.TruePeak() != meter.TruePeak())
+        {
+            SPDLOG_ERROR("Loudness: split input mismatch");
+            ret = -1;
+        }
+    }
+
+    // fs/4 正弦、相位 45°：采样峰值 -3.01 dBFS，真峰值接近 0 dBTP
+    {
+        int                  frames = kSampleRate;
+        AlignedBuffer<float> in(frames);
+        for (int i = 0; i < frames; i++)
+        {
+            in[i] = static_cast<float>(std::sin(kPi / 2.0 * i + kPi / 4.0));
+        }
+        LoudnessMeter meter(kSampleRate, 1);
+        meter.Process(in.Data(), frames);
+        check("sample peak", meter.SamplePeak(), -3.01, 0.01);
+        check("true peak", meter.TruePeak(), 0.0, 0.4);
+        SPDLOG_INFO("Loudness fs/4 sine: sample peak {:.2f} dBFS, true peak {:.2f} dBTP", meter.SamplePeak(), meter.TruePeak());
+    }
+
+    // 5.1 多音调信号，对比双精度参考实现；60 秒计处理速度
+    const int layouts[] = {2, 6};
+    for (int channels : layouts)
+    {
+        int                  frames = kSampleRate * 60;
+        AlignedBuffer<float> in(static_cast<size_t>(frames) * channels);
+        for (int i = 0; i < frames; i++)
+        {
+            double t        = static_cast<double>(i) / kSampleRate;
+            double envelope = 0.5 + 0.5 * std::sin(2.0 * kPi * 0.05 * t);
+            for (int c = 0; c < channels; c++)
+            {
+                in[static_cast<size_t>(i) * channels + c] = static_cast<float>(envelope * (0.2 * std::sin(2.0 * kPi * (60.0 + 150.0 * c) * t) + 0.1 * std::sin(2.0 * kPi * (3000.0 + 1700.0 * c) * t)));
+            }
+        }
+        LoudnessMeter       meter(kSampleRate, channels);
+        std::vector<double> weights(channels, 1.0);
+        if (channels == 6)
+        {
+            weights = {1.0, 1.0, 1.0, 0.0, 1.41, 1.41};
+        }
+        double seconds = benchmark_seconds([&] {
+            meter.Reset();
+            meter.Process(in.Data(), frames);
+        }, 3);
+        double reference = integrated_reference(in.Data(), frames, channels, kSampleRate, weights);
+        check(channels == 6 ? "5.1 integrated" : "stereo integrated", meter.Integrated(), reference, 0.02);
+        SPDLOG_INFO("Loudness {} channels: I {:.3f} LUFS (reference {:.3f}), LRA {:.2f} LU, {:.0f}x realtime", channels, meter.Integrated(), reference, meter.LoudnessRange(), 60.0 / seconds);
+    }
+
+    return ret;
+}
+
+int simplest_pcm16le_loudness(const std::string& pcm_16le, int channels, int sample_rate)
+{
+    SPDLOG_INFO("Measure loudness of PCM16LE: {}", pcm_16le);
+
+    PcmBlockEngine       engine(channels);
+    LoudnessMeter        meter(sample_rate, channels);
+    SampleConverter      toFloat(SAMPLE_FORMAT_S16, SAMPLE_FORMAT_F32, channels);
+    AlignedBuffer<float> samples(engine.BlockFrames() * channels);
+
+    int64_t count = engine.Run(pcm_16le, [&](const uint8_t* data, int frames) {
+        toFloat.Convert(data, reinterpret_cast<uint8_t*>(samples.Data()), frames);
+        meter.Process(samples.Data(), frames);
+        return true;
+    });
+    if (count < 0)
+    {
+        return -1;
+    }
+    SPDLOG_INFO("Integrated {:.1f} LUFS, LRA {:.1f} LU, max momentary {:.1f} LUFS, max short-term {:.1f} LUFS", meter.Integrated(), meter.LoudnessRange(), meter.MaxMomentary(), meter.MaxShortTerm());
+    SPDLOG_INFO("True peak {:.2f} dBTP, sample peak {:.2f} dBFS", meter.TruePeak(), meter.SamplePeak());
+
+    return 0;
+}
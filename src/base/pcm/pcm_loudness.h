@@ -0,0 +1,24 @@
+#ifndef __PCM_LOUDNESS_H__
+#define __PCM_LOUDNESS_H__
+
+#include <string>
+
+/**
+ * @brief   响度计测试：EBU Tech 3341 风格的 1 kHz -23 dBFS 正弦、fs/4 正弦的真峰值、分块与整段输入一致性、
+ *          对比双精度逐声道参考实现的综合响度，以及双声道 / 5.1 的处理速度
+ * @return  0                                   成功
+ *          其他                                测量结果超出容差
+ */
+int loudness_benchmark();
+
+/**
+ * @brief   测量PCM16LE音频采样数据的响度（EBU R128，base/common/loudness.hpp）
+ * @param   pcm_16le                [IN]        pcm16le 输入文件路径
+ * @param   channels                [IN]        声道数
+ * @param   sample_rate             [IN]        采样率
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm16le_loudness(const std::string& pcm_16le, int channels, int sample_rate);
+
+#endif
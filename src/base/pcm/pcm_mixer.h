@@ -0,0 +1,157 @@
+#ifndef __PCM_MIXER_H__
+#define __PCM_MIXER_H__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/common/aligned_buffer.hpp"
+#include "pcm_format.h"
+
+/**
+ * @brief   增益矩阵：outputs 行 x inputs 列，out[m] = Σ gain[m][k] * in[k]
+ * 多个输入流时，列按输入流顺序把各流的声道依次排开
+ * 5.1 声道顺序为 FL FR FC LFE BL BR（WAV / FFmpeg 默认顺序）
+ */
+class ChannelMatrix
+{
+public:
+    /**
+     * @param   outputs                 [IN]        输出声道数
+     * @param   inputs                  [IN]        输入声道总数
+     */
+    ChannelMatrix(int outputs, int inputs);
+    ~ChannelMatrix() = default;
+
+    /**
+     * @brief   单位矩阵，声道原样输出
+     */
+    static ChannelMatrix Identity(int channels);
+
+    /**
+     * @brief   每个声道单独乘增益（对角矩阵）
+     */
+    static ChannelMatrix Gain(const std::vector<float>& gains);
+
+    /**
+     * @brief   5.1 下混为立体声（ITU-R BS.775）：L = FL + 0.707 FC + 0.707 BL，R 对称，LFE 丢弃
+     */
+    static ChannelMatrix Downmix51To20();
+
+    /**
+     * @brief   立体声上混为 5.1：FL/FR 原样，FC = (L + R) / 2，LFE 与环绕声道为空
+     */
+    static ChannelMatrix Upmix20To51();
+
+    /**
+     * @brief   单声道等功率声像：L = gain * cos(θ)，R = gain * sin(θ)，θ = (pan + 1) * π / 4
+     * @param   gain                    [IN]        增益
+     * @param   pan                     [IN]        声像，-1 最左，0 居中，1 最右
+     */
+    static ChannelMatrix Pan(float gain, float pan);
+
+    int Outputs() const
+    {
+        return m_outputs;
+    }
+
+    int Inputs() const
+    {
+        return m_inputs;
+    }
+
+    float& At(int output, int input)
+    {
+        return m_gains[static_cast<size_t>(output) * m_inputs + input];
+    }
+
+    float At(int output, int input) const
+    {
+        return m_gains[static_cast<size_t>(output) * m_inputs + input];
+    }
+
+private:
+    int                m_outputs; // 输出声道数
+    int                m_inputs;  // 输入声道总数
+    std::vector<float> m_gains;   // 行优先的增益
+};
+
+/**
+ * @brief   多路混音 / 声道重映射
+ * 1. 每路输入按块（kChunkFrames 帧）转成平面 float，每个输出声道对非零增益的输入平面做 acc += g * x，
+ *    沿时间方向向量化（SSE2/NEON），零增益直接跳过，单位矩阵时等价于拷贝
+ * 2. 结果由 SampleConverter 编码回目标格式，钳位饱和，不会回绕
+ * 3. 输入输出采样格式相同，采样率需一致（不同采样率先用 Resampler 转换）
+ */
+class PcmMixer
+{
+public:
+    static constexpr int kChunkFrames = 1024;
+
+    /**
+     * @param   inputChannels           [IN]        每路输入的声道数（至少 1），总和必须等于 matrix.Inputs()，否则 IsValid() 为 false
+     * @param   matrix                  [IN]        增益矩阵
+     * @param   format                  [IN]        输入输出采样格式
+     */
+    PcmMixer(const std::vector<int>& inputChannels, const ChannelMatrix& matrix, SampleFormat format = SAMPLE_FORMAT_S16);
+    ~PcmMixer() = default;
+
+    /**
+     * @brief   声道配置是否与矩阵一致，不一致时 Mix 不做任何处理
+     */
+    bool IsValid() const
+    {
+        return m_valid;
+    }
+
+    /**
+     * @brief   混音
+     * @param   inputs                  [IN]        每路输入（交织），inputChannels.size() 个指针，每路 frames 帧
+     * @param   output                  [OUT]       输出（交织），frames * matrix.Outputs() 个采样
+     * @param   frames                  [IN]        帧数
+     * @return  0                                   成功
+     *          其他                                声道配置与矩阵不一致
+     */
+    int Mix(const uint8_t* const* inputs, uint8_t* output, int frames);
+
+    int InputCount() const
+    {
+        return static_cast<int>(m_input_channels.size());
+    }
+
+    int OutputChannels() const
+    {
+        return m_matrix.Outputs();
+    }
+
+private:
+    std::vector<int>                              m_input_channels; // 每路输入的声道数
+    ChannelMatrix                                 m_matrix;         // 增益矩阵
+    bool                                          m_valid;          // 声道配置与矩阵是否一致
+    SampleFormat                                  m_format;         // 采样格式
+    std::vector<std::unique_ptr<SampleConverter>> m_decoders;       // 每路输入：交织 -> 平面 float
+    std::unique_ptr<SampleConverter>              m_encoder;        // 平面 float -> 交织输出
+    AlignedBuffer<float>                          m_planes;         // 所有输入声道的平面
+    AlignedBuffer<float>                          m_mixed;          // 所有输出声道的平面
+};
+
+/**
+ * @brief   混音吞吐测试：累加内核对比标量实现，5.1 下混和多路立体声混音的吞吐
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int mixer_benchmark();
+
+/**
+ * @brief   把多个PCM16LE文件按增益矩阵混音，写入 output；较短的输入在结尾后按静音处理
+ * @param   files                   [IN]        输入文件路径
+ * @param   channels                [IN]        每个输入文件的声道数
+ * @param   matrix                  [IN]        增益矩阵
+ * @param   output                  [IN]        输出文件路径
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm16le_mix(const std::vector<std::string>& files, const std::vector<int>& channels, const ChannelMatrix& matrix, const std::string& output);
+
+#endif
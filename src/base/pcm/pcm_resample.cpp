@@ -0,0 +1,167 @@
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/resample.hpp"
+#include "pcm_block.h"
+#include "pcm_format.h"
+#include "pcm_resample.h"
+
+namespace
+{
+    constexpr double kPi = 3.14159265358979323846;
+
+    float dot_c(const float* x, const float* h, int n)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < n; i++)
+        {
+            sum += x[i] * h[i];
+        }
+        return sum;
+    }
+
+    /**
+     * 1 kHz 正弦重采样后与理想输出比较，跳过首尾滤波器长度内的采样
+     */
+    double sine_snr(int inRate, int outRate)
+    {
+        std::vector<float> in(inRate), out(outRate + 64);
+        for (int i = 0; i < inRate; i++)
+        {
+            in[i] = static_cast<float>(0.5 * std::sin(2.0 * kPi * 1000.0 * i / inRate));
+        }
+        Resampler resampler(inRate, outRate, 1);
+        int       count = resampler.ProcessInterleaved(in.data(), inRate, out.data(), static_cast<int>(out.size()));
+        count += resampler.Flush(out.data() + count, static_cast<int>(out.size()) - count);
+
+        double signal = 0.0;
+        double noise  = 0.0;
+        for (int i = 256; i < count - 256; i++)
+        {
+            double reference = 0.5 * std::sin(2.0 * kPi * 1000.0 * i / outRate);
+            signal += reference * reference;
+            noise += (out[i] - reference) * (out[i] - reference);
+        }
+        return 10.0 * std::log10(signal / std::max(noise, 1e-30));
+    }
+} // namespace
+
+int pcm_s16_resample_file(const std::string& input, const std::string& output, int channels, int inRate, int outRate)
+{
+    std::ofstream file(output, std::ios::out | std::ios::binary);
+
+    PcmBlockEngine         engine(channels);
+    Resampler              resampler(inRate, outRate, channels);
+    SampleConverter        toFloat(SAMPLE_FORMAT_S16, SAMPLE_FORMAT_F32, channels);
+    SampleConverter        toS16(SAMPLE_FORMAT_F32, SAMPLE_FORMAT_S16, channels);
+    AlignedBuffer<float>   samples(engine.BlockFrames() * channels);
+    AlignedBuffer<float>   resampled;
+    AlignedBuffer<uint8_t> block;
+    int64_t                written = 0;
+
+    auto write = [&](int frames) {
+        block.Resize(static_cast<size_t>(frames) * engine.FrameBytes());
+        toS16.Convert(reinterpret_cast<const uint8_t*>(resampled.Data()), block.Data(), frames);
+        file.write(reinterpret_cast<const char*>(block.Data()), block.Size());
+        written += frames;
+    };
+
+    int64_t count = engine.Run(input, [&](const uint8_t* data, int frames) {
+        toFloat.Convert(data, reinterpret_cast<uint8_t*>(samples.Data()), frames);
+        int capacity = resampler.MaxOutput(frames);
+        resampled.Resize(static_cast<size_t>(capacity) * channels);
+        write(resampler.ProcessInterleaved(samples.Data(), frames, resampled.Data(), capacity));
+        return true;
+    });
+    if (count < 0)
+    {
+        return -1;
+    }
+    int capacity = resampler.RemainingOutput();
+    resampled.Resize(static_cast<size_t>(capacity) * channels);
+    write(resampler.Flush(resampled.Data(), capacity));
+    SPDLOG_INFO("Sample count: {} -> {}", count, written);
+
+    file.close();
+
+    return 0;
+}
+
+int resample_benchmark()
+{
+    constexpr int kTaps       = 256;
+    constexpr int kCount      = 1 << 16;
+    constexpr int kIterations = 20;
+    int           ret         = 0;
+
+    // FIR 内核：求和顺序不同，按相对误差比较
+    AlignedBuffer<float> x(kCount + kTaps), h(kTaps);
+    for (int i = 0; i < kCount + kTaps; i++)
+    {
+        x[i] = static_cast<float>(std::sin(i * 0.37));
+    }
+    for (int i = 0; i < kTaps; i++)
+    {
+        h[i] = static_cast<float>(std::cos(i * 0.11) / kTaps);
+    }
+    for (int i = 0; i < 1024; i++)
+    {
+        float simd   = resample_dot(x.Data() + i, h.Data(), kTaps - i % 8);
+        float scalar = dot_c(x.Data() + i, h.Data(), kTaps - i % 8);
+        if (std::fabs(simd - scalar) > 1e-5f * (1.0f + std::fabs(scalar)))
+        {
+            SPDLOG_ERROR("Resample FIR: SIMD result mismatch");
+            ret = -1;
+            break;
+        }
+    }
+    volatile float sink  = 0.0f;
+    size_t         bytes = static_cast<size_t>(kCount) * kTaps * sizeof(float);
+
+    auto firScalar = [&] {
+        for (int i = 0; i < kCount; i++)
+        {
+            sink = sink + dot_c(x.Data() + i, h.Data(), kTaps);
+        }
+    };
+    auto firSimd = [&] {
+        for (int i = 0; i < kCount; i++)
+        {
+            sink = sink + resample_dot(x.Data() + i, h.Data(), kTaps);
+        }
+    };
+    double scalar = benchmark_throughput(firScalar, bytes, kIterations);
+    double simd   = benchmark_throughput(firSimd, bytes, kIterations);
+    SPDLOG_INFO("Resample FIR {} taps: {:.2f} -> {:.2f} GB/s", kTaps, scalar, simd);
+
+    // 常见比例，双声道 10 秒，倍实时 = 输入时长 / 处理耗时
+    const int ratios[][2] = {{44100, 48000}, {48000, 44100}, {44100, 44101}, {44100, 22050}};
+    for (const auto& ratio : ratios)
+    {
+        int                  frames = ratio[0] * 10;
+        Resampler            resampler(ratio[0], ratio[1], 2);
+        AlignedBuffer<float> in(frames * 2), out(resampler.MaxOutput(frames) * 2);
+        for (int i = 0; i < frames * 2; i++)
+        {
+            in[i] = static_cast<float>(std::sin(i * 0.01));
+        }
+        double seconds = benchmark_seconds([&] {
+            resampler.Reset();
+            resampler.ProcessInterleaved(in.Data(), frames, out.Data(), resampler.MaxOutput(frames));
+        }, 3);
+        SPDLOG_INFO("Resample {} -> {}: {:.0f}x realtime, 1 kHz SNR {:.1f} dB", ratio[0], ratio[1], 10.0 / seconds, sine_snr(ratio[0], ratio[1]));
+    }
+
+    return ret;
+}
+
+int simplest_pcm16le_resample(const std::string& pcm_16le, int channels, int inRate, int outRate)
+{
+    SPDLOG_INFO("Resample PCM16LE {} -> {}: {}", inRate, outRate, pcm_16le);
+    return pcm_s16_resample_file(pcm_16le, pcm_16le + "." + std::to_string(outRate), channels, inRate, outRate);
+}
@@ -0,0 +1,37 @@
+#ifndef __PCM_RESAMPLE_H__
+#define __PCM_RESAMPLE_H__
+
+#include <string>
+
+/**
+ * @brief   对PCM16LE文件做带限重采样（base/common/resample.hpp 的多相重采样器）
+ * 按块读取，s16 转 float 后流式重采样，结果饱和转回 s16
+ * @param   input                   [IN]        pcm16le 输入文件路径
+ * @param   output                  [IN]        pcm16le 输出文件路径
+ * @param   channels                [IN]        声道数
+ * @param   inRate                  [IN]        输入采样率
+ * @param   outRate                 [IN]        输出采样率
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int pcm_s16_resample_file(const std::string& input, const std::string& output, int channels, int inRate, int outRate);
+
+/**
+ * @brief   重采样测试：FIR 内核对比标量实现，常见比例的吞吐（倍实时）和 1 kHz 正弦的信噪比
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int resample_benchmark();
+
+/**
+ * @brief   将PCM16LE音频采样数据重采样到新的采样率，写入 <filename>.<outRate>
+ * @param   pcm_16le                [IN]        pcm16le 输入文件路径
+ * @param   channels                [IN]        声道数
+ * @param   inRate                  [IN]        输入采样率
+ * @param   outRate                 [IN]        输出采样率
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm16le_resample(const std::string& pcm_16le, int channels, int inRate, int outRate);
+
+#endif
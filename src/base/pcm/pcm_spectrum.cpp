@@ -0,0 +1,456 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <random>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/benchmark.hpp"
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "pcm_block.h"
+#include "pcm_format.h"
+#include "pcm_spectrum.h"
+
+namespace
+{
+    constexpr double kPi      = 3.14159265358979323846;
+    constexpr float  kMinDb   = -200.0f;
+    constexpr double kMinFreq = 20.0;
+
+    /**
+     * 不小于 size 的 2 的幂，至少 16，最大 2^30
+     */
+    int fft_size(int size)
+    {
+        int n = 16;
+        while (n < size && n < (1 << 30))
+        {
+            n <<= 1;
+        }
+        return n;
+    }
+
+    float to_db(double power)
+    {
+        return power > 1e-20 ? static_cast<float>(10.0 * std::log10(power)) : kMinDb;
+    }
+
+    /**
+     * 半长 h 的一级蝶形：x[k + j + h] 乘旋转因子后与 x[k + j] 相加减
+     */
+    void fft_stage(float* re, float* im, const float* wr, const float* wi, int size, int h)
+    {
+        for (int k = 0; k < size; k += 2 * h)
+        {
+            float* ar = re + k;
+            float* ai = im + k;
+            float* br = re + k + h;
+            float* bi = im + k + h;
+            int    j  = 0;
+#if SIMD_SSE2
+            for (; j + 4 <= h; j += 4)
+            {
+                __m128 xr = _mm_loadu_ps(br + j), xi = _mm_loadu_ps(bi + j);
+                __m128 cr = _mm_load_ps(wr + j), ci = _mm_load_ps(wi + j);
+                __m128 tr = _mm_sub_ps(_mm_mul_ps(xr, cr), _mm_mul_ps(xi, ci));
+                __m128 ti = _mm_add_ps(_mm_mul_ps(xr, ci), _mm_mul_ps(xi, cr));
+                __m128 yr = _mm_loadu_ps(ar + j), yi = _mm_loadu_ps(ai + j);
+                _mm_storeu_ps(br + j, _mm_sub_ps(yr, tr));
+                _mm_storeu_ps(bi + j, _mm_sub_ps(yi, ti));
+                _mm_storeu_ps(ar + j, _mm_add_ps(yr, tr));
+                _mm_storeu_ps(ai + j, _mm_add_ps(yi, ti));
+            }
+#elif SIMD_NEON
+            for (; j + 4 <= h; j += 4)
+            {
+                float32x4_t xr = vld1q_f32(br + j), xi = vld1q_f32(bi + j);
+                float32x4_t cr = vld1q_f32(wr + j), ci = vld1q_f32(wi + j);
+                float32x4_t tr = vsubq_f32(vmulq_f32(xr, cr), vmulq_f32(xi, ci));
+                float32x4_t ti = vaddq_f32(vmulq_f32(xr, ci), vmulq_f32(xi, cr));
+                float32x4_t yr = vld1q_f32(ar + j), yi = vld1q_f32(ai + j);
+                vst1q_f32(br + j, vsubq_f32(yr, tr));
+                vst1q_f32(bi + j, vsubq_f32(yi, ti));
+                vst1q_f32(ar + j, vaddq_f32(yr, tr));
+                vst1q_f32(ai + j, vaddq_f32(yi, ti));
+            }
+#endif
+            for (; j < h; j++)
+            {
+                float tr = br[j] * wr[j] - bi[j] * wi[j];
+                float ti = br[j] * wi[j] + bi[j] * wr[j];
+                br[j]    = ar[j] - tr;
+                bi[j]    = ai[j] - ti;
+                ar[j]    = ar[j] + tr;
+                ai[j]    = ai[j] + ti;
+            }
+        }
+    }
+
+    /**
+     * 功率谱 re^2 + im^2
+     */
+    void fft_power(const float* re, const float* im, float* power, int count)
+    {
+        int i = 0;
+#if SIMD_SSE2
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 r = _mm_loadu_ps(re + i), m = _mm_loadu_ps(im + i);
+            _mm_storeu_ps(power + i, _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(m, m)));
+        }
+#elif SIMD_NEON
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t r = vld1q_f32(re + i), m = vld1q_f32(im + i);
+            vst1q_f32(power + i, vaddq_f32(vmulq_f32(r, r), vmulq_f32(m, m)));
+        }
+#endif
+        for (; i < count; i++)
+        {
+            power[i] = re[i] * re[i] + im[i] * im[i];
+        }
+    }
+} // namespace
+
+RealFft::RealFft(int size)
+    : m_size(fft_size(size))
+    , m_half(m_size / 2)
+    , m_bitrev(m_half)
+    , m_twiddle_re(m_half)
+    , m_twiddle_im(m_half)
+    , m_post_re(m_half + 1)
+    , m_post_im(m_half + 1)
+    , m_re(m_half)
+    , m_im(m_half)
+{
+    int bits = 0;
+    while ((1 << bits) < m_half)
+    {
+        bits++;
+    }
+    for (int i = 0; i < m_half; i++)
+    {
+        int r = 0;
+        for (int b = 0; b < bits; b++)
+        {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        m_bitrev[i] = r;
+    }
+    // 半长 h 的级用 e^(-iπj/h)，j < h，放在 [h - 1, 2h - 1)；h >= 4 时起点按 4 对齐（h - 1 + 1 = h）
+    for (int h = 1; h < m_half; h <<= 1)
+    {
+        int base = h < 4 ? h - 1 : h;
+        for (int j = 0; j < h; j++)
+        {
+            m_twiddle_re[base + j] = static_cast<float>(std::cos(kPi * j / h));
+            m_twiddle_im[base + j] = static_cast<float>(-std::sin(kPi * j / h));
+        }
+    }
+    for (int k = 0; k <= m_half; k++)
+    {
+        m_post_re[k] = static_cast<float>(std::cos(2.0 * kPi * k / m_size));
+        m_post_im[k] = static_cast<float>(-std::sin(2.0 * kPi * k / m_size));
+    }
+}
+
+void RealFft::Forward(const float* in, float* re, float* im)
+{
+    float* zr = m_re.Data();
+    float* zi = m_im.Data();
+    for (int n = 0; n < m_half; n++)
+    {
+        zr[m_bitrev[n]] = in[2 * n];
+        zi[m_bitrev[n]] = in[2 * n + 1];
+    }
+    for (int h = 1; h < m_half; h <<= 1)
+    {
+        int base = h < 4 ? h - 1 : h;
+        fft_stage(zr, zi, m_twiddle_re.Data() + base, m_twiddle_im.Data() + base, m_half, h);
+    }
+
+    // X[k] = E[k] + W^k * O[k]，E、O 为偶数、奇数采样的 M 点变换，由 Z[k] 与 conj(Z[M - k]) 得到
+    for (int k = 0; k <= m_half; k++)
+    {
+        int   a   = k == m_half ? 0 : k;
+        int   b   = k == 0 ? 0 : m_half - k;
+        float er  = 0.5f * (zr[a] + zr[b]);
+        float ei  = 0.5f * (zi[a] - zi[b]);
+        float or_ = 0.5f * (zi[a] + zi[b]);
+        float oi  = -0.5f * (zr[a] - zr[b]);
+        re[k]     = er + m_post_re[k] * or_ - m_post_im[k] * oi;
+        im[k]     = ei + m_post_re[k] * oi + m_post_im[k] * or_;
+    }
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(int sampleRate, int fftSize, int hop, int bands)
+    : m_sample_rate(std::max(sampleRate, 1))
+    , m_fft_size(RealFft(fftSize).Size())
+    , m_hop(std::max(hop, 1))
+    , m_window(m_fft_size)
+{
+    double sum = 0.0;
+    for (int i = 0; i < m_fft_size; i++)
+    {
+        m_window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / m_fft_size));
+        sum += m_window[i];
+    }
+    // 满幅正弦的峰值频点幅度为 Σw / 2
+    m_scale = static_cast<float>(4.0 / (sum * sum));
+
+    // 对数频带：边界频点单调递增，每个频带至少一个频点
+    int    half  = m_fft_size / 2;
+    double low   = std::max(kMinFreq, static_cast<double>(m_sample_rate) / m_fft_size);
+    double high  = m_sample_rate / 2.0;
+    int    count = std::clamp(bands, 1, half);
+    m_band_edges.push_back(std::max(1, static_cast<int>(std::lround(low * m_fft_size / m_sample_rate))));
+    for (int b = 1; b <= count; b++)
+    {
+        double freq = low * std::pow(high / low, static_cast<double>(b) / count);
+        int    edge = static_cast<int>(std::lround(freq * m_fft_size / m_sample_rate));
+        edge        = std::max(edge, m_band_edges.back() + 1);
+        m_band_edges.push_back(std::min(edge, half + 1));
+        if (m_band_edges.back() == half + 1)
+        {
+            break;
+        }
+    }
+    m_band_edges.back() = half + 1;
+}
+
+double SpectrumAnalyzer::BandFrequency(int band) const
+{
+    return static_cast<double>(m_band_edges[std::clamp(band, 0, Bands())]) * m_sample_rate / m_fft_size;
+}
+
+int SpectrumAnalyzer::Analyze(const float* mono, int64_t count, int64_t position, bool flush, std::vector<SpectrumFrame>& frames, std::vector<float>& bands) const
+{
+    int64_t total = 0;
+    if (flush)
+    {
+        total = (count + m_hop - 1) / m_hop;
+    }
+    else if (count >= m_fft_size)
+    {
+        total = (count - m_fft_size) / m_hop + 1;
+    }
+    if (total <= 0)
+    {
+        return 0;
+    }
+    int    bandCount = Bands();
+    size_t first     = frames.size();
+    frames.resize(first + total);
+    bands.resize((first + total) * bandCount);
+
+    // 每个线程处理连续的一段帧，各自持有 FFT 和缓冲区
+    parallel_for_rows(static_cast<int>(total), [&](int begin, int end) {
+        int                  half = m_fft_size / 2;
+        RealFft              fft(m_fft_size);
+        AlignedBuffer<float> buffer(m_fft_size), re(half + 1), im(half + 1), power(half + 1);
+        for (int f = begin; f < end; f++)
+        {
+            int64_t start = static_cast<int64_t>(f) * m_hop;
+            int     valid = static_cast<int>(std::clamp<int64_t>(count - start, 0, m_fft_size));
+            double  sum   = 0.0;
+            for (int i = 0; i < valid; i++)
+            {
+                float x   = mono[start + i];
+                sum += static_cast<double>(x) * x;
+                buffer[i] = x * m_window[i];
+            }
+            std::fill(buffer.Data() + valid, buffer.Data() + m_fft_size, 0.0f);
+            fft.Forward(buffer.Data(), re.Data(), im.Data());
+            fft_power(re.Data(), im.Data(), power.Data(), half + 1);
+
+            // 最强频点（不含直流），在 dB 域做抛物线插值
+            int peak = static_cast<int>(std::max_element(power.Data() + 1, power.Data() + half) - power.Data());
+            float a  = to_db(power[peak - 1]), b = to_db(power[peak]), c = to_db(power[peak + 1]);
+            float d  = a - 2.0f * b + c;
+            float delta = d < 0.0f ? 0.5f * (a - c) / d : 0.0f;
+
+            SpectrumFrame& frame = frames[first + f];
+            frame.position       = position + start;
+            frame.energy_db      = to_db(sum / m_fft_size);
+            frame.peak_hz        = static_cast<float>((peak + delta) * m_sample_rate / m_fft_size);
+            frame.peak_db        = b - 0.25f * (a - c) * delta + to_db(m_scale);
+
+            float* row = bands.data() + (first + f) * bandCount;
+            for (int k = 0; k < bandCount; k++)
+            {
+                double energy = 0.0;
+                for (int i = m_band_edges[k]; i < m_band_edges[k + 1]; i++)
+                {
+                    energy += power[i];
+                }
+                row[k] = to_db(energy * m_scale);
+            }
+        }
+    }, 64);
+    return static_cast<int>(total);
+}
+
+int spectrum_benchmark()
+{
+    int ret = 0;
+
+    // FFT 对比双精度 DFT
+    {
+        constexpr int        kSize = 256;
+        std::mt19937         rng(7);
+        AlignedBuffer<float> in(kSize), re(kSize / 2 + 1), im(kSize / 2 + 1);
+        for (int i = 0; i < kSize; i++)
+        {
+            in[i] = static_cast<float>(rng() % 2001) / 1000.0f - 1.0f;
+        }
+        RealFft fft(kSize);
+        fft.Forward(in.Data(), re.Data(), im.Data());
+        double error = 0.0;
+        for (int k = 0; k <= kSize / 2; k++)
+        {
+            std::complex<double> sum = 0.0;
+            for (int n = 0; n < kSize; n++)
+            {
+                sum += static_cast<double>(in[n]) * std::polar(1.0, -2.0 * kPi * k * n / kSize);
+            }
+            error = std::max(error, std::abs(sum - std::complex<double>(re[k], im[k])));
+        }
+        if (error > 1e-3)
+        {
+            SPDLOG_ERROR("FFT {}: max error {} against DFT", kSize, error);
+            ret = -1;
+        }
+        SPDLOG_INFO("FFT {}: max error {:.2e} against DFT", kSize, error);
+    }
+
+    // 1 kHz、幅度 0.5 的正弦：峰值 1000 Hz、-6 dB
+    constexpr int kSampleRate = 44100;
+    {
+        AlignedBuffer<float> in(kSampleRate);
+        for (int i = 0; i < kSampleRate; i++)
+        {
+            in[i] = static_cast<float>(0.5 * std::sin(2.0 * kPi * 1000.0 * i / kSampleRate));
+        }
+        SpectrumAnalyzer           analyzer(kSampleRate);
+        std::vector<SpectrumFrame> frames;
+        std::vector<float>         bands;
+        analyzer.Analyze(in.Data(), kSampleRate, 0, false, frames, bands);
+        const SpectrumFrame& frame = frames[frames.size() / 2];
+        if (std::fabs(frame.peak_hz - 1000.0f) > 2.0f || std::fabs(frame.peak_db + 6.02f) > 1.0f)
+        {
+            SPDLOG_ERROR("Spectrum 1 kHz sine: peak {:.1f} Hz, {:.2f} dB", frame.peak_hz, frame.peak_db);
+            ret = -1;
+        }
+        SPDLOG_INFO("Spectrum 1 kHz sine: peak {:.1f} Hz, {:.2f} dB, RMS {:.2f} dBFS", frame.peak_hz, frame.peak_db, frame.energy_db);
+    }
+
+    // 2048 点 FFT 速度；10 分钟单声道的整段分析（倍实时）
+    {
+        RealFft              fft(2048);
+        AlignedBuffer<float> in(2048), re(1025), im(1025);
+        for (int i = 0; i < 2048; i++)
+        {
+            in[i] = static_cast<float>(std::sin(i * 0.1));
+        }
+        double seconds = benchmark_seconds([&] { fft.Forward(in.Data(), re.Data(), im.Data()); }, 20000);
+        SPDLOG_INFO("FFT 2048: {:.2f} us per transform", seconds * 1e6);
+    }
+    {
+        int64_t            count = static_cast<int64_t>(kSampleRate) * 600;
+        std::vector<float> in(count);
+        for (int64_t i = 0; i < count; i++)
+        {
+            in[i] = static_cast<float>(0.3 * std::sin(i * 0.05) + 0.1 * std::sin(i * 0.71));
+        }
+        SpectrumAnalyzer           analyzer(kSampleRate);
+        std::vector<SpectrumFrame> frames;
+        std::vector<float>         bands;
+        double                     seconds = benchmark_seconds([&] {
+            frames.clear();
+            bands.clear();
+            analyzer.Analyze(in.data(), count, 0, true, frames, bands);
+        }, 1);
+        SPDLOG_INFO("Spectrum 10 min mono: {} frames, {:.0f}x realtime on {} threads", frames.size(), 600.0 / seconds, parallel_thread_count());
+    }
+
+    return ret;
+}
+
+int simplest_pcm16le_spectrum(const std::string& pcm_16le, int channels, int sample_rate)
+{
+    SPDLOG_INFO("Spectrum of PCM16LE: {}", pcm_16le);
+    std::ofstream file(pcm_16le + ".spectrum", std::ios::out | std::ios::binary);
+
+    // 约 1M 采样为一段交给多线程分析，段之间保留不足一帧的尾部
+    constexpr int              kSegment = 1 << 20;
+    PcmBlockEngine             engine(channels);
+    SpectrumAnalyzer           analyzer(sample_rate);
+    SampleConverter            toFloat(SAMPLE_FORMAT_S16, SAMPLE_FORMAT_F32, channels);
+    AlignedBuffer<float>       samples(engine.BlockFrames() * channels);
+    std::vector<float>         mono;
+    std::vector<SpectrumFrame> frames;
+    std::vector<float>         bands;
+    int64_t                    position = 0;
+    int64_t                    silent   = 0;
+    std::vector<float>         peaks;
+
+    auto analyze = [&](bool flush) {
+        frames.clear();
+        bands.clear();
+        int count = analyzer.Analyze(mono.data(), static_cast<int64_t>(mono.size()), position, flush, frames, bands);
+        file.write(reinterpret_cast<const char*>(bands.data()), bands.size() * sizeof(float));
+        for (const auto& frame : frames)
+        {
+            if (frame.energy_db < -60.0f)
+            {
+                silent++;
+            }
+            else
+            {
+                peaks.push_back(frame.peak_hz);
+            }
+        }
+        int64_t consumed = std::min<int64_t>(static_cast<int64_t>(count) * analyzer.Hop(), mono.size());
+        mono.erase(mono.begin(), mono.begin() + consumed);
+        position += consumed;
+        return count;
+    };
+
+    int64_t total = 0;
+    int64_t count = engine.Run(pcm_16le, [&](const uint8_t* data, int n) {
+        toFloat.Convert(data, reinterpret_cast<uint8_t*>(samples.Data()), n);
+        for (int i = 0; i < n; i++)
+        {
+            float sum = 0.0f;
+            for (int c = 0; c < channels; c++)
+            {
+                sum += samples[i * channels + c];
+            }
+            mono.push_back(sum / channels);
+        }
+        if (mono.size() >= kSegment)
+        {
+            total += analyze(false);
+        }
+        return true;
+    });
+    if (count < 0)
+    {
+        return -1;
+    }
+    total += analyze(true);
+
+    float median = 0.0f;
+    if (!peaks.empty())
+    {
+        std::nth_element(peaks.begin(), peaks.begin() + peaks.size() / 2, peaks.end());
+        median = peaks[peaks.size() / 2];
+    }
+    SPDLOG_INFO("Spectrum: {} frames x {} bands, {} silent frames, median peak {:.1f} Hz", total, analyzer.Bands(), silent, median);
+
+    file.close();
+
+    return 0;
+}
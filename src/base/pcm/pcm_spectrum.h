@@ -0,0 +1,140 @@
+#ifndef __PCM_SPECTRUM_H__
+#define __PCM_SPECTRUM_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/common/aligned_buffer.hpp"
+
+/**
+ * @brief   实数 FFT（长度为 2 的幂，至少 16；其他长度向上取整到 2 的幂，Size() 为实际长度）
+ * 1. N 点实数序列按奇偶打包为 N/2 点复数序列，做基 2 DIT 复数 FFT 后用一次后处理拆出 N/2 + 1 个频点
+ * 2. 实部、虚部分开存放（SoA），每一级的旋转因子在构造时按级连续存放，
+ *    半长不小于 4 的级 4 个蝶形一组用 SSE2/NEON 计算，前两级走标量
+ * 3. 内部有工作缓冲区，一个实例只能在一个线程中使用；多线程时每个线程各建一个
+ */
+class RealFft
+{
+public:
+    /**
+     * @param   size                    [IN]        变换长度，不是 2 的幂时向上取整
+     */
+    explicit RealFft(int size);
+    ~RealFft() = default;
+
+    int Size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief   正变换（不归一化）
+     * @param   in                      [IN]        输入，Size() 个采样
+     * @param   re                      [OUT]       实部，Size() / 2 + 1 个
+     * @param   im                      [OUT]       虚部，Size() / 2 + 1 个
+     */
+    void Forward(const float* in, float* re, float* im);
+
+private:
+    int                  m_size;       // 实数长度 N
+    int                  m_half;       // 复数长度 M = N / 2
+    std::vector<int>     m_bitrev;     // M 点位反转序
+    AlignedBuffer<float> m_twiddle_re; // 各级旋转因子，半长 h 的级从 h - 1 开始，共 M - 1 个
+    AlignedBuffer<float> m_twiddle_im;
+    AlignedBuffer<float> m_post_re;    // 后处理旋转因子 e^(-2πik/N)，M + 1 个
+    AlignedBuffer<float> m_post_im;
+    AlignedBuffer<float> m_re;         // 复数 FFT 工作区
+    AlignedBuffer<float> m_im;
+};
+
+// 一个分析帧的概要
+typedef struct SpectrumFrame
+{
+    int64_t position;  // 帧起始采样在流中的位置
+    float   energy_db; // 帧内 RMS（不加窗），dBFS，可用于静音判断
+    float   peak_hz;   // 最强频点的频率（抛物线插值）
+    float   peak_db;   // 最强频点的幅度，满幅正弦为 0 dB
+} SpectrumFrame;
+
+/**
+ * @brief   STFT 频谱分析：Hann 窗、帧长 fftSize、跳距 hop，每帧输出概要和按对数频率划分的频带能量
+ * 1. 频带从 20 Hz 到奈奎斯特频率按对数等分，每个频带至少一个频点，能量以满幅正弦为 0 dB，
+ *    频带数通常取 32 ~ 128，一小时的频谱图只有几十 MB，可以直接给分析界面绘制
+ * 2. 帧之间相互独立，Analyze 按时间把帧切成连续的几段，由 parallel_for_rows 分到多个线程，
+ *    每个线程各用一个 RealFft；结果按帧顺序写入，与单线程结果一致
+ * 3. 流式使用：flush 为 false 时只分析完整的帧，返回的帧数 * hop 即可以丢弃的输入采样数，
+ *    剩余采样与下一段拼接；最后一段 flush 为 true，末尾不足一帧补零
+ */
+class SpectrumAnalyzer
+{
+public:
+    /**
+     * @param   sampleRate              [IN]        采样率
+     * @param   fftSize                 [IN]        帧长，不是 2 的幂时向上取整（与 RealFft 相同），FftSize() 为实际帧长
+     * @param   hop                     [IN]        跳距（采样）
+     * @param   bands                   [IN]        频带数
+     */
+    SpectrumAnalyzer(int sampleRate, int fftSize = 2048, int hop = 512, int bands = 64);
+    ~SpectrumAnalyzer() = default;
+
+    int FftSize() const
+    {
+        return m_fft_size;
+    }
+
+    int Hop() const
+    {
+        return m_hop;
+    }
+
+    int Bands() const
+    {
+        return static_cast<int>(m_band_edges.size()) - 1;
+    }
+
+    /**
+     * @brief   第 band 个频带的下边界频率（Hz）
+     */
+    double BandFrequency(int band) const;
+
+    /**
+     * @brief   分析单声道数据，结果追加到 frames 和 bands（每帧 Bands() 个 dB 值）
+     * @param   mono                    [IN]        单声道 float
+     * @param   count                   [IN]        采样数
+     * @param   position                [IN]        mono[0] 在流中的位置
+     * @param   flush                   [IN]        是否为最后一段
+     * @param   frames                  [OUT]       每帧概要
+     * @param   bands                   [OUT]       频带能量
+     * @return  本次分析的帧数
+     */
+    int Analyze(const float* mono, int64_t count, int64_t position, bool flush, std::vector<SpectrumFrame>& frames, std::vector<float>& bands) const;
+
+private:
+    int                  m_sample_rate; // 采样率
+    int                  m_fft_size;    // 帧长
+    int                  m_hop;         // 跳距
+    float                m_scale;       // 功率谱换算为满幅正弦 0 dB 的系数
+    AlignedBuffer<float> m_window;      // Hann 窗
+    std::vector<int>     m_band_edges;  // 频带边界（频点序号），Bands() + 1 个
+};
+
+/**
+ * @brief   频谱分析测试：FFT 对比双精度 DFT、正弦的峰值频率与幅度，以及 FFT 和整段分析的速度
+ * @return  0                                   成功
+ *          其他                                结果超出容差
+ */
+int spectrum_benchmark();
+
+/**
+ * @brief   分析PCM16LE音频采样数据的频谱：声道平均为单声道，按段多线程 STFT，
+ *          频带能量按帧写入 <pcm_16le>.spectrum（float，每帧 64 个），并统计静音帧和主频
+ * @param   pcm_16le                [IN]        pcm16le 输入文件路径
+ * @param   channels                [IN]        声道数
+ * @param   sample_rate             [IN]        采样率
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm16le_spectrum(const std::string& pcm_16le, int channels, int sample_rate);
+
+#endif
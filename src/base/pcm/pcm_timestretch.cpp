@@ -0,0 +1,103 @@
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/timestretch.hpp"
+#include "pcm_block.h"
+#include "pcm_format.h"
+#include "pcm_timestretch.h"
+
+int timestretch_benchmark()
+{
+    constexpr int kSampleRate = 44100;
+    constexpr int kFrames     = kSampleRate * 10;
+    int           ret         = 0;
+
+    // 双声道 10 秒的和弦
+    AlignedBuffer<float> in(kFrames * 2);
+    for (int i = 0; i < kFrames; i++)
+    {
+        double t      = static_cast<double>(i) / kSampleRate;
+        in[2 * i]     = static_cast<float>(0.3 * std::sin(2.0 * 3.14159265358979 * 440.0 * t) + 0.2 * std::sin(2.0 * 3.14159265358979 * 659.3 * t));
+        in[2 * i + 1] = in[2 * i] * 0.8f;
+    }
+
+    const double speeds[] = {0.5, 1.0, 1.5, 2.0, 4.0};
+    for (double speed : speeds)
+    {
+        TimeStretcher stretcher(kSampleRate, 2);
+        stretcher.SetSpeed(speed);
+
+        // 输出容量在设置倍速之后计算
+        AlignedBuffer<float> out((stretcher.MaxOutput(kFrames) + kSampleRate) * 2);
+        int                  count = 0;
+
+        double seconds = benchmark_seconds([&] {
+            stretcher.Reset();
+            count = stretcher.Process(in.Data(), kFrames, out.Data(), stretcher.MaxOutput(kFrames));
+            count += stretcher.Flush(out.Data() + count * 2, kSampleRate);
+        }, 3);
+        int expect = static_cast<int>(std::lround(kFrames / speed));
+        if (count != expect)
+        {
+            SPDLOG_ERROR("Time stretch x{}: {} frames, expect {}", speed, count, expect);
+            ret = -1;
+        }
+        SPDLOG_INFO("Time stretch x{}: {:.0f}x realtime (output)", speed, count / static_cast<double>(kSampleRate) / seconds);
+    }
+
+    return ret;
+}
+
+int simplest_pcm16le_timestretch(const std::string& pcm_16le, int channels, int sample_rate, double speed)
+{
+    SPDLOG_INFO("Time stretch PCM16LE x{}: {}", speed, pcm_16le);
+    std::ostringstream name;
+    name << pcm_16le << ".x" << speed;
+    std::ofstream file(name.str(), std::ios::out | std::ios::binary);
+
+    PcmBlockEngine         engine(channels);
+    TimeStretcher          stretcher(sample_rate, channels);
+    SampleConverter        toFloat(SAMPLE_FORMAT_S16, SAMPLE_FORMAT_F32, channels);
+    SampleConverter        toS16(SAMPLE_FORMAT_F32, SAMPLE_FORMAT_S16, channels);
+    AlignedBuffer<float>   samples(engine.BlockFrames() * channels);
+    AlignedBuffer<float>   stretched;
+    AlignedBuffer<uint8_t> block;
+    int64_t                written = 0;
+    stretcher.SetSpeed(speed);
+
+    auto write = [&](int frames) {
+        block.Resize(static_cast<size_t>(frames) * engine.FrameBytes());
+        toS16.Convert(reinterpret_cast<const uint8_t*>(stretched.Data()), block.Data(), frames);
+        file.write(reinterpret_cast<const char*>(block.Data()), block.Size());
+        written += frames;
+    };
+
+    int64_t count = engine.Run(pcm_16le, [&](const uint8_t* data, int frames) {
+        toFloat.Convert(data, reinterpret_cast<uint8_t*>(samples.Data()), frames);
+        int capacity = stretcher.MaxOutput(frames);
+        stretched.Resize(static_cast<size_t>(capacity) * channels);
+        write(stretcher.Process(samples.Data(), frames, stretched.Data(), capacity));
+        return true;
+    });
+    if (count < 0)
+    {
+        return -1;
+    }
+    // 尾部补零输出，每次最多一帧长
+    int capacity = stretcher.FrameLength() * 4;
+    stretched.Resize(static_cast<size_t>(capacity) * channels);
+    for (int n = stretcher.Flush(stretched.Data(), capacity); n > 0; n = stretcher.Flush(stretched.Data(), capacity))
+    {
+        write(n);
+    }
+    SPDLOG_INFO("Sample count: {} -> {}", count, written);
+
+    file.close();
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef __PCM_TIMESTRETCH_H__
+#define __PCM_TIMESTRETCH_H__
+
+#include <string>
+
+/**
+ * @brief   变速不变调测试：各倍速的处理速度（按输出时长计的倍实时），验证计算量与倍速无关
+ * @return  0                                   成功
+ *          其他                                输出帧数与倍速不符
+ */
+int timestretch_benchmark();
+
+/**
+ * @brief   将PCM16LE音频采样数据变速不变调（WSOLA，base/common/timestretch.hpp），写入 <filename>.x<speed>
+ * @param   pcm_16le                [IN]        pcm16le 输入文件路径
+ * @param   channels                [IN]        声道数
+ * @param   sample_rate             [IN]        采样率
+ * @param   speed                   [IN]        倍速，[0.5, 4]
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_pcm16le_timestretch(const std::string& pcm_16le, int channels, int sample_rate, double speed);
+
+#endif
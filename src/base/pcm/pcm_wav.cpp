@@ -0,0 +1,613 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "pcm_wav.h"
+
+namespace
+{
+    constexpr uint32_t kSize32Max        = 0xFFFFFFFFu;
+    constexpr uint16_t kFormatPcm        = 1;
+    constexpr uint16_t kFormatFloat      = 3;
+    constexpr uint16_t kFormatExtensible = 0xFFFE;
+    constexpr uint32_t kDs64Bytes        = 28;
+
+    // KSDATAFORMAT_SUBTYPE_xxx 中格式标签之后的 14 字节
+    const uint8_t kSubformatTail[14] = {0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71};
+
+    // 1 ~ 8 声道的默认声道掩码（与 FFmpeg 默认布局一致）
+    const uint32_t kChannelMasks[8] = {0x4, 0x3, 0x7, 0x33, 0x37, 0x3F, 0x13F, 0x63F};
+
+    int file_seek(std::FILE* file, int64_t offset)
+    {
+#ifdef _WIN32
+        return _fseeki64(file, offset, SEEK_SET);
+#else
+        return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+    }
+
+    int64_t file_size(std::FILE* file)
+    {
+#ifdef _WIN32
+        _fseeki64(file, 0, SEEK_END);
+        return _ftelli64(file);
+#else
+        fseeko(file, 0, SEEK_END);
+        return static_cast<int64_t>(ftello(file));
+#endif
+    }
+
+    /**
+     * 设置文件长度：grow 时预分配磁盘空间，否则截断
+     */
+    int file_resize(std::FILE* file, int64_t size, bool grow)
+    {
+        fflush(file);
+#ifdef _WIN32
+        (void)grow;
+        return _chsize_s(_fileno(file), size) == 0 ? 0 : -1;
+#else
+        if (grow)
+        {
+            return posix_fallocate(fileno(file), 0, static_cast<off_t>(size)) == 0 ? 0 : -1;
+        }
+        return ftruncate(fileno(file), static_cast<off_t>(size));
+#endif
+    }
+
+    uint16_t load_u16(const uint8_t* p)
+    {
+        return static_cast<uint16_t>(p[0] | p[1] << 8);
+    }
+
+    uint32_t load_u32(const uint8_t* p)
+    {
+        return static_cast<uint32_t>(load_u16(p)) | static_cast<uint32_t>(load_u16(p + 2)) << 16;
+    }
+
+    uint64_t load_u64(const uint8_t* p)
+    {
+        return static_cast<uint64_t>(load_u32(p)) | static_cast<uint64_t>(load_u32(p + 4)) << 32;
+    }
+
+    void append(std::vector<uint8_t>& buffer, const void* data, size_t bytes)
+    {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        buffer.insert(buffer.end(), p, p + bytes);
+    }
+
+    void append_u16(std::vector<uint8_t>& buffer, uint16_t value)
+    {
+        buffer.push_back(static_cast<uint8_t>(value));
+        buffer.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void append_u32(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        append_u16(buffer, static_cast<uint16_t>(value));
+        append_u16(buffer, static_cast<uint16_t>(value >> 16));
+    }
+
+    void append_u64(std::vector<uint8_t>& buffer, uint64_t value)
+    {
+        append_u32(buffer, static_cast<uint32_t>(value));
+        append_u32(buffer, static_cast<uint32_t>(value >> 32));
+    }
+
+    uint32_t clamp_u32(int64_t value)
+    {
+        return static_cast<uint32_t>(std::min<int64_t>(value, kSize32Max));
+    }
+} // namespace
+
+WavReader::~WavReader()
+{
+    Close();
+}
+
+int WavReader::Open(const std::string& filename)
+{
+    Close();
+    m_file = std::fopen(filename.c_str(), "rb");
+    if (!m_file)
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+    int64_t fileSize = file_size(m_file);
+
+    auto fail = [&](const char* reason) {
+        SPDLOG_ERROR("{}: {}", reason, filename);
+        Close();
+        return -1;
+    };
+
+    uint8_t riff[12];
+    file_seek(m_file, 0);
+    if (std::fread(riff, 1, sizeof(riff), m_file) != sizeof(riff) || memcmp(riff + 8, "WAVE", 4) != 0)
+    {
+        return fail("Not a WAV file");
+    }
+    m_rf64 = memcmp(riff, "RF64", 4) == 0 || memcmp(riff, "BW64", 4) == 0;
+    if (!m_rf64 && memcmp(riff, "RIFF", 4) != 0)
+    {
+        return fail("Not a WAV file");
+    }
+
+    // ds64：data 的 64 位大小及其他块的大小表
+    int64_t               ds64Data = -1;
+    std::vector<WavChunk> ds64Table;
+    bool                  hasFormat = false;
+    bool                  hasData   = false;
+    int64_t               pos       = 12;
+    while (pos + 8 <= fileSize)
+    {
+        uint8_t head[8];
+        file_seek(m_file, pos);
+        if (std::fread(head, 1, sizeof(head), m_file) != sizeof(head))
+        {
+            break;
+        }
+        WavChunk chunk;
+        memcpy(chunk.id, head, 4);
+        chunk.offset = pos + 8;
+        chunk.size   = load_u32(head + 4);
+
+        if (m_rf64 && chunk.size == kSize32Max)
+        {
+            if (memcmp(chunk.id, "data", 4) == 0)
+            {
+                chunk.size = ds64Data;
+            }
+            for (const auto& entry : ds64Table)
+            {
+                if (memcmp(entry.id, chunk.id, 4) == 0)
+                {
+                    chunk.size = entry.size;
+                    break;
+                }
+            }
+        }
+        // 大小缺失或超出文件（头部未回写）时截到文件结尾
+        if (chunk.size < 0 || chunk.offset + chunk.size > fileSize || (memcmp(chunk.id, "data", 4) == 0 && chunk.size == 0))
+        {
+            chunk.size = fileSize - chunk.offset;
+        }
+        m_chunks.push_back(chunk);
+
+        if (memcmp(chunk.id, "ds64", 4) == 0 || memcmp(chunk.id, "fmt ", 4) == 0)
+        {
+            std::vector<uint8_t> body;
+            ReadChunk(chunk.id, body);
+            if (chunk.id[0] == 'd' && body.size() >= kDs64Bytes)
+            {
+                ds64Data       = static_cast<int64_t>(load_u64(body.data() + 8));
+                uint32_t count = load_u32(body.data() + 24);
+                for (uint32_t i = 0; i < count && kDs64Bytes + (i + 1) * 12 <= body.size(); i++)
+                {
+                    WavChunk entry;
+                    memcpy(entry.id, body.data() + kDs64Bytes + i * 12, 4);
+                    entry.offset = 0;
+                    entry.size   = static_cast<int64_t>(load_u64(body.data() + kDs64Bytes + i * 12 + 4));
+                    ds64Table.push_back(entry);
+                }
+            }
+            else if (chunk.id[0] == 'f')
+            {
+                if (ParseFormat(body) != 0)
+                {
+                    return fail("Unsupported WAV format");
+                }
+                hasFormat = true;
+            }
+        }
+        else if (memcmp(chunk.id, "data", 4) == 0 && !hasData)
+        {
+            m_data_offset = chunk.offset;
+            m_data_bytes  = chunk.size;
+            hasData       = true;
+        }
+        pos = chunk.offset + chunk.size + (chunk.size & 1);
+    }
+    if (!hasFormat || !hasData)
+    {
+        return fail("Missing fmt or data chunk");
+    }
+
+    m_data_bytes       = m_data_bytes / m_header.block_align * m_header.block_align;
+    m_header.data_size = clamp_u32(m_data_bytes);
+    m_header.file_size = clamp_u32(fileSize - 8);
+    m_position         = 0;
+    return 0;
+}
+
+int WavReader::ParseFormat(const std::vector<uint8_t>& fmt)
+{
+    if (fmt.size() < 16)
+    {
+        return -1;
+    }
+    memcpy(m_header.riff, m_rf64 ? "RF64" : "RIFF", 4);
+    memcpy(m_header.wave, "WAVE", 4);
+    memcpy(m_header.fmt, "fmt ", 4);
+    memcpy(m_header.data, "data", 4);
+    m_header.fmt_size        = static_cast<uint32_t>(fmt.size());
+    m_header.audio_format    = load_u16(fmt.data());
+    m_header.num_channels    = load_u16(fmt.data() + 2);
+    m_header.sample_rate     = load_u32(fmt.data() + 4);
+    m_header.byte_rate       = load_u32(fmt.data() + 8);
+    m_header.block_align     = load_u16(fmt.data() + 12);
+    m_header.bits_per_sample = load_u16(fmt.data() + 14);
+
+    uint16_t tag = m_header.audio_format;
+    if (tag == kFormatExtensible && fmt.size() >= 40)
+    {
+        tag = load_u16(fmt.data() + 24);
+    }
+    int bytes = m_header.bits_per_sample / 8;
+    if (tag == kFormatPcm && bytes >= 1 && bytes <= 4 && m_header.bits_per_sample % 8 == 0)
+    {
+        const SampleFormat formats[4] = {SAMPLE_FORMAT_U8, SAMPLE_FORMAT_S16, SAMPLE_FORMAT_S24, SAMPLE_FORMAT_S32};
+        m_format                      = formats[bytes - 1];
+    }
+    else if (tag == kFormatFloat && m_header.bits_per_sample == 32)
+    {
+        m_format = SAMPLE_FORMAT_F32;
+    }
+    else
+    {
+        SPDLOG_ERROR("WAV format tag {} with {} bits is not supported", tag, m_header.bits_per_sample);
+        return -1;
+    }
+    if (m_header.num_channels == 0 || m_header.block_align != m_header.num_channels * bytes)
+    {
+        SPDLOG_ERROR("WAV block align {} does not match {} channels", m_header.block_align, m_header.num_channels);
+        return -1;
+    }
+    return 0;
+}
+
+void WavReader::Close()
+{
+    if (m_map)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_map);
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+#else
+        munmap(m_map, static_cast<size_t>(m_map_bytes));
+#endif
+        m_map       = nullptr;
+        m_map_bytes = 0;
+    }
+    if (m_file)
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_header      = {};
+    m_rf64        = false;
+    m_data_offset = 0;
+    m_data_bytes  = 0;
+    m_position    = 0;
+    m_chunks.clear();
+}
+
+bool WavReader::Bext(WavBext& bext)
+{
+    std::vector<uint8_t> data;
+    if (!ReadChunk("bext", data))
+    {
+        return false;
+    }
+    memset(&bext, 0, sizeof(bext));
+    memcpy(&bext, data.data(), std::min(data.size(), sizeof(bext)));
+    return true;
+}
+
+bool WavReader::ReadChunk(const char* id, std::vector<uint8_t>& data)
+{
+    for (const auto& chunk : m_chunks)
+    {
+        if (memcmp(chunk.id, id, 4) != 0)
+        {
+            continue;
+        }
+        data.resize(static_cast<size_t>(chunk.size));
+        file_seek(m_file, chunk.offset);
+        data.resize(std::fread(data.data(), 1, data.size(), m_file));
+        return true;
+    }
+    return false;
+}
+
+const uint8_t* WavReader::Map()
+{
+    if (m_map)
+    {
+        return m_map + m_data_offset;
+    }
+    int64_t length = m_data_offset + m_data_bytes;
+    if (!m_file || m_data_bytes == 0 || static_cast<uint64_t>(length) > SIZE_MAX)
+    {
+        return nullptr;
+    }
+#ifdef _WIN32
+    HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file)));
+    m_mapping   = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+    {
+        return nullptr;
+    }
+    void* base = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(length));
+    if (!base)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        return nullptr;
+    }
+#else
+    void* base = mmap(nullptr, static_cast<size_t>(length), PROT_READ, MAP_PRIVATE, fileno(m_file), 0);
+    if (base == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    madvise(base, static_cast<size_t>(length), MADV_SEQUENTIAL);
+#endif
+    m_map       = static_cast<uint8_t*>(base);
+    m_map_bytes = length;
+    return m_map + m_data_offset;
+}
+
+int WavReader::Seek(int64_t frame)
+{
+    if (frame < 0 || frame > Frames())
+    {
+        return -1;
+    }
+    m_position = frame * m_header.block_align;
+    return 0;
+}
+
+int WavReader::Read(uint8_t* data, int frames)
+{
+    if (!m_file)
+    {
+        return 0;
+    }
+    int64_t bytes = std::min<int64_t>(static_cast<int64_t>(frames) * m_header.block_align, m_data_bytes - m_position);
+    if (bytes <= 0)
+    {
+        return 0;
+    }
+    file_seek(m_file, m_data_offset + m_position);
+    size_t got = std::fread(data, 1, static_cast<size_t>(bytes), m_file) / m_header.block_align * m_header.block_align;
+    m_position += static_cast<int64_t>(got);
+    return static_cast<int>(got / m_header.block_align);
+}
+
+WavWriter::~WavWriter()
+{
+    Close();
+}
+
+int WavWriter::Open(const std::string& filename, SampleFormat format, int channels, int sampleRate, int64_t expectedFrames, const WavBext* bext, bool forceRF64)
+{
+    Close();
+
+    // 声道数和块对齐写入 16 位字段、字节率写入 32 位字段，声道掩码按声道数查表
+    int bytes = sample_format_bytes(format);
+    if (channels < 1 || sampleRate <= 0 || channels * bytes > UINT16_MAX ||
+        static_cast<int64_t>(sampleRate) * channels * bytes > UINT32_MAX)
+    {
+        SPDLOG_ERROR("Invalid WAV parameters: {} channels, {} Hz", channels, sampleRate);
+        return -1;
+    }
+
+    m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file)
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    m_extensible = channels > 2 || bytes > 2;
+    memcpy(m_header.riff, "RIFF", 4);
+    memcpy(m_header.wave, "WAVE", 4);
+    memcpy(m_header.fmt, "fmt ", 4);
+    memcpy(m_header.data, "data", 4);
+    m_header.fmt_size        = m_extensible ? 40 : 16;
+    m_header.audio_format    = format == SAMPLE_FORMAT_F32 ? kFormatFloat : kFormatPcm;
+    m_header.num_channels    = static_cast<uint16_t>(channels);
+    m_header.sample_rate     = static_cast<uint32_t>(sampleRate);
+    m_header.bits_per_sample = static_cast<uint16_t>(bytes * 8);
+    m_header.block_align     = static_cast<uint16_t>(channels * bytes);
+    m_header.byte_rate       = static_cast<uint32_t>(sampleRate) * m_header.block_align;
+    m_force_rf64             = forceRF64;
+    m_data_bytes             = 0;
+    m_bext.clear();
+    if (bext)
+    {
+        append(m_bext, bext, sizeof(WavBext));
+    }
+
+    std::vector<uint8_t> header = BuildHeader(false);
+    m_header_bytes              = static_cast<int64_t>(header.size());
+    if (std::fwrite(header.data(), 1, header.size(), m_file) != header.size())
+    {
+        SPDLOG_ERROR("Failed to write file: {}", filename);
+        return -1;
+    }
+
+    // 预分配失败（文件系统不支持等）不影响写入
+    m_allocated = 0;
+    if (expectedFrames > 0)
+    {
+        int64_t size = m_header_bytes + expectedFrames * m_header.block_align + 1;
+        if (file_resize(m_file, size, true) == 0)
+        {
+            m_allocated = size;
+        }
+    }
+    return 0;
+}
+
+int WavWriter::Write(const uint8_t* data, int frames)
+{
+    if (!m_file)
+    {
+        return -1;
+    }
+    size_t bytes = static_cast<size_t>(frames) * m_header.block_align;
+    if (std::fwrite(data, 1, bytes, m_file) != bytes)
+    {
+        SPDLOG_ERROR("Failed to write WAV data");
+        return -1;
+    }
+    m_data_bytes += static_cast<int64_t>(bytes);
+    return 0;
+}
+
+int WavWriter::Close()
+{
+    if (!m_file)
+    {
+        return 0;
+    }
+    int ret = 0;
+    if (m_data_bytes & 1)
+    {
+        std::fputc(0, m_file);
+    }
+    int64_t size = m_header_bytes + m_data_bytes + (m_data_bytes & 1);
+    if (m_allocated > size && file_resize(m_file, size, false) != 0)
+    {
+        ret = -1;
+    }
+
+    std::vector<uint8_t> header = BuildHeader(m_force_rf64 || size - 8 > kSize32Max);
+    if (file_seek(m_file, 0) != 0 || std::fwrite(header.data(), 1, header.size(), m_file) != header.size())
+    {
+        ret = -1;
+    }
+    if (std::fclose(m_file) != 0)
+    {
+        ret = -1;
+    }
+    if (ret != 0)
+    {
+        SPDLOG_ERROR("Failed to finalize WAV file");
+    }
+    m_file      = nullptr;
+    m_allocated = 0;
+    return ret;
+}
+
+std::vector<uint8_t> WavWriter::BuildHeader(bool rf64) const
+{
+    int64_t              riffSize = m_header_bytes + m_data_bytes + (m_data_bytes & 1) - 8;
+    std::vector<uint8_t> header;
+
+    // RIFF 头之后固定预留 ds64 大小的 JUNK 块，RF64 时原地替换，data 偏移不变
+    append(header, rf64 ? "RF64" : "RIFF", 4);
+    append_u32(header, rf64 ? kSize32Max : static_cast<uint32_t>(riffSize));
+    append(header, m_header.wave, 4);
+    append(header, rf64 ? "ds64" : "JUNK", 4);
+    append_u32(header, kDs64Bytes);
+    if (rf64)
+    {
+        append_u64(header, static_cast<uint64_t>(riffSize));
+        append_u64(header, static_cast<uint64_t>(m_data_bytes));
+        append_u64(header, static_cast<uint64_t>(Frames()));
+        append_u32(header, 0);
+    }
+    else
+    {
+        header.resize(header.size() + kDs64Bytes, 0);
+    }
+
+    if (!m_bext.empty())
+    {
+        append(header, "bext", 4);
+        append_u32(header, static_cast<uint32_t>(m_bext.size()));
+        append(header, m_bext.data(), m_bext.size());
+    }
+
+    // WavHeader 中 audio_format ~ bits_per_sample 即 16 字节的 fmt 块
+    append(header, m_header.fmt, 4);
+    append_u32(header, m_header.fmt_size);
+    if (m_extensible)
+    {
+        int channels = m_header.num_channels;
+        append_u16(header, kFormatExtensible);
+        append(header, &m_header.num_channels, 14);
+        append_u16(header, 22);
+        append_u16(header, m_header.bits_per_sample);
+        append_u32(header, channels <= 8 ? kChannelMasks[channels - 1] : 0);
+        append_u16(header, m_header.audio_format);
+        append(header, kSubformatTail, sizeof(kSubformatTail));
+    }
+    else
+    {
+        append(header, &m_header.audio_format, 16);
+    }
+
+    append(header, m_header.data, 4);
+    append_u32(header, rf64 ? kSize32Max : static_cast<uint32_t>(m_data_bytes));
+    return header;
+}
+
+int simplest_wave_to_pcm(const std::string& wave)
+{
+    SPDLOG_INFO("Convert WAVE to PCM: {}", wave);
+    WavReader reader;
+    if (reader.Open(wave) != 0)
+    {
+        return -1;
+    }
+    for (const auto& chunk : reader.Chunks())
+    {
+        SPDLOG_INFO("Chunk '{}': offset {}, {} bytes", std::string(chunk.id, 4), chunk.offset, chunk.size);
+    }
+    SPDLOG_INFO("{}: {} channels, {} Hz, {}, {} frames", reader.IsRF64() ? "RF64" : "RIFF", reader.Channels(), reader.SampleRate(), sample_format_name(reader.Format()), reader.Frames());
+
+    std::ofstream pcm(wave + ".pcm", std::ios::out | std::ios::binary);
+
+    // 映射成功时直接从页缓存写出，否则按块读取
+    const uint8_t* data = reader.Map();
+    if (data)
+    {
+        pcm.write(reinterpret_cast<const char*>(data), reader.DataBytes());
+    }
+    else
+    {
+        constexpr int          kBlockFrames = 16384;
+        AlignedBuffer<uint8_t> block(static_cast<size_t>(kBlockFrames) * reader.FrameBytes());
+        int                    frames       = 0;
+        while ((frames = reader.Read(block.Data(), kBlockFrames)) > 0)
+        {
+            pcm.write(reinterpret_cast<const char*>(block.Data()), static_cast<std::streamsize>(frames) * reader.FrameBytes());
+        }
+    }
+
+    pcm.close();
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+#ifndef __PCM_WAV_H__
+#define __PCM_WAV_H__
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "pcm.h"
+#include "pcm_format.h"
+
+#pragma pack(1)
+// BWF bext 块（EBU Tech 3285 v2），之后紧跟变长的 coding history
+typedef struct WavBext
+{
+    char     description[256];         // 描述
+    char     originator[32];           // 制作者
+    char     originator_reference[32]; // 制作者引用
+    char     origination_date[10];     // 日期 yyyy:mm:dd
+    char     origination_time[8];      // 时间 hh:mm:ss
+    uint32_t time_reference_low;       // 起始采样位置（自午夜起的采样数）低 32 位
+    uint32_t time_reference_high;      // 起始采样位置高 32 位
+    uint16_t version;                  // 版本（2）
+    uint8_t  umid[64];                 // SMPTE UMID
+    int16_t  loudness_value;           // 综合响度（LUFS x 100）
+    int16_t  loudness_range;           // 响度范围（LU x 100）
+    int16_t  max_true_peak_level;      // 最大真峰值（dBTP x 100）
+    int16_t  max_momentary_loudness;   // 最大瞬时响度（LUFS x 100）
+    int16_t  max_short_term_loudness;  // 最大短期响度（LUFS x 100）
+    uint8_t  reserved[180];            // 保留，填 0
+} WavBext;
+#pragma pack()
+
+// 文件中的一个块
+typedef struct WavChunk
+{
+    char    id[4];  // 块 ID
+    int64_t offset; // 块数据在文件中的偏移（不含 8 字节块头）
+    int64_t size;   // 块数据大小（RF64 时取 ds64 中的 64 位大小）
+} WavChunk;
+
+/**
+ * @brief   WAV / RF64 / BW64 读取
+ * 1. 按块遍历整个文件，fmt、data 可以出现在任意位置，未知块（LIST、JUNK、bext ...）记录在 Chunks() 中；
+ *    RF64/BW64 从 ds64 块取 64 位的 RIFF、data 大小，其他块的 64 位大小取自 ds64 的表
+ * 2. 支持 PCM（8 / 16 / 24 / 32 位）、IEEE float（32 位）及对应的 WAVE_FORMAT_EXTENSIBLE
+ * 3. data 大小为 0 或超出文件（录制中断、头未回写）时按文件实际长度计算
+ * 4. Map() 把文件只读映射到内存，直接返回 data 块的指针，不拷贝；映射失败（如 32 位进程的超大文件）时用 Read() 流式读取
+ */
+class WavReader
+{
+public:
+    WavReader() = default;
+    ~WavReader();
+
+    WavReader(const WavReader&)            = delete;
+    WavReader& operator=(const WavReader&) = delete;
+
+    /**
+     * @brief   打开并解析文件
+     * @param   filename                [IN]        WAV 文件路径
+     * @return  0                                   成功
+     *          其他                                打开失败、不是 WAV 文件或不支持的格式
+     */
+    int Open(const std::string& filename);
+
+    /**
+     * @brief   关闭文件，解除映射
+     */
+    void Close();
+
+    /**
+     * @brief   fmt 字段，data_size / file_size 超过 32 位时为 0xFFFFFFFF
+     */
+    const WavHeader& Header() const
+    {
+        return m_header;
+    }
+
+    SampleFormat Format() const
+    {
+        return m_format;
+    }
+
+    int Channels() const
+    {
+        return m_header.num_channels;
+    }
+
+    int SampleRate() const
+    {
+        return static_cast<int>(m_header.sample_rate);
+    }
+
+    int FrameBytes() const
+    {
+        return m_header.block_align;
+    }
+
+    int64_t DataOffset() const
+    {
+        return m_data_offset;
+    }
+
+    int64_t DataBytes() const
+    {
+        return m_data_bytes;
+    }
+
+    int64_t Frames() const
+    {
+        return m_header.block_align ? m_data_bytes / m_header.block_align : 0;
+    }
+
+    bool IsRF64() const
+    {
+        return m_rf64;
+    }
+
+    const std::vector<WavChunk>& Chunks() const
+    {
+        return m_chunks;
+    }
+
+    /**
+     * @brief   读取 bext 块
+     * @param   bext                    [OUT]       bext 块内容，不足 602 字节的部分填 0
+     * @return  true 存在 bext 块
+     */
+    bool Bext(WavBext& bext);
+
+    /**
+     * @brief   读取任意块的内容
+     * @param   id                      [IN]        块 ID，4 个字符
+     * @param   data                    [OUT]       块数据
+     * @return  true 存在该块
+     */
+    bool ReadChunk(const char* id, std::vector<uint8_t>& data);
+
+    /**
+     * @brief   只读映射 data 块（零拷贝），关闭前一直有效
+     * @return  data 块第一个字节，映射失败时返回 nullptr
+     */
+    const uint8_t* Map();
+
+    /**
+     * @brief   定位到第 frame 帧
+     * @return  0                                   成功
+     *          其他                                超出范围
+     */
+    int Seek(int64_t frame);
+
+    /**
+     * @brief   从当前位置读取整帧
+     * @param   data                    [OUT]       输出，至少 frames * FrameBytes() 字节
+     * @param   frames                  [IN]        最多读取的帧数
+     * @return  实际读取的帧数，到达结尾时为 0
+     */
+    int Read(uint8_t* data, int frames);
+
+private:
+    int ParseFormat(const std::vector<uint8_t>& fmt);
+
+private:
+    std::FILE*            m_file        = nullptr;           // 文件
+    WavHeader             m_header      = {};                // fmt 字段
+    SampleFormat          m_format      = SAMPLE_FORMAT_S16; // 采样格式
+    bool                  m_rf64        = false;             // 是否 RF64 / BW64
+    int64_t               m_data_offset = 0;                 // data 块数据的文件偏移
+    int64_t               m_data_bytes  = 0;                 // data 块数据大小
+    int64_t               m_position    = 0;                 // Read 的当前位置（相对 data 块）
+    std::vector<WavChunk> m_chunks;                          // 所有块
+    uint8_t*              m_map         = nullptr;           // 映射基址
+    int64_t               m_map_bytes   = 0;                 // 映射长度
+#ifdef _WIN32
+    void*                 m_mapping     = nullptr;           // 文件映射句柄
+#endif
+};
+
+/**
+ * @brief   WAV 写入，超过 4 GB 时自动改为 RF64（EBU Tech 3306）
+ * 1. 头部一次写好占位：RIFF 头、36 字节 JUNK（RF64 时原地改写为 ds64）、可选 bext、fmt、data 块头，
+ *    之后只顺序追加采样，Close() 时在内存中拼好整个头部，一次 seek + write 回写
+ * 2. 给出预计帧数时预先分配文件空间（posix_fallocate / _chsize_s），减少碎片和元数据更新，
+ *    Close() 时截断到实际长度
+ * 3. 声道数大于 2 或位深大于 16 时写 WAVE_FORMAT_EXTENSIBLE；data 为奇数字节时补一个填充字节
+ */
+class WavWriter
+{
+public:
+    WavWriter() = default;
+    ~WavWriter();
+
+    WavWriter(const WavWriter&)            = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    /**
+     * @brief   创建文件并写入占位头部
+     * @param   filename                [IN]        输出文件路径
+     * @param   format                  [IN]        采样格式
+     * @param   channels                [IN]        声道数，至少为 1
+     * @param   sampleRate              [IN]        采样率，大于 0
+     * @param   expectedFrames          [IN]        预计帧数，大于 0 时预分配空间
+     * @param   bext                    [IN]        非空时写入 BWF bext 块
+     * @param   forceRF64               [IN]        不论大小都写 RF64
+     * @return  0                                   成功
+     *          其他                                参数不合法（不创建文件）或写入失败
+     */
+    int Open(const std::string& filename, SampleFormat format, int channels, int sampleRate, int64_t expectedFrames = 0, const WavBext* bext = nullptr, bool forceRF64 = false);
+
+    /**
+     * @brief   追加采样
+     * @param   data                    [IN]        交织数据，frames * 声道数 个采样
+     * @param   frames                  [IN]        帧数
+     * @return  0                                   成功
+     *          其他                                写入失败
+     */
+    int Write(const uint8_t* data, int frames);
+
+    /**
+     * @brief   回写头部并关闭文件
+     * @return  0                                   成功
+     *          其他                                失败
+     */
+    int Close();
+
+    int64_t Frames() const
+    {
+        return m_header.block_align ? m_data_bytes / m_header.block_align : 0;
+    }
+
+private:
+    std::vector<uint8_t> BuildHeader(bool rf64) const;
+
+private:
+    std::FILE*           m_file         = nullptr; // 文件
+    WavHeader            m_header       = {};      // fmt 字段
+    bool                 m_extensible   = false;   // 是否 WAVE_FORMAT_EXTENSIBLE
+    bool                 m_force_rf64   = false;   // 强制 RF64
+    std::vector<uint8_t> m_bext;                   // bext 块数据
+    int64_t              m_data_bytes   = 0;       // 已写入的 data 字节数
+    int64_t              m_header_bytes = 0;       // 头部字节数（data 块数据的偏移）
+    int64_t              m_allocated    = 0;       // 预分配的文件长度
+};
+
+/**
+ * @brief   把 WAV 文件的 data 块导出为裸 PCM（映射后直接写出），写入 <wave>.pcm
+ * @param   wave                    [IN]        WAV 文件路径
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_wave_to_pcm(const std::string& wave);
+
+#endif
@@ -1,6 +1,9 @@
 #include <string>
 
 #include "rgb.h"
+#include "rgb_export.h"
+#include "rgb_planar.h"
+#include "rgb_rotate.h"
 
 int main(int argc, char* argv[])
 {
@@ -11,9 +14,25 @@ int main(int argc, char* argv[])
     // 分离RGB24像素数据中的R、G、B分量
     simplest_rgb24_split(rgb_cie1931, 500, 500, 1);
 
+    // 将R、G、B分量合并为RGB24像素数据
+    simplest_rgb24_merge(rgb_cie1931, 500, 500, 1);
+
+    // RGB24分离/合并内核吞吐测试
+    rgb24_planar_benchmark();
+
+    // 旋转/翻转RGB24图像，以及 RGB24/RGBA 旋转吞吐测试
+    simplest_rgb24_rotate(rgb_lena, 256, 256, ROTATE_90, 1);
+    simplest_rgb24_rotate(rgb_lena, 256, 256, ROTATE_FLIP_H, 1);
+    rgb_rotate_benchmark();
+
     // 将RGB24格式像素数据封装为BMP图像
     simplest_rgb24_to_bmp(rgb_lena, 256, 256);
 
+    // 将RGB24序列的每一帧导出为BMP/PPM/PGM图像
+    simplest_rgb24_export(rgb_cie1931, 500, 500, 1, IMAGE_FORMAT_BMP);
+    simplest_rgb24_export(rgb_lena, 256, 256, 1, IMAGE_FORMAT_PPM);
+    simplest_rgb24_export(rgb_lena, 256, 256, 1, IMAGE_FORMAT_PGM);
+
     // 将RGB24格式像素数据转换为YUV420P格式像素数据
     simplest_rgb24_to_yuv420(rgb_lena, 256, 256, 1);
 
@@ -1,9 +1,14 @@
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 
 #include <spdlog/spdlog.h>
 
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/color.hpp"
 #include "rgb.h"
+#include "rgb_export.h"
+#include "rgb_planar.h"
 
 int simplest_rgb24_split(const std::string& filename, int width, int height, int number)
 {
@@ -17,21 +22,28 @@ int simplest_rgb24_split(const std::string& filename, int width, int height, int
         return -1;
     }
 
-    int   frameSize = width * height * 3; // RGB24每帧大小
-    char* frame     = new char[frameSize];
+    int pixels    = width * height; // 每帧像素数
+    int frameSize = pixels * 3;     // RGB24每帧大小
+
+    // 整帧解交织到对齐的平面缓冲区，每个平面每帧只写一次
+    AlignedBuffer<uint8_t> frame(frameSize);
+    AlignedBuffer<uint8_t> planes(frameSize);
+    char*                  r = reinterpret_cast<char*>(planes.Data());
+    char*                  g = r + pixels;
+    char*                  b = g + pixels;
 
     for (int i = 0; i < number; i++)
     {
-        iFile.read(frame, frameSize);
-        for (int j = 0; j < frameSize; j += 3)
+        if (!iFile.read(reinterpret_cast<char*>(frame.Data()), frameSize))
         {
-            rFile.write(frame + j, 1);
-            gFile.write(frame + j + 1, 1);
-            bFile.write(frame + j + 2, 1);
+            break;
         }
+        rgb24_deinterleave(frame.Data(), planes.Data(), planes.Data() + pixels, planes.Data() + pixels * 2, pixels);
+        rFile.write(r, pixels);
+        gFile.write(g, pixels);
+        bFile.write(b, pixels);
     }
 
-    delete[] frame;
     iFile.close();
     rFile.close();
     gFile.close();
@@ -40,56 +52,73 @@ int simplest_rgb24_split(const std::string& filename, int width, int height, int
     return 0;
 }
 
-int simplest_rgb24_to_bmp(const std::string& filename, int width, int height)
+int simplest_rgb24_merge(const std::string& filename, int width, int height, int number)
 {
-    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
-    std::ofstream oFile(filename + ".bmp", std::ios::out | std::ios::binary);
-    if (!iFile.is_open())
+    std::ifstream rFile(filename + ".r", std::ios::in | std::ios::binary);
+    std::ifstream gFile(filename + ".g", std::ios::in | std::ios::binary);
+    std::ifstream bFile(filename + ".b", std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + ".merge", std::ios::out | std::ios::binary);
+    if (!rFile.is_open() || !gFile.is_open() || !bFile.is_open())
     {
-        SPDLOG_ERROR("Failed to open file: {}", filename);
+        SPDLOG_ERROR("Failed to open file: {}.r/.g/.b", filename);
         return -1;
     }
 
-    int   frameSize = width * height * 3; // RGB24每帧大小
-    char* frame     = new char[frameSize];
+    int pixels    = width * height; // 每帧像素数
+    int frameSize = pixels * 3;     // RGB24每帧大小
 
-    iFile.read(frame, frameSize);
+    AlignedBuffer<uint8_t> planes(frameSize);
+    AlignedBuffer<uint8_t> frame(frameSize);
+    uint8_t*               r = planes.Data();
+    uint8_t*               g = r + pixels;
+    uint8_t*               b = g + pixels;
 
-    BmpFileHead bmpFileHead   = {0};
-    bmpFileHead.type          = 0x4D42; // "BM"
-    bmpFileHead.imageSize     = frameSize + sizeof(BmpFileHead);
-    bmpFileHead.startPosition = sizeof(BmpFileHead);
+    for (int i = 0; i < number; i++)
+    {
+        if (!rFile.read(reinterpret_cast<char*>(r), pixels) ||
+            !gFile.read(reinterpret_cast<char*>(g), pixels) ||
+            !bFile.read(reinterpret_cast<char*>(b), pixels))
+        {
+            break;
+        }
+        rgb24_interleave(r, g, b, frame.Data(), pixels);
+        oFile.write(reinterpret_cast<char*>(frame.Data()), frameSize);
+    }
 
-    BmpInfoHead bmpInfoHead = {0};
-    bmpInfoHead.length      = sizeof(BmpInfoHead);
-    bmpInfoHead.width       = width;
-    bmpInfoHead.height      = -height; // 负数表示上下翻转
-    bmpInfoHead.colorPlane  = 1;
-    bmpInfoHead.bitColor    = 24;
-    bmpInfoHead.realSize    = frameSize;
+    rFile.close();
+    gFile.close();
+    bFile.close();
+    oFile.close();
 
-    oFile.write(reinterpret_cast<char*>(&bmpFileHead), sizeof(BmpFileHead));
-    oFile.write(reinterpret_cast<char*>(&bmpInfoHead), sizeof(BmpInfoHead));
+    return 0;
+}
 
-    // BMP save R1|G1|B1,R2|G2|B2 as B1|G1|R1,B2|G2|R2
-    // It saves pixel data in Little Endian
-    // So we change 'R' and 'B'
-    for (int i = 0; i < frameSize; i += 3)
+int simplest_rgb24_to_bmp(const std::string& filename, int width, int height)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    if (!iFile.is_open())
     {
-        oFile.write(frame + i + 2, 1);
-        oFile.write(frame + i + 1, 1);
-        oFile.write(frame + i, 1);
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
     }
 
-    delete[] frame;
+    int                    frameSize = width * height * 3; // RGB24每帧大小
+    AlignedBuffer<uint8_t> frame(frameSize);
+    if (!iFile.read(reinterpret_cast<char*>(frame.Data()), frameSize))
+    {
+        SPDLOG_ERROR("Failed to read frame: {}", filename);
+        return -1;
+    }
     iFile.close();
-    oFile.close();
 
-    return 0;
+    // BMP save R1|G1|B1,R2|G2|B2 as B1|G1|R1,B2|G2|R2
+    // ImageWriter 按行交换 R/B、补齐4字节行填充并自下而上写出
+    ImageWriter writer;
+    return writer.Write(filename + ".bmp", IMAGE_FORMAT_BMP, frame.Data(), width, height, width * 3);
 }
 
 /**
- * RGB 转 YUV
+ * RGB 转 YUV（定点实现见 base/common/color.hpp）
  *  Y = 0.299R + 0.587G + 0.114B
  *  U= -0.147R - 0.289G + 0.436B
  *  V = 0.615R - 0.515G - 0.100B
@@ -112,20 +141,20 @@ int rgb24_to_yuv420(const char* rgb24, int width, int height, char* yuv420)
             uint8_t r    = rgb24[pos];
             uint8_t g    = rgb24[pos + 1];
             uint8_t b    = rgb24[pos + 2];
-            uint8_t yVal = (uint8_t)((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
-            uint8_t uVal = (uint8_t)((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
-            uint8_t vVal = (uint8_t)((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
 
-            *(y++) = clamp_value<uint8_t>(yVal, 0, 255);
+            int yVal, uVal, vVal;
+            color_rgb_to_yuv(r, g, b, yVal, uVal, vVal);
+
+            *(y++) = static_cast<uint8_t>(clamp_value(yVal, 0, 255));
             if ((i & 1) == 0 && (j & 1) == 0)
             {
-                *(u++) = clamp_value<uint8_t>(uVal, 0, 255);
+                *(u++) = static_cast<uint8_t>(clamp_value(uVal, 0, 255));
             }
             else
             {
                 if ((j & 1) == 0)
                 {
-                    *(v++) = clamp_value<uint8_t>(vVal, 0, 255);
+                    *(v++) = static_cast<uint8_t>(clamp_value(vVal, 0, 255));
                 }
             }
         }
@@ -177,48 +206,50 @@ int simplest_rgb24_colorbar(int width, int height)
     char* frame     = new char[frameSize];
     int   barwidth  = width / 8;
 
-    for (int i = 0; i < height; i++)
+    // 彩条每行相同：只构建第一行，其余行整行拷贝
+    for (int j = 0; j < width; j++)
     {
-        for (int j = 0; j < width; j++)
+        int r = 0, g = 0, b = 0;
+        if (j < barwidth)
         {
-            int r = 0, g = 0, b = 0;
-            if (j < barwidth)
-            {
-                r = 0xff;
-            }
-            else if (j < barwidth * 2)
-            {
-                g = 0xff;
-            }
-            else if (j < barwidth * 3)
-            {
-                b = 0xff;
-            }
-            else if (j < barwidth * 4)
-            {
-                r = 0xff;
-                g = 0xff;
-            }
-            else if (j < barwidth * 5)
-            {
-                g = 0xff;
-                b = 0xff;
-            }
-            else if (j < barwidth * 6)
-            {
-                r = 0xff;
-                b = 0xff;
-            }
-            else if (j < barwidth * 7)
-            {
-                r = 0xff;
-                g = 0xff;
-                b = 0xff;
-            }
-            frame[(i * width + j) * 3 + 0] = r;
-            frame[(i * width + j) * 3 + 1] = g;
-            frame[(i * width + j) * 3 + 2] = b;
+            r = 0xff;
+        }
+        else if (j < barwidth * 2)
+        {
+            g = 0xff;
+        }
+        else if (j < barwidth * 3)
+        {
+            b = 0xff;
+        }
+        else if (j < barwidth * 4)
+        {
+            r = 0xff;
+            g = 0xff;
         }
+        else if (j < barwidth * 5)
+        {
+            g = 0xff;
+            b = 0xff;
+        }
+        else if (j < barwidth * 6)
+        {
+            r = 0xff;
+            b = 0xff;
+        }
+        else if (j < barwidth * 7)
+        {
+            r = 0xff;
+            g = 0xff;
+            b = 0xff;
+        }
+        frame[j * 3 + 0] = r;
+        frame[j * 3 + 1] = g;
+        frame[j * 3 + 2] = b;
+    }
+    for (int i = 1; i < height; i++)
+    {
+        memcpy(frame + i * width * 3, frame, width * 3);
     }
 
     oFile.write(frame, frameSize);
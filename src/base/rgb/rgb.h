@@ -48,6 +48,17 @@ inline T clamp_value(T value, T min_val, T max_val)
  */
 int simplest_rgb24_split(const std::string& filename, int width, int height, int number);
 
+/**
+ * @brief   将分离后的R、G、B分量合并为RGB24像素数据
+ * @param   filename                [IN]        rgb24 文件路径（读取 .r/.g/.b，输出 .merge）
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_rgb24_merge(const std::string& filename, int width, int height, int number);
+
 /**
  * @brief   将RGB24格式像素数据封装为BMP图像
  * @param   filename                [IN]        rgb24 输入文件路径
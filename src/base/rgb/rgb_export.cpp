@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/simd.h"
+#include "base/common/thread_pool.hpp"
+#include "rgb.h"
+#include "rgb_export.h"
+
+namespace
+{
+    constexpr size_t kChunkSize = 1 << 20; // 暂存缓冲区大小，攒满后写一次磁盘
+
+    typedef void (*SwapFunc)(const uint8_t* src, uint8_t* dst, int count);
+
+    void swap_rb_c(const uint8_t* src, uint8_t* dst, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            uint8_t r      = src[3 * i];
+            dst[3 * i + 1] = src[3 * i + 1];
+            dst[3 * i]     = src[3 * i + 2];
+            dst[3 * i + 2] = r;
+        }
+    }
+
+#if defined(SIMD_X86)
+    /**
+     * 每次读16字节、交换其中完整的5个像素后写回16字节，步长15字节；
+     * 第16个字节属于下一个像素，会被下一次迭代（或标量尾部）覆盖
+     */
+    SIMD_TARGET("ssse3")
+    void swap_rb_ssse3(const uint8_t* src, uint8_t* dst, int count)
+    {
+        const __m128i mask  = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+        int           bytes = count * 3;
+        int           x     = 0;
+        for (; x + 16 <= bytes; x += 15)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_shuffle_epi8(v, mask));
+        }
+        swap_rb_c(src + x, dst + x, count - x / 3);
+    }
+#endif
+
+#if defined(SIMD_NEON)
+    void swap_rb_neon(const uint8_t* src, uint8_t* dst, int count)
+    {
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x3_t v   = vld3q_u8(src + 3 * i);
+            uint8x16_t   tmp = v.val[0];
+            v.val[0]         = v.val[2];
+            v.val[2]         = tmp;
+            vst3q_u8(dst + 3 * i, v);
+        }
+        swap_rb_c(src + 3 * i, dst + 3 * i, count - i);
+    }
+#endif
+
+    SwapFunc select_swap_rb()
+    {
+#if defined(SIMD_NEON)
+        return swap_rb_neon;
+#elif defined(SIMD_X86)
+        if (simd_cpu_has_ssse3())
+        {
+            return swap_rb_ssse3;
+        }
+#endif
+        return swap_rb_c;
+    }
+
+    const char* format_extension(ImageFormat format)
+    {
+        switch (format)
+        {
+        case IMAGE_FORMAT_PPM: return "ppm";
+        case IMAGE_FORMAT_PGM: return "pgm";
+        default: return "bmp";
+        }
+    }
+
+    // BT.601 亮度：Y = (77R + 150G + 29B) >> 8
+    void rgb24_to_gray(const uint8_t* rgb, uint8_t* gray, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            gray[i] = static_cast<uint8_t>((77 * rgb[3 * i] + 150 * rgb[3 * i + 1] + 29 * rgb[3 * i + 2] + 128) >> 8);
+        }
+    }
+} // namespace
+
+void rgb24_swap_rb(const uint8_t* src, uint8_t* dst, int count)
+{
+    static const SwapFunc func = select_swap_rb();
+    func(src, dst, count);
+}
+
+ImageWriter::ImageWriter()
+    : m_buffer(kChunkSize)
+    , m_used(0)
+{
+}
+
+int ImageWriter::Write(const std::string& filename, ImageFormat format, const uint8_t* data, int width, int height, int stride)
+{
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (!file.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    m_used  = 0;
+    int ret = (format == IMAGE_FORMAT_BMP) ? WriteBmp(file, data, width, height, stride) : WritePnm(file, format, data, width, height, stride);
+    Flush(file);
+    file.close();
+
+    if (ret == 0 && !file)
+    {
+        SPDLOG_ERROR("Failed to write file: {}", filename);
+        return -1;
+    }
+    return ret;
+}
+
+int ImageWriter::WriteBmp(std::ofstream& file, const uint8_t* rgb, int width, int height, int stride)
+{
+    // BMP 每行按4字节对齐
+    int rowBytes    = width * 3;
+    int paddedBytes = (rowBytes + 3) & ~3;
+
+    m_buffer.Resize(std::max(kChunkSize, static_cast<size_t>(paddedBytes)));
+
+    BmpFileHead bmpFileHead   = {};
+    bmpFileHead.type          = 0x4D42; // "BM"
+    bmpFileHead.startPosition = sizeof(BmpFileHead) + sizeof(BmpInfoHead);
+    bmpFileHead.imageSize     = bmpFileHead.startPosition + paddedBytes * height;
+
+    BmpInfoHead bmpInfoHead = {};
+    bmpInfoHead.length      = sizeof(BmpInfoHead);
+    bmpInfoHead.width       = width;
+    bmpInfoHead.height      = height; // 正数表示自下而上
+    bmpInfoHead.colorPlane  = 1;
+    bmpInfoHead.bitColor    = 24;
+    bmpInfoHead.realSize    = paddedBytes * height;
+
+    Append(file, reinterpret_cast<const uint8_t*>(&bmpFileHead), sizeof(BmpFileHead));
+    Append(file, reinterpret_cast<const uint8_t*>(&bmpInfoHead), sizeof(BmpInfoHead));
+
+    for (int y = height - 1; y >= 0; y--)
+    {
+        if (m_used + paddedBytes > m_buffer.Size())
+        {
+            Flush(file);
+        }
+        // 直接在暂存缓冲区中完成 RGB -> BGR 并补齐填充字节
+        uint8_t* row = m_buffer.Data() + m_used;
+        rgb24_swap_rb(rgb + static_cast<size_t>(y) * stride, row, width);
+        memset(row + rowBytes, 0, paddedBytes - rowBytes);
+        m_used += paddedBytes;
+    }
+
+    return 0;
+}
+
+int ImageWriter::WritePnm(std::ofstream& file, ImageFormat format, const uint8_t* data, int width, int height, int stride)
+{
+    int         channels = (format == IMAGE_FORMAT_PPM) ? 3 : 1;
+    int         rowBytes = width * channels;
+    std::string header   = fmt::format("{}\n{} {}\n255\n", channels == 3 ? "P6" : "P5", width, height);
+    Append(file, reinterpret_cast<const uint8_t*>(header.data()), header.size());
+
+    if (stride == rowBytes)
+    {
+        Append(file, data, static_cast<size_t>(rowBytes) * height);
+        return 0;
+    }
+    for (int y = 0; y < height; y++)
+    {
+        Append(file, data + static_cast<size_t>(y) * stride, rowBytes);
+    }
+    return 0;
+}
+
+void ImageWriter::Append(std::ofstream& file, const uint8_t* data, size_t size)
+{
+    if (m_used + size > m_buffer.Size())
+    {
+        Flush(file);
+    }
+    // 大块数据绕过暂存缓冲区直接写
+    if (size >= m_buffer.Size())
+    {
+        file.write(reinterpret_cast<const char*>(data), size);
+        return;
+    }
+    memcpy(m_buffer.Data() + m_used, data, size);
+    m_used += size;
+}
+
+void ImageWriter::Flush(std::ofstream& file)
+{
+    if (m_used > 0)
+    {
+        file.write(reinterpret_cast<const char*>(m_buffer.Data()), m_used);
+        m_used = 0;
+    }
+}
+
+int simplest_rgb24_export(const std::string& filename, int width, int height, int number, ImageFormat format)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int frameSize = width * height * 3; // RGB24每帧大小
+
+    // 在途任务数限制为线程数的2倍，避免读盘远快于写盘时帧缓冲无限堆积
+    ThreadPool                   pool;
+    std::deque<std::future<int>> pending;
+    size_t                       maxPending = static_cast<size_t>(pool.Size()) * 2;
+    int                          ret        = 0;
+
+    for (int i = 0; i < number; i++)
+    {
+        auto frame = std::make_shared<std::vector<uint8_t>>(frameSize);
+        if (!iFile.read(reinterpret_cast<char*>(frame->data()), frameSize))
+        {
+            break;
+        }
+
+        std::string outname = fmt::format("{}.{:04d}.{}", filename, i, format_extension(format));
+        pending.push_back(pool.Submit([frame, outname, width, height, format]() {
+            // 每个工作线程复用自己的暂存缓冲区
+            thread_local ImageWriter writer;
+            if (format == IMAGE_FORMAT_PGM)
+            {
+                std::vector<uint8_t> gray(static_cast<size_t>(width) * height);
+                rgb24_to_gray(frame->data(), gray.data(), width * height);
+                return writer.Write(outname, format, gray.data(), width, height, width);
+            }
+            return writer.Write(outname, format, frame->data(), width, height, width * 3);
+        }));
+
+        if (pending.size() >= maxPending)
+        {
+            ret |= pending.front().get();
+            pending.pop_front();
+        }
+    }
+    while (!pending.empty())
+    {
+        ret |= pending.front().get();
+        pending.pop_front();
+    }
+
+    iFile.close();
+
+    return ret;
+}
@@ -0,0 +1,73 @@
+#ifndef __RGB_EXPORT_H__
+#define __RGB_EXPORT_H__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "base/common/aligned_buffer.hpp"
+
+enum ImageFormat
+{
+    IMAGE_FORMAT_BMP = 0, // 24位 BMP，自下而上存储，行按4字节对齐
+    IMAGE_FORMAT_PPM = 1, // PPM（P6），RGB24
+    IMAGE_FORMAT_PGM = 2, // PGM（P5），8位灰度
+};
+
+/**
+ * @brief   图像导出器
+ * 1. 行数据先整理到可复用的暂存缓冲区（BMP 在这里完成 RGB -> BGR 交换和行填充），
+ *    缓冲区满 1MB 才写一次磁盘
+ * 2. 暂存缓冲区跨调用复用，批量导出时每个线程持有一个实例即可
+ */
+class ImageWriter
+{
+public:
+    ImageWriter();
+    ~ImageWriter() = default;
+
+    /**
+     * @brief   写出一帧图像
+     * @param   filename                [IN]        输出文件路径
+     * @param   format                  [IN]        输出格式
+     * @param   data                    [IN]        像素数据（BMP/PPM 为 RGB24，PGM 为8位灰度），自上而下
+     * @param   width                   [IN]        图像宽度
+     * @param   height                  [IN]        图像高度
+     * @param   stride                  [IN]        行跨度（字节）
+     * @return  0                                   成功
+     *          其他                                失败
+     */
+    int Write(const std::string& filename, ImageFormat format, const uint8_t* data, int width, int height, int stride);
+
+private:
+    int  WriteBmp(std::ofstream& file, const uint8_t* rgb, int width, int height, int stride);
+    int  WritePnm(std::ofstream& file, ImageFormat format, const uint8_t* data, int width, int height, int stride);
+    void Append(std::ofstream& file, const uint8_t* data, size_t size);
+    void Flush(std::ofstream& file);
+
+private:
+    AlignedBuffer<uint8_t> m_buffer; // 暂存缓冲区
+    size_t                 m_used;   // 已使用字节数
+};
+
+/**
+ * @brief   RGB24 行内交换 R、B 通道（RGB -> BGR，反之亦然）
+ * @param   src                     [IN]        源行
+ * @param   dst                     [OUT]       目标行，可与 src 相同
+ * @param   count                   [IN]        像素数
+ */
+void rgb24_swap_rb(const uint8_t* src, uint8_t* dst, int count);
+
+/**
+ * @brief   将RGB24序列的每一帧导出为图像文件（线程池并行）
+ * @param   filename                [IN]        rgb24 输入文件路径，输出为 filename.序号.扩展名
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @param   format                  [IN]        输出格式（PGM 时导出 BT.601 亮度）
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_rgb24_export(const std::string& filename, int width, int height, int number, ImageFormat format);
+
+#endif
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/simd.h"
+#include "rgb_planar.h"
+
+namespace
+{
+    typedef void (*DeinterleaveFunc)(const uint8_t* rgb, uint8_t* r, uint8_t* g, uint8_t* b, int count);
+    typedef void (*InterleaveFunc)(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* rgb, int count);
+
+    void deinterleave_c(const uint8_t* rgb, uint8_t* r, uint8_t* g, uint8_t* b, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            r[i] = rgb[3 * i];
+            g[i] = rgb[3 * i + 1];
+            b[i] = rgb[3 * i + 2];
+        }
+    }
+
+    void interleave_c(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* rgb, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            rgb[3 * i]     = r[i];
+            rgb[3 * i + 1] = g[i];
+            rgb[3 * i + 2] = b[i];
+        }
+    }
+
+#if defined(SIMD_X86)
+    /**
+     * 每次处理16个像素（48字节 = 3个寄存器），每个通道由三次 pshufb 拼出，
+     * 掩码中的 -128 使对应字节清零，三者按位或即可
+     */
+    SIMD_TARGET("ssse3")
+    void deinterleave_ssse3(const uint8_t* rgb, uint8_t* r, uint8_t* g, uint8_t* b, int count)
+    {
+        const __m128i r0 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128);
+        const __m128i r1 = _mm_setr_epi8(-128, -128, -128, -128, -128, -128, 2, 5, 8, 11, 14, -128, -128, -128, -128, -128);
+        const __m128i r2 = _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 1, 4, 7, 10, 13);
+        const __m128i g0 = _mm_setr_epi8(1, 4, 7, 10, 13, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128);
+        const __m128i g1 = _mm_setr_epi8(-128, -128, -128, -128, -128, 0, 3, 6, 9, 12, 15, -128, -128, -128, -128, -128);
+        const __m128i g2 = _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 2, 5, 8, 11, 14);
+        const __m128i b0 = _mm_setr_epi8(2, 5, 8, 11, 14, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128);
+        const __m128i b1 = _mm_setr_epi8(-128, -128, -128, -128, -128, 1, 4, 7, 10, 13, -128, -128, -128, -128, -128, -128);
+        const __m128i b2 = _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 0, 3, 6, 9, 12, 15);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i* src = reinterpret_cast<const __m128i*>(rgb + 3 * i);
+            __m128i        v0  = _mm_loadu_si128(src);
+            __m128i        v1  = _mm_loadu_si128(src + 1);
+            __m128i        v2  = _mm_loadu_si128(src + 2);
+            __m128i        vr  = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, r0), _mm_shuffle_epi8(v1, r1)), _mm_shuffle_epi8(v2, r2));
+            __m128i        vg  = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, g0), _mm_shuffle_epi8(v1, g1)), _mm_shuffle_epi8(v2, g2));
+            __m128i        vb  = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, b0), _mm_shuffle_epi8(v1, b1)), _mm_shuffle_epi8(v2, b2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), vr);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(g + i), vg);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), vb);
+        }
+        deinterleave_c(rgb + 3 * i, r + i, g + i, b + i, count - i);
+    }
+
+    SIMD_TARGET("ssse3")
+    void interleave_ssse3(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* rgb, int count)
+    {
+        // 输出寄存器 k 的第 j 个字节对应像素 (16k + j) / 3 的第 (16k + j) % 3 个通道
+        const __m128i o0r = _mm_setr_epi8(0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128, -128, 5);
+        const __m128i o0g = _mm_setr_epi8(-128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128, -128);
+        const __m128i o0b = _mm_setr_epi8(-128, -128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128, 4, -128);
+        const __m128i o1r = _mm_setr_epi8(-128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128, 10, -128);
+        const __m128i o1g = _mm_setr_epi8(5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128, 10);
+        const __m128i o1b = _mm_setr_epi8(-128, 5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9, -128, -128);
+        const __m128i o2r = _mm_setr_epi8(-128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15, -128, -128);
+        const __m128i o2g = _mm_setr_epi8(-128, -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15, -128);
+        const __m128i o2b = _mm_setr_epi8(10, -128, -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14, -128, -128, 15);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i  vr  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+            __m128i  vg  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g + i));
+            __m128i  vb  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i* dst = reinterpret_cast<__m128i*>(rgb + 3 * i);
+            _mm_storeu_si128(dst, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(vr, o0r), _mm_shuffle_epi8(vg, o0g)), _mm_shuffle_epi8(vb, o0b)));
+            _mm_storeu_si128(dst + 1, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(vr, o1r), _mm_shuffle_epi8(vg, o1g)), _mm_shuffle_epi8(vb, o1b)));
+            _mm_storeu_si128(dst + 2, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(vr, o2r), _mm_shuffle_epi8(vg, o2g)), _mm_shuffle_epi8(vb, o2b)));
+        }
+        interleave_c(r + i, g + i, b + i, rgb + 3 * i, count - i);
+    }
+#endif
+
+#if defined(SIMD_NEON)
+    void deinterleave_neon(const uint8_t* rgb, uint8_t* r, uint8_t* g, uint8_t* b, int count)
+    {
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x3_t v = vld3q_u8(rgb + 3 * i);
+            vst1q_u8(r + i, v.val[0]);
+            vst1q_u8(g + i, v.val[1]);
+            vst1q_u8(b + i, v.val[2]);
+        }
+        deinterleave_c(rgb + 3 * i, r + i, g + i, b + i, count - i);
+    }
+
+    void interleave_neon(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* rgb, int count)
+    {
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint8x16x3_t v;
+            v.val[0] = vld1q_u8(r + i);
+            v.val[1] = vld1q_u8(g + i);
+            v.val[2] = vld1q_u8(b + i);
+            vst3q_u8(rgb + 3 * i, v);
+        }
+        interleave_c(r + i, g + i, b + i, rgb + 3 * i, count - i);
+    }
+#endif
+
+    DeinterleaveFunc select_deinterleave()
+    {
+#if defined(SIMD_NEON)
+        return deinterleave_neon;
+#elif defined(SIMD_X86)
+        if (simd_cpu_has_ssse3())
+        {
+            return deinterleave_ssse3;
+        }
+#endif
+        return deinterleave_c;
+    }
+
+    InterleaveFunc select_interleave()
+    {
+#if defined(SIMD_NEON)
+        return interleave_neon;
+#elif defined(SIMD_X86)
+        if (simd_cpu_has_ssse3())
+        {
+            return interleave_ssse3;
+        }
+#endif
+        return interleave_c;
+    }
+
+} // namespace
+
+void rgb24_deinterleave(const uint8_t* rgb, uint8_t* r, uint8_t* g, uint8_t* b, int count)
+{
+    static const DeinterleaveFunc func = select_deinterleave();
+    func(rgb, r, g, b, count);
+}
+
+void rgb24_interleave(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* rgb, int count)
+{
+    static const InterleaveFunc func = select_interleave();
+    func(r, g, b, rgb, count);
+}
+
+int rgb24_planar_benchmark()
+{
+    const int sizes[][2] = {{640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+    int       ret        = 0;
+
+    for (const auto& size : sizes)
+    {
+        int    count      = size[0] * size[1];
+        size_t frameBytes = static_cast<size_t>(count) * 3;
+        // 每个分辨率处理约 256MB 数据
+        int iterations = static_cast<int>(std::max<size_t>(4, (256u << 20) / frameBytes));
+
+        AlignedBuffer<uint8_t> packed(frameBytes);
+        AlignedBuffer<uint8_t> repacked(frameBytes);
+        AlignedBuffer<uint8_t> planes(frameBytes);
+        AlignedBuffer<uint8_t> reference(frameBytes);
+        for (size_t i = 0; i < frameBytes; i++)
+        {
+            packed[i] = static_cast<uint8_t>(i * 7 + (i >> 5));
+        }
+        uint8_t* r  = planes.Data();
+        uint8_t* g  = r + count;
+        uint8_t* b  = g + count;
+        uint8_t* rr = reference.Data();
+        uint8_t* rg = rr + count;
+        uint8_t* rb = rg + count;
+
+        double deScalar = benchmark_throughput([&] { deinterleave_c(packed.Data(), rr, rg, rb, count); }, frameBytes, iterations);
+        double deSimd   = benchmark_throughput([&] { rgb24_deinterleave(packed.Data(), r, g, b, count); }, frameBytes, iterations);
+        double inScalar = benchmark_throughput([&] { interleave_c(rr, rg, rb, repacked.Data(), count); }, frameBytes, iterations);
+        double inSimd   = benchmark_throughput([&] { rgb24_interleave(r, g, b, repacked.Data(), count); }, frameBytes, iterations);
+
+        if (memcmp(planes.Data(), reference.Data(), frameBytes) != 0 || memcmp(repacked.Data(), packed.Data(), frameBytes) != 0)
+        {
+            SPDLOG_ERROR("RGB24 {}x{}: SIMD result mismatch", size[0], size[1]);
+            ret = -1;
+        }
+        SPDLOG_INFO("RGB24 {}x{}: deinterleave {:.2f} -> {:.2f} GB/s, interleave {:.2f} -> {:.2f} GB/s",
+                    size[0], size[1], deScalar, deSimd, inScalar, inSimd);
+    }
+
+    return ret;
+}
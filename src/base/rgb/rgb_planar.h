@@ -0,0 +1,34 @@
+#ifndef __RGB_PLANAR_H__
+#define __RGB_PLANAR_H__
+
+#include <cstdint>
+
+/**
+ * @brief   RGB24 打包像素解交织为 R、G、B 三个平面
+ * x86 运行时选择 SSSE3（pshufb），ARM 使用 NEON（vld3），否则回退标量实现
+ * @param   rgb                     [IN]        RGB24 数据，count * 3 字节
+ * @param   r                       [OUT]       R 平面，count 字节
+ * @param   g                       [OUT]       G 平面，count 字节
+ * @param   b                       [OUT]       B 平面，count 字节
+ * @param   count                   [IN]        像素数
+ */
+void rgb24_deinterleave(const uint8_t* rgb, uint8_t* r, uint8_t* g, uint8_t* b, int count);
+
+/**
+ * @brief   R、G、B 三个平面交织为 RGB24 打包像素
+ * @param   r                       [IN]        R 平面，count 字节
+ * @param   g                       [IN]        G 平面，count 字节
+ * @param   b                       [IN]        B 平面，count 字节
+ * @param   rgb                     [OUT]       RGB24 数据，count * 3 字节
+ * @param   count                   [IN]        像素数
+ */
+void rgb24_interleave(const uint8_t* r, const uint8_t* g, const uint8_t* b, uint8_t* rgb, int count);
+
+/**
+ * @brief   RGB24 分离/合并内核的吞吐测试（多种分辨率，对比标量实现）
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int rgb24_planar_benchmark();
+
+#endif
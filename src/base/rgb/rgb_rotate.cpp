@@ -0,0 +1,115 @@
+#include <cstring>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "rgb_rotate.h"
+
+void rgb24_rotate(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, RotateMode mode)
+{
+    rotate_plane<3>(src, srcStride, dst, dstStride, width, height, mode);
+}
+
+void rgba_rotate(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, RotateMode mode)
+{
+    rotate_plane<4>(src, srcStride, dst, dstStride, width, height, mode);
+}
+
+int rgb_rotate_benchmark()
+{
+    constexpr int    kIterations = 10;
+    const int        sizes[][2]  = {{1920, 1080}, {3840, 2160}};
+    const RotateMode modes[]     = {ROTATE_90, ROTATE_180, ROTATE_FLIP_H, ROTATE_TRANSPOSE};
+    int              ret         = 0;
+
+    for (const auto& size : sizes)
+    {
+        int    width  = size[0];
+        int    height = size[1];
+        size_t bytes  = static_cast<size_t>(width) * height * 4;
+
+        AlignedBuffer<uint8_t> src(bytes);
+        AlignedBuffer<uint8_t> dst(bytes);
+        AlignedBuffer<uint8_t> reference(bytes);
+        for (size_t i = 0; i < bytes; i++)
+        {
+            src[i] = static_cast<uint8_t>(i * 7 + (i >> 9));
+        }
+
+        for (RotateMode mode : modes)
+        {
+            int dstWidth = rotate_swaps_axes(mode) ? height : width;
+            for (int bpp = 3; bpp <= 4; bpp++)
+            {
+                auto rotate = [&] {
+                    if (bpp == 3)
+                    {
+                        rgb24_rotate(src.Data(), width * 3, dst.Data(), dstWidth * 3, width, height, mode);
+                    }
+                    else
+                    {
+                        rgba_rotate(src.Data(), width * 4, dst.Data(), dstWidth * 4, width, height, mode);
+                    }
+                };
+                auto scalar = [&] {
+                    if (bpp == 3)
+                    {
+                        rotate_plane_c<3>(src.Data(), width * 3, reference.Data(), dstWidth * 3, width, height, mode);
+                    }
+                    else
+                    {
+                        rotate_plane_c<4>(src.Data(), width * 4, reference.Data(), dstWidth * 4, width, height, mode);
+                    }
+                };
+
+                rotate();
+                scalar();
+                size_t frameBytes = static_cast<size_t>(width) * height * bpp;
+                if (memcmp(dst.Data(), reference.Data(), frameBytes) != 0)
+                {
+                    SPDLOG_ERROR("{} {} {}x{}: result mismatch", bpp == 3 ? "RGB24" : "RGBA", rotate_mode_name(mode), width, height);
+                    ret = -1;
+                }
+                double fast  = benchmark_seconds(rotate, kIterations);
+                double naive = benchmark_seconds(scalar, kIterations);
+                SPDLOG_INFO("{} {} {}x{}: {:.0f} fps (scalar {:.0f} fps)", bpp == 3 ? "RGB24" : "RGBA", rotate_mode_name(mode), width, height, 1.0 / fast, 1.0 / naive);
+            }
+        }
+    }
+
+    return ret;
+}
+
+int simplest_rgb24_rotate(const std::string& filename, int width, int height, RotateMode mode, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + "." + rotate_mode_name(mode), std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int dstWidth  = rotate_swaps_axes(mode) ? height : width; // 旋转后的宽度
+    int frameSize = width * height * 3;                       // RGB24每帧大小
+
+    AlignedBuffer<uint8_t> src(frameSize);
+    AlignedBuffer<uint8_t> dst(frameSize);
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(src.Data()), frameSize))
+        {
+            break;
+        }
+        rgb24_rotate(src.Data(), width * 3, dst.Data(), dstWidth * 3, width, height, mode);
+        oFile.write(reinterpret_cast<char*>(dst.Data()), frameSize);
+    }
+
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
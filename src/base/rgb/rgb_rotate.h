@@ -0,0 +1,47 @@
+#ifndef __RGB_ROTATE_H__
+#define __RGB_ROTATE_H__
+
+#include <cstdint>
+#include <string>
+
+#include "base/common/rotate.hpp"
+
+/**
+ * @brief   旋转/翻转 RGB24 图像
+ * 转置类按 32x32 像素分块，3 字节像素没有整块的 SIMD 转置，块内逐像素拷贝；水平翻转逐像素颠倒
+ * @param   src                     [IN]        源图像
+ * @param   srcStride               [IN]        源图像行跨度（字节）
+ * @param   dst                     [OUT]       目标图像，转置类的宽高互换，不能与 src 重叠
+ * @param   dstStride               [IN]        目标图像行跨度（字节）
+ * @param   width                   [IN]        源图像宽度
+ * @param   height                  [IN]        源图像高度
+ * @param   mode                    [IN]        旋转方式
+ */
+void rgb24_rotate(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, RotateMode mode);
+
+/**
+ * @brief   旋转/翻转 RGBA（任意 4 字节像素）图像
+ * 转置类用 4x4 的 32 位块转置（SSE2 / NEON），水平翻转每次颠倒 4 个像素，参数同 rgb24_rotate
+ */
+void rgba_rotate(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, RotateMode mode);
+
+/**
+ * @brief   RGB24 / RGBA 旋转吞吐测试（1080p / 4K，对比逐像素标量实现）
+ * @return  0                                   成功
+ *          其他                                结果与标量实现不一致
+ */
+int rgb_rotate_benchmark();
+
+/**
+ * @brief   旋转/翻转RGB24像素数据，写入 <filename>.rot90 / .fliph 等（扩展名见 rotate_mode_name）
+ * @param   filename                [IN]        RGB24 输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   mode                    [IN]        旋转方式
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_rgb24_rotate(const std::string& filename, int width, int height, RotateMode mode, int number);
+
+#endif
@@ -1,6 +1,18 @@
 #include <string>
 
 #include "yuv.h"
+#include "yuv_convert.h"
+#include "yuv_deinterlace.h"
+#include "yuv_denoise.h"
+#include "yuv_filter.h"
+#include "yuv_lut.h"
+#include "yuv_motion.h"
+#include "yuv_overlay.h"
+#include "yuv_pattern.h"
+#include "yuv_rotate.h"
+#include "yuv_scale.h"
+#include "yuv_ssim.h"
+#include "yuv_stats.h"
 
 int main(int argc, char* argv[])
 {
@@ -28,11 +40,95 @@ int main(int argc, char* argv[])
     // 将YUV420P像素数据的周围加上边框
     simplest_yuv420_border(yuv420p, 256, 256, 20, 1);
 
+    // 旋转/翻转（手机竖拍素材编码前转正），以及 1080p/4K 吞吐测试
+    simplest_yuv420_rotate(yuv420p, 256, 256, ROTATE_90, 1);
+    simplest_yuv420_rotate(yuv420p, 256, 256, ROTATE_FLIP_H, 1);
+    rotate_benchmark();
+
+    // 滤镜链：每帧读一次，在同一块画布上依次完成所有处理
+    YuvFilterChain<uint8_t> chain(256, 256);
+    chain.Crop(32, 32, 192, 192).ScaleLuma(3, 4).Pad(32, 16, 32, 16).Border(4, 235);
+    chain.Run(yuv420p, yuv420p + ".filter", 1);
+
+    // 叠加预乘 RGBA 台标（固定一个、移动一个），以及 1080p 多图层吞吐测试
+    simplest_yuv420_overlay(yuv420p, 256, 256, filepath + "logo_64x32_rgba.rgba", 64, 32, 10);
+    overlay_benchmark();
+
+    // 查表调色（伽马、对比度、亮度）
+    simplest_yuv420_grade(yuv420p, 256, 256, 1.8, 1.1, 0.0, 1);
+
+    // 查表内核吞吐测试
+    lut_benchmark();
+
     // 生成YUV420P格式的灰阶测试图
     simplest_yuv420_graybar(640, 360, 0, 255, 10);
 
+    // 生成测试图序列（SMPTE彩条、渐变、波带片、运动方块、噪声）
+    simplest_yuv_pattern(PATTERN_SMPTE_BARS, YUV_FORMAT_I420, 1280, 720, 25);
+    simplest_yuv_pattern(PATTERN_GRADIENT_V, YUV_FORMAT_NV12, 640, 360, 10);
+    simplest_yuv_pattern(PATTERN_ZONE_PLATE, YUV_FORMAT_I420, 640, 360, 32);
+    simplest_yuv_pattern(PATTERN_MOVING_BOX, YUV_FORMAT_I422, 640, 360, 100);
+    simplest_yuv_pattern(PATTERN_NOISE, YUV_FORMAT_I420, 640, 360, 10);
+
+    // 生成10位测试图（yuv420p10le 与 P010）
+    simplest_yuv_pattern(PATTERN_ZONE_PLATE, YUV_FORMAT_I420, 640, 360, 10, 10);
+    simplest_yuv_pattern(PATTERN_SMPTE_BARS, YUV_FORMAT_NV12, 640, 360, 10, 10);
+
+    // 逐帧统计：直方图、均值方差、黑帧/静止帧/场景切换检测
+    simplest_yuv_stats("pattern_smptebars_1280x720.i420", YUV_FORMAT_I420, 1280, 720, 25);
+    simplest_yuv_stats("pattern_movingbox_640x360.i422", YUV_FORMAT_I422, 640, 360, 100);
+    simplest_yuv_stats("pattern_gradient_v_640x360.nv12", YUV_FORMAT_NV12, 640, 360, 10);
+
+    // 运动估计：逐帧复杂度（运动方块序列），以及 1080p 吞吐测试
+    simplest_yuv_pattern(PATTERN_MOVING_BOX, YUV_FORMAT_I420, 640, 360, 10);
+    simplest_yuv420_motion("pattern_movingbox_640x360.i420", 640, 360, 16, MOTION_SEARCH_HEX, 10);
+    simplest_yuv420_motion("pattern_zoneplate_640x360.i420", 640, 360, 8, MOTION_SEARCH_DIAMOND, 10);
+    motion_benchmark();
+
+    // 场拆分/合成，以及运动序列的去隔行（bob 场率输出、blend、YADIF）
+    simplest_yuv420_field_split(yuv420p, 256, 256, 1);
+    simplest_yuv420_field_merge(yuv420p + ".top", yuv420p + ".bottom", 256, 256, 1);
+    simplest_yuv420_deinterlace("pattern_movingbox_640x360.i420", 640, 360, DEINTERLACE_BOB, FIELD_ORDER_TFF, true, 10);
+    simplest_yuv420_deinterlace("pattern_movingbox_640x360.i420", 640, 360, DEINTERLACE_BLEND, FIELD_ORDER_TFF, false, 10);
+    simplest_yuv420_deinterlace("pattern_movingbox_640x360.i420", 640, 360, DEINTERLACE_YADIF, FIELD_ORDER_TFF, false, 10);
+    deinterlace_benchmark();
+
+    // 时域降噪（两帧参考），以及 1080p 加噪序列的 PSNR 和吞吐测试
+    simplest_yuv420_denoise("pattern_movingbox_640x360.i420", 640, 360, 2, 192, 10);
+    denoise_benchmark();
+
     // 计算两个YUV420P像素数据的PSNR
     simplest_yuv420_psnr(yuv420p, yuv420p_distort, 256, 256, 1);
 
+    // 计算两个YUV420P像素数据的SSIM
+    simplest_yuv420_ssim(yuv420p, yuv420p_distort, 256, 256, 1);
+
+    // 计算两个YUV420P像素数据的MS-SSIM
+    simplest_yuv420_msssim(yuv420p, yuv420p_distort, 256, 256, 1);
+
+    // 10位处理：8位扩展为 yuv420p10le，再做分离、去色、加边框、PSNR 和 P010 互转
+    simplest_yuv420_to_yuv420p10(yuv420p, 256, 256, 1);
+    simplest_yuv420_to_yuv420p10(yuv420p_distort, 256, 256, 1);
+    simplest_yuv420p10_split(yuv420p + ".yuv420p10le", 256, 256, 1);
+    simplest_yuv420p10_gray(yuv420p + ".yuv420p10le", 256, 256, 1);
+    simplest_yuv420p10_border(yuv420p + ".yuv420p10le", 256, 256, 20, 1);
+    simplest_yuv420p10_psnr(yuv420p + ".yuv420p10le", yuv420p_distort + ".yuv420p10le", 256, 256, 1);
+    simplest_yuv420p10_to_p010(yuv420p + ".yuv420p10le", 256, 256, 1);
+    simplest_p010_to_yuv420p10(yuv420p + ".yuv420p10le.p010", 256, 256, 1);
+
+    // 缩放YUV420P像素数据
+    simplest_yuv420_scale(yuv420p, 256, 256, 640, 360, SCALE_FILTER_LANCZOS, 1);
+    simplest_yuv420_scale(yuv420p, 256, 256, 128, 128, SCALE_FILTER_BICUBIC, 1);
+
+    // YUV像素格式转换（420P/422P/444P/NV12/NV21）
+    simplest_yuv_convert(yuv420p, 256, 256, YUV_FORMAT_I420, YUV_FORMAT_NV12, 1);
+    simplest_yuv_convert(yuv420p + ".nv12", 256, 256, YUV_FORMAT_NV12, YUV_FORMAT_I420, 1);
+    simplest_yuv_convert(yuv444p, 256, 256, YUV_FORMAT_I444, YUV_FORMAT_I420, 1);
+    simplest_yuv_convert(yuv420p, 256, 256, YUV_FORMAT_I420, YUV_FORMAT_I444, 1);
+
+    // 10位格式转换（yuv420p10le -> 444P10 / P010）
+    simplest_yuv_convert(yuv420p + ".yuv420p10le", 256, 256, YUV_FORMAT_I420, YUV_FORMAT_I444, 1, 10);
+    simplest_yuv_convert(yuv420p + ".yuv420p10le", 256, 256, YUV_FORMAT_I420, YUV_FORMAT_NV12, 1, 10);
+
     return 0;
 }
\ No newline at end of file
@@ -4,268 +4,287 @@
 #include <spdlog/spdlog.h>
 
 #include "yuv.h"
+#include "yuv_filter.h"
+#include "yuv_pattern.h"
+#include "yuv_plane.h"
 
-int simplest_yuv420_split(const std::string& filename, int width, int height, int number)
+namespace
 {
-    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
-    std::ofstream yFile(filename + ".y", std::ios::out | std::ios::binary);
-    std::ofstream uFile(filename + ".u", std::ios::out | std::ios::binary);
-    std::ofstream vFile(filename + ".v", std::ios::out | std::ios::binary);
-    if (!iFile.is_open())
+    constexpr int kDepth10 = 10;
+
+    /**
+     * 分离平面格式中的Y、U、V分量，T 为采样类型（uint8_t 或低位对齐的 uint16_t）
+     */
+    template <typename T>
+    int yuv_split(const std::string& filename, int width, int height, int chromaWidth, int chromaHeight, int number)
     {
-        SPDLOG_ERROR("Failed to open file: {}", filename);
-        return -1;
-    }
+        std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+        std::ofstream yFile(filename + ".y", std::ios::out | std::ios::binary);
+        std::ofstream uFile(filename + ".u", std::ios::out | std::ios::binary);
+        std::ofstream vFile(filename + ".v", std::ios::out | std::ios::binary);
+        if (!iFile.is_open())
+        {
+            SPDLOG_ERROR("Failed to open file: {}", filename);
+            return -1;
+        }
 
-    int   frameSize = width * height * 3 / 2; // YUV420P每帧大小
-    int   ySize     = width * height;         // Y分量大小
-    char* frame     = new char[frameSize];
+        size_t ySize     = static_cast<size_t>(width) * height * sizeof(T);             // Y分量字节数
+        size_t cSize     = static_cast<size_t>(chromaWidth) * chromaHeight * sizeof(T); // U/V分量字节数
+        size_t frameSize = ySize + cSize * 2;                                           // 每帧字节数
+        char*  frame     = new char[frameSize];
 
-    for (int i = 0; i < number; i++)
-    {
-        iFile.read(frame, frameSize);
-        yFile.write(frame, ySize);
-        uFile.write(frame + ySize, ySize / 4);
-        vFile.write(frame + ySize + ySize / 4, ySize / 4);
-    }
+        for (int i = 0; i < number; i++)
+        {
+            if (!iFile.read(frame, frameSize))
+            {
+                break;
+            }
+            yFile.write(frame, ySize);
+            uFile.write(frame + ySize, cSize);
+            vFile.write(frame + ySize + cSize, cSize);
+        }
 
-    delete[] frame;
-    iFile.close();
-    yFile.close();
-    uFile.close();
-    vFile.close();
+        delete[] frame;
+        iFile.close();
+        yFile.close();
+        uFile.close();
+        vFile.close();
 
-    return 0;
-}
+        return 0;
+    }
 
-int simplest_yuv422_split(const std::string& filename, int width, int height, int number)
-{
-    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
-    std::ofstream yFile(filename + ".y", std::ios::out | std::ios::binary);
-    std::ofstream uFile(filename + ".u", std::ios::out | std::ios::binary);
-    std::ofstream vFile(filename + ".v", std::ios::out | std::ios::binary);
-    if (!iFile.is_open())
+    /**
+     * 逐帧计算亮度 PSNR，峰值为 (1 << bitDepth) - 1
+     */
+    template <typename T>
+    int yuv420_psnr(const std::string& filename1, const std::string& filename2, int width, int height, int bitDepth, int number)
     {
-        SPDLOG_ERROR("Failed to open file: {}", filename);
-        return -1;
-    }
+        std::ifstream iFile1(filename1, std::ios::in | std::ios::binary);
+        std::ifstream iFile2(filename2, std::ios::in | std::ios::binary);
+        if (!iFile1.is_open() || !iFile2.is_open())
+        {
+            SPDLOG_ERROR("Failed to open file: {} or {}", filename1, filename2);
+            return -1;
+        }
 
-    int   frameSize = width * height * 2; // YUV422P每帧大小
-    int   ySize     = width * height;     // Y分量大小
-    char* frame     = new char[frameSize];
+        int    frameSize = width * height * 3 / 2; // YUV420P每帧采样数
+        T*     frame1    = new T[frameSize];
+        T*     frame2    = new T[frameSize];
+        double peak      = static_cast<double>((1 << bitDepth) - 1);
 
-    for (int i = 0; i < number; i++)
-    {
-        iFile.read(frame, frameSize);
-        yFile.write(frame, ySize);
-        uFile.write(frame + ySize, ySize / 2);
-        vFile.write(frame + ySize + ySize / 2, ySize / 2);
+        for (int i = 0; i < number; i++)
+        {
+            if (!iFile1.read(reinterpret_cast<char*>(frame1), frameSize * sizeof(T)) || !iFile2.read(reinterpret_cast<char*>(frame2), frameSize * sizeof(T)))
+            {
+                break;
+            }
+
+            double mse  = static_cast<double>(plane_sse<T>(frame1, width, frame2, width, width, height)) / (static_cast<double>(width) * height);
+            double psnr = 10 * log10((peak * peak) / mse);
+            SPDLOG_INFO("Frame {}: PSNR = {:.2f} dB", i, psnr);
+        }
+
+        delete[] frame1;
+        delete[] frame2;
+        iFile1.close();
+        iFile2.close();
+
+        return 0;
     }
+} // namespace
 
-    delete[] frame;
-    iFile.close();
-    yFile.close();
-    uFile.close();
-    vFile.close();
+int simplest_yuv420_split(const std::string& filename, int width, int height, int number)
+{
+    return yuv_split<uint8_t>(filename, width, height, width / 2, height / 2, number);
+}
 
-    return 0;
+int simplest_yuv422_split(const std::string& filename, int width, int height, int number)
+{
+    return yuv_split<uint8_t>(filename, width, height, width / 2, height, number);
 }
 
 int simplest_yuv444_split(const std::string& filename, int width, int height, int number)
 {
-    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
-    std::ofstream yFile(filename + ".y", std::ios::out | std::ios::binary);
-    std::ofstream uFile(filename + ".u", std::ios::out | std::ios::binary);
-    std::ofstream vFile(filename + ".v", std::ios::out | std::ios::binary);
-    if (!iFile.is_open())
-    {
-        SPDLOG_ERROR("Failed to open file: {}", filename);
-        return -1;
-    }
-
-    int   frameSize = width * height * 3; // YUV444P每帧大小
-    int   ySize     = width * height;     // Y分量大小
-    char* frame     = new char[frameSize];
+    return yuv_split<uint8_t>(filename, width, height, width, height, number);
+}
 
-    for (int i = 0; i < number; i++)
-    {
-        iFile.read(frame, frameSize);
-        yFile.write(frame, ySize);
-        uFile.write(frame + ySize, ySize);
-        vFile.write(frame + ySize + ySize, ySize);
-    }
+int simplest_yuv420_gray(const std::string& filename, int width, int height, int number)
+{
+    // u和v分量设为128
+    YuvFilterChain<uint8_t> chain(width, height);
+    chain.Gray();
+    return chain.Run(filename, filename + ".gray", number);
+}
 
-    delete[] frame;
-    iFile.close();
-    yFile.close();
-    uFile.close();
-    vFile.close();
+int simplest_yuv420_halfy(const std::string& filename, int width, int height, int number)
+{
+    YuvFilterChain<uint8_t> chain(width, height);
+    chain.ScaleLuma(1, 2);
+    return chain.Run(filename, filename + ".halfy", number);
+}
 
-    return 0;
+int simplest_yuv420_border(const std::string& filename, int width, int height, int border, int number)
+{
+    // Y分量设为0（黑色）
+    YuvFilterChain<uint8_t> chain(width, height);
+    chain.Border(border, 0);
+    return chain.Run(filename, filename + ".border", number);
 }
 
-int simplest_yuv420_gray(const std::string& filename, int width, int height, int number)
+int simplest_yuv420_graybar(int width, int height, int min, int max, int number)
 {
-    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
-    std::ofstream oFile(filename + ".gray", std::ios::out | std::ios::binary);
-    if (!iFile.is_open())
+    std::string filename = fmt::format("graybar_{}x{}.yuv", width, height);
+    std::ofstream oFile(filename, std::ios::out | std::ios::binary);
+    if (!oFile.is_open())
     {
         SPDLOG_ERROR("Failed to open file: {}", filename);
         return -1;
     }
 
-    int   frameSize = width * height * 3 / 2; // YUV420P每帧大小
-    char* frame     = new char[frameSize];
+    // 渐变是静态图样，只构建一次（亮度整行拷贝，色度置为 128），之后每帧直接写出
+    PatternGenerator generator(PATTERN_GRADIENT_H, YUV_FORMAT_I420, width, height);
+    generator.SetLevels(min, max);
+    const YuvFrame& frame = generator.Render(0);
 
     for (int i = 0; i < number; i++)
     {
-        iFile.read(frame, frameSize);
-        // u和v分量设为128
-        memset(frame + width * height, 128, width * height / 2);
-        oFile.write(frame, width * height);
+        oFile.write(reinterpret_cast<const char*>(frame.data[0]), generator.FrameSize());
     }
 
-    delete[] frame;
-    iFile.close();
     oFile.close();
 
     return 0;
 }
 
-int simplest_yuv420_halfy(const std::string& filename, int width, int height, int number)
+int simplest_yuv420_psnr(const std::string& filename1, const std::string& filename2, int width, int height, int number)
+{
+    return yuv420_psnr<uint8_t>(filename1, filename2, width, height, 8, number);
+}
+
+int simplest_yuv420_to_yuv420p10(const std::string& filename, int width, int height, int number)
 {
     std::ifstream iFile(filename, std::ios::in | std::ios::binary);
-    std::ofstream oFile(filename + ".halfy", std::ios::out | std::ios::binary);
+    std::ofstream oFile(filename + ".yuv420p10le", std::ios::out | std::ios::binary);
     if (!iFile.is_open())
     {
         SPDLOG_ERROR("Failed to open file: {}", filename);
         return -1;
     }
 
-    int   frameSize = width * height * 3 / 2; // YUV420P每帧大小
-    char* frame     = new char[frameSize];
+    int       frameSize = width * height * 3 / 2; // YUV420P每帧采样数
+    uint8_t*  src       = new uint8_t[frameSize];
+    uint16_t* dst       = new uint16_t[frameSize];
 
     for (int i = 0; i < number; i++)
     {
-        iFile.read(frame, frameSize);
-        for (int j = 0; j < width * height; j++)
+        if (!iFile.read(reinterpret_cast<char*>(src), frameSize))
         {
-            int y    = static_cast<unsigned char>(frame[j]);
-            frame[j] = static_cast<char>(y / 2);
+            break;
         }
-        oFile.write(frame, width * height);
+        // 三个平面连续存储，当作一个宽为 width、高为 1.5 * height 的平面处理
+        plane_widen(src, width, dst, width, width, height * 3 / 2, kDepth10 - 8);
+        oFile.write(reinterpret_cast<const char*>(dst), frameSize * sizeof(uint16_t));
     }
 
-    delete[] frame;
+    delete[] src;
+    delete[] dst;
     iFile.close();
     oFile.close();
 
     return 0;
 }
 
-int simplest_yuv420_border(const std::string& filename, int width, int height, int border, int number)
+int simplest_yuv420p10_split(const std::string& filename, int width, int height, int number)
 {
-    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
-    std::ofstream oFile(filename + ".border", std::ios::out | std::ios::binary);
-    if (!iFile.is_open())
-    {
-        SPDLOG_ERROR("Failed to open file: {}", filename);
-        return -1;
-    }
-
-    int   frameSize = width * height * 3 / 2; // YUV420P每帧大小
-    char* frame     = new char[frameSize];
+    return yuv_split<uint16_t>(filename, width, height, width / 2, height / 2, number);
+}
 
-    for (int i = 0; i < number; i++)
-    {
-        iFile.read(frame, frameSize);
-        // 添加边框
-        for (int y = 0; y < height; y++)
-        {
-            for (int x = 0; x < width; x++)
-            {
-                if (x < border || x >= width - border || y < border || y >= height - border)
-                {
-                    frame[y * width + x] = 0; // Y分量设为0（黑色）
-                }
-            }
-        }
-        oFile.write(frame, frameSize);
-    }
+int simplest_yuv420p10_gray(const std::string& filename, int width, int height, int number)
+{
+    // u和v分量设为 512（10位中性色度）
+    YuvFilterChain<uint16_t> chain(width, height, kDepth10);
+    chain.Gray();
+    return chain.Run(filename, filename + ".gray", number);
+}
 
-    delete[] frame;
-    iFile.close();
-    oFile.close();
+int simplest_yuv420p10_border(const std::string& filename, int width, int height, int border, int number)
+{
+    // Y分量设为0（黑色）
+    YuvFilterChain<uint16_t> chain(width, height, kDepth10);
+    chain.Border(border, 0);
+    return chain.Run(filename, filename + ".border", number);
+}
 
-    return 0;
+int simplest_yuv420p10_psnr(const std::string& filename1, const std::string& filename2, int width, int height, int number)
+{
+    return yuv420_psnr<uint16_t>(filename1, filename2, width, height, kDepth10, number);
 }
 
-int simplest_yuv420_graybar(int width, int height, int min, int max, int number)
+int simplest_yuv420p10_to_p010(const std::string& filename, int width, int height, int number)
 {
-    std::string filename = fmt::format("graybar_{}x{}.yuv", width, height);
-    std::ofstream oFile(filename, std::ios::out | std::ios::binary);
-    if (!oFile.is_open())
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + ".p010", std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
     {
         SPDLOG_ERROR("Failed to open file: {}", filename);
         return -1;
     }
 
-    int   frameSize = width * height * 3 / 2; // YUV420P每帧大小
-    char* frame     = new char[frameSize];
+    int       ySize     = width * height;         // Y分量采样数
+    int       frameSize = width * height * 3 / 2; // 每帧采样数（两种格式相同）
+    uint16_t* src       = new uint16_t[frameSize];
+    uint16_t* dst       = new uint16_t[frameSize];
 
     for (int i = 0; i < number; i++)
     {
-        for (int y = 0; y < height; y++)
+        if (!iFile.read(reinterpret_cast<char*>(src), frameSize * sizeof(uint16_t)))
         {
-            for (int x = 0; x < width; x++)
-            {
-                int gray = min + (max - min) * x / width;
-                frame[y * width + x] = static_cast<char>(gray);
-            }
+            break;
         }
-        oFile.write(frame, frameSize);
+        // P010：10位有效数据放在16位的高位，色度 UV 交织
+        plane_shift(src, width, dst, width, width, height, 16 - kDepth10);
+        p010_uv_interleave(src + ySize, width / 2, src + ySize + ySize / 4, width / 2, dst + ySize, width, width / 2, height / 2);
+        oFile.write(reinterpret_cast<const char*>(dst), frameSize * sizeof(uint16_t));
     }
 
-    delete[] frame;
+    delete[] src;
+    delete[] dst;
+    iFile.close();
     oFile.close();
 
     return 0;
 }
 
-int simplest_yuv420_psnr(const std::string& filename1, const std::string& filename2, int width, int height, int number)
+int simplest_p010_to_yuv420p10(const std::string& filename, int width, int height, int number)
 {
-    std::ifstream iFile1(filename1, std::ios::in | std::ios::binary);
-    std::ifstream iFile2(filename2, std::ios::in | std::ios::binary);
-    if (!iFile1.is_open() || !iFile2.is_open())
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + ".yuv420p10le", std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
     {
-        SPDLOG_ERROR("Failed to open file: {} or {}", filename1, filename2);
+        SPDLOG_ERROR("Failed to open file: {}", filename);
         return -1;
     }
 
-    int   frameSize = width * height * 3 / 2; // YUV420P每帧大小
-    char* frame1    = new char[frameSize];
-    char* frame2    = new char[frameSize];
+    int       ySize     = width * height;         // Y分量采样数
+    int       frameSize = width * height * 3 / 2; // 每帧采样数（两种格式相同）
+    uint16_t* src       = new uint16_t[frameSize];
+    uint16_t* dst       = new uint16_t[frameSize];
 
     for (int i = 0; i < number; i++)
     {
-        iFile1.read(frame1, frameSize);
-        iFile2.read(frame2, frameSize);
-
-        double mse = 0.0;
-        for (int j = 0; j < width * height; j++)
+        if (!iFile.read(reinterpret_cast<char*>(src), frameSize * sizeof(uint16_t)))
         {
-            int diff = static_cast<int>(frame1[j]) - static_cast<int>(frame2[j]);
-            mse += std::pow(diff, 2);
+            break;
         }
-        mse /= (width * height);
-        double psnr = 10 * log10((255.0 * 255.0) / mse);
-        SPDLOG_INFO("Frame {}: PSNR = {:.2f} dB", i, psnr);
+        plane_shift(src, width, dst, width, width, height, kDepth10 - 16);
+        p010_uv_deinterleave(src + ySize, width, dst + ySize, width / 2, dst + ySize + ySize / 4, width / 2, width / 2, height / 2);
+        oFile.write(reinterpret_cast<const char*>(dst), frameSize * sizeof(uint16_t));
     }
 
-    delete[] frame1;
-    delete[] frame2;
-    iFile1.close();
-    iFile2.close();
+    delete[] src;
+    delete[] dst;
+    iFile.close();
+    oFile.close();
 
     return 0;
-}
\ No newline at end of file
+}
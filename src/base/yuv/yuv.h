@@ -94,4 +94,83 @@ int simplest_yuv420_graybar(int width, int height, int min, int max, int number)
  */
 int simplest_yuv420_psnr(const std::string& filename1, const std::string& filename2, int width, int height, int number);
 
+/**
+ * @brief   YUV420P 8位转换为 10 位低位对齐的 yuv420p10le（左移2位）
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_to_yuv420p10(const std::string& filename, int width, int height, int number);
+
+/**
+ * @brief   分离 yuv420p10le 像素数据中的Y、U、V分量（每个采样2字节）
+ * @param   filename                [IN]        yuv420p10le 输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420p10_split(const std::string& filename, int width, int height, int number);
+
+/**
+ * @brief   将 yuv420p10le 像素数据去掉颜色（色度置为512）
+ * @param   filename                [IN]        yuv420p10le 输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420p10_gray(const std::string& filename, int width, int height, int number);
+
+/**
+ * @brief   将 yuv420p10le 像素数据的周围加上边框
+ * @param   filename                [IN]        yuv420p10le 输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   border                  [IN]        边框的宽度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420p10_border(const std::string& filename, int width, int height, int border, int number);
+
+/**
+ * @brief   计算两个 yuv420p10le 像素数据的亮度 PSNR（峰值 1023）
+ * @param   filename1               [IN]        yuv420p10le 输入文件路径1
+ * @param   filename2               [IN]        yuv420p10le 输入文件路径2
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420p10_psnr(const std::string& filename1, const std::string& filename2, int width, int height, int number);
+
+/**
+ * @brief   yuv420p10le 转换为 P010（高位对齐，UV 交织）
+ * @param   filename                [IN]        yuv420p10le 输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420p10_to_p010(const std::string& filename, int width, int height, int number);
+
+/**
+ * @brief   P010 转换为 yuv420p10le
+ * @param   filename                [IN]        P010 输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_p010_to_yuv420p10(const std::string& filename, int width, int height, int number);
+
 #endif
\ No newline at end of file
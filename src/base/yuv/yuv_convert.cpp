@@ -0,0 +1,718 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_convert.h"
+#include "yuv_plane.h"
+
+namespace
+{
+    constexpr int kMinRowsPerThread = 32;
+
+    template <typename T>
+    bool plane_overlaps(const T* a, int aStride, int aHeight, const T* b, int bStride, int bHeight)
+    {
+        const T* aEnd = a + static_cast<size_t>(aStride) * aHeight;
+        const T* bEnd = b + static_cast<size_t>(bStride) * bHeight;
+        return a < bEnd && b < aEnd;
+    }
+
+    template <typename T>
+    void copy_plane(const T* src, int srcStride, T* dst, int dstStride, int width, int height)
+    {
+        if (src == dst && srcStride == dstStride)
+        {
+            return;
+        }
+        for (int y = 0; y < height; y++)
+        {
+            memmove(dst + static_cast<size_t>(y) * dstStride, src + static_cast<size_t>(y) * srcStride, width * sizeof(T));
+        }
+    }
+
+    // out[i] = (s[2i-1] + 2 * s[2i] + s[2i+1] + 2) >> 2，顺序处理时可原地
+    void downsample_row_horizontal(const uint8_t* s, uint8_t* d, int srcWidth)
+    {
+        int dstWidth = (srcWidth + 1) / 2;
+        int last     = srcWidth - 1;
+        d[0]         = static_cast<uint8_t>((s[0] * 3 + s[std::min(1, last)] + 2) >> 2);
+        int i        = 1;
+#if SIMD_SSE2
+        const __m128i mask = _mm_set1_epi16(0x00ff);
+        const __m128i two  = _mm_set1_epi16(2);
+        for (; 2 * i + 16 <= srcWidth; i += 8)
+        {
+            __m128i cur  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * i));
+            __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * i - 1));
+            __m128i even = _mm_and_si128(cur, mask);
+            __m128i odd  = _mm_srli_epi16(cur, 8);
+            __m128i left = _mm_and_si128(prev, mask);
+            __m128i sum  = _mm_add_epi16(_mm_add_epi16(left, odd), _mm_add_epi16(_mm_add_epi16(even, even), two));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(d + i), _mm_packus_epi16(_mm_srli_epi16(sum, 2), sum));
+        }
+#endif
+        for (; i < dstWidth; i++)
+        {
+            d[i] = static_cast<uint8_t>((s[2 * i - 1] + 2 * s[2 * i] + s[std::min(2 * i + 1, last)] + 2) >> 2);
+        }
+    }
+
+    void downsample_row_horizontal(const uint16_t* s, uint16_t* d, int srcWidth)
+    {
+        int dstWidth = (srcWidth + 1) / 2;
+        int last     = srcWidth - 1;
+        d[0]         = static_cast<uint16_t>((s[0] * 3 + s[std::min(1, last)] + 2) >> 2);
+        int i        = 1;
+#if SIMD_SSE2
+        // 16 位满幅时和会超出 16 位，在 32 位通道中计算；SSE2 没有无符号 packus_epi32，偏移 32768 后用有符号 packs
+        const __m128i mask = _mm_set1_epi32(0xffff);
+        const __m128i two  = _mm_set1_epi32(2);
+        const __m128i bias = _mm_set1_epi32(32768);
+        const __m128i sign = _mm_set1_epi16(static_cast<short>(0x8000));
+        for (; 2 * i + 16 <= srcWidth; i += 8)
+        {
+            __m128i sum[2];
+            for (int k = 0; k < 2; k++)
+            {
+                __m128i cur  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * i + 8 * k));
+                __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * i + 8 * k - 1));
+                __m128i even = _mm_and_si128(cur, mask);
+                __m128i odd  = _mm_srli_epi32(cur, 16);
+                __m128i left = _mm_and_si128(prev, mask);
+                __m128i acc  = _mm_add_epi32(_mm_add_epi32(left, odd), _mm_add_epi32(_mm_add_epi32(even, even), two));
+                sum[k]       = _mm_sub_epi32(_mm_srli_epi32(acc, 2), bias);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_xor_si128(_mm_packs_epi32(sum[0], sum[1]), sign));
+        }
+#endif
+        for (; i < dstWidth; i++)
+        {
+            d[i] = static_cast<uint16_t>((s[2 * i - 1] + 2 * s[2 * i] + s[std::min(2 * i + 1, last)] + 2) >> 2);
+        }
+    }
+
+    // out[2i] = s[i]，out[2i+1] = (s[i] + s[i+1] + 1) >> 1
+    void upsample_row_horizontal(const uint8_t* s, uint8_t* d, int srcWidth)
+    {
+        int i = 0;
+#if SIMD_SSE2
+        for (; i + 17 <= srcWidth; i += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 1));
+            __m128i m = _mm_avg_epu8(a, b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * i), _mm_unpacklo_epi8(a, m));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * i + 16), _mm_unpackhi_epi8(a, m));
+        }
+#endif
+        for (; i < srcWidth; i++)
+        {
+            int next     = s[std::min(i + 1, srcWidth - 1)];
+            d[2 * i]     = s[i];
+            d[2 * i + 1] = static_cast<uint8_t>((s[i] + next + 1) >> 1);
+        }
+    }
+
+    void upsample_row_horizontal(const uint16_t* s, uint16_t* d, int srcWidth)
+    {
+        int i = 0;
+#if SIMD_SSE2
+        for (; i + 9 <= srcWidth; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 1));
+            __m128i m = _mm_avg_epu16(a, b);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * i), _mm_unpacklo_epi16(a, m));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * i + 8), _mm_unpackhi_epi16(a, m));
+        }
+#endif
+        for (; i < srcWidth; i++)
+        {
+            int next     = s[std::min(i + 1, srcWidth - 1)];
+            d[2 * i]     = s[i];
+            d[2 * i + 1] = static_cast<uint16_t>((s[i] + next + 1) >> 1);
+        }
+    }
+
+    // d = (a + b + 1) >> 1，可原地
+    void average_row(const uint8_t* a, const uint8_t* b, uint8_t* d, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x), _mm_avg_epu8(va, vb));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            d[x] = static_cast<uint8_t>((a[x] + b[x] + 1) >> 1);
+        }
+    }
+
+    void average_row(const uint16_t* a, const uint16_t* b, uint16_t* d, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x), _mm_avg_epu16(va, vb));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            d[x] = static_cast<uint16_t>((a[x] + b[x] + 1) >> 1);
+        }
+    }
+
+    // d = (3 * near + far + 2) >> 2，可原地
+    void blend31_row(const uint8_t* nearRow, const uint8_t* farRow, uint8_t* d, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i two  = _mm_set1_epi16(2);
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i n   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nearRow + x));
+            __m128i f   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(farRow + x));
+            __m128i nLo = _mm_unpacklo_epi8(n, zero);
+            __m128i nHi = _mm_unpackhi_epi8(n, zero);
+            __m128i lo  = _mm_add_epi16(_mm_add_epi16(_mm_add_epi16(nLo, nLo), nLo), _mm_add_epi16(_mm_unpacklo_epi8(f, zero), two));
+            __m128i hi  = _mm_add_epi16(_mm_add_epi16(_mm_add_epi16(nHi, nHi), nHi), _mm_add_epi16(_mm_unpackhi_epi8(f, zero), two));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x), _mm_packus_epi16(_mm_srli_epi16(lo, 2), _mm_srli_epi16(hi, 2)));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            d[x] = static_cast<uint8_t>((3 * nearRow[x] + farRow[x] + 2) >> 2);
+        }
+    }
+
+    void blend31_row(const uint16_t* nearRow, const uint16_t* farRow, uint16_t* d, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        // (3n + f + 2) >> 2 == avg(n, (n + f) >> 1)，向下取整的均值 = pavgw - ((n ^ f) & 1)，全程不超出 16 位
+        const __m128i one = _mm_set1_epi16(1);
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i n     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nearRow + x));
+            __m128i f     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(farRow + x));
+            __m128i floor = _mm_sub_epi16(_mm_avg_epu16(n, f), _mm_and_si128(_mm_xor_si128(n, f), one));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x), _mm_avg_epu16(n, floor));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            d[x] = static_cast<uint16_t>((3 * nearRow[x] + farRow[x] + 2) >> 2);
+        }
+    }
+
+    void interleave_row(const uint8_t* pu, const uint8_t* pv, uint8_t* d, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pu + x));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pv + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * x), _mm_unpacklo_epi8(a, b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * x + 16), _mm_unpackhi_epi8(a, b));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            d[2 * x]     = pu[x];
+            d[2 * x + 1] = pv[x];
+        }
+    }
+
+    void interleave_row(const uint16_t* pu, const uint16_t* pv, uint16_t* d, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pu + x));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pv + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * x), _mm_unpacklo_epi16(a, b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * x + 8), _mm_unpackhi_epi16(a, b));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            d[2 * x]     = pu[x];
+            d[2 * x + 1] = pv[x];
+        }
+    }
+
+    void deinterleave_row(const uint8_t* s, uint8_t* pu, uint8_t* pv, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        const __m128i mask = _mm_set1_epi16(0x00ff);
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * x));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * x + 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pu + x), _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pv + x), _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            pu[x] = s[2 * x];
+            pv[x] = s[2 * x + 1];
+        }
+    }
+
+    void deinterleave_row(const uint16_t* s, uint16_t* pu, uint16_t* pv, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        // 16 位满幅不能用 packs，改用洗牌：每个寄存器内先排成 u0 u1 u2 u3 v0 v1 v2 v3，再按 64 位拼接
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * x));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * x + 8));
+            a         = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+            b         = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(b, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pu + x), _mm_unpacklo_epi64(a, b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pv + x), _mm_unpackhi_epi64(a, b));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            pu[x] = s[2 * x];
+            pv[x] = s[2 * x + 1];
+        }
+    }
+
+    /**
+     * @brief   把一个色度平面从 (sx, sy) 下采样倍数转换到 (dx, dy)
+     * 下采样先水平后垂直，上采样先垂直后水平，中间结果放在 scratch
+     */
+    template <typename T>
+    void resample_chroma_plane(const T* src, int srcStride, int srcWidth, int srcHeight, int sx, int sy,
+                               T* dst, int dstStride, int dx, int dy, std::vector<T>& scratch)
+    {
+        if (sx == dx && sy == dy)
+        {
+            copy_plane(src, srcStride, dst, dstStride, srcWidth, srcHeight);
+            return;
+        }
+
+        int midWidth = srcWidth;
+        if (dx > sx)
+        {
+            midWidth = (srcWidth + 1) / 2;
+        }
+        else if (dx < sx)
+        {
+            midWidth = srcWidth * 2;
+        }
+
+        // 水平下采样放在最前，水平上采样放在最后
+        const T* cur       = src;
+        int      curStride = srcStride;
+        int      curWidth  = srcWidth;
+        bool     lastStep  = (sy == dy);
+        if (dx > sx)
+        {
+            T*  out       = dst;
+            int outStride = dstStride;
+            if (!lastStep)
+            {
+                scratch.resize(static_cast<size_t>(midWidth) * srcHeight);
+                out       = scratch.data();
+                outStride = midWidth;
+            }
+            chroma_downsample_horizontal(cur, curStride, out, outStride, curWidth, srcHeight);
+            cur       = out;
+            curStride = outStride;
+            curWidth  = midWidth;
+        }
+
+        if (sy != dy)
+        {
+            bool hUpAfter  = dx < sx;
+            int  outHeight = dy > sy ? (srcHeight + 1) / 2 : srcHeight * 2;
+            T*   out       = dst;
+            int  outStride = dstStride;
+            if (hUpAfter)
+            {
+                scratch.resize(static_cast<size_t>(curWidth) * outHeight);
+                out       = scratch.data();
+                outStride = curWidth;
+            }
+            if (dy > sy)
+            {
+                chroma_downsample_vertical(cur, curStride, out, outStride, curWidth, srcHeight);
+            }
+            else
+            {
+                chroma_upsample_vertical(cur, curStride, out, outStride, curWidth, srcHeight);
+            }
+            cur       = out;
+            curStride = outStride;
+            srcHeight = outHeight;
+        }
+
+        if (dx < sx)
+        {
+            chroma_upsample_horizontal(cur, curStride, dst, dstStride, curWidth, srcHeight);
+        }
+    }
+} // namespace
+
+template <typename T>
+void chroma_downsample_horizontal(const T* src, int srcStride, T* dst, int dstStride, int srcWidth, int height)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            downsample_row_horizontal(src + static_cast<size_t>(y) * srcStride, dst + static_cast<size_t>(y) * dstStride, srcWidth);
+        }
+    };
+
+    // 原地且行跨度不同时，输出行 y 会落在输入行 y 之前的区域，只能从上到下串行
+    if (plane_overlaps(src, srcStride, height, dst, dstStride, height))
+    {
+        rows(0, height);
+        return;
+    }
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+template <typename T>
+void chroma_upsample_horizontal(const T* src, int srcStride, T* dst, int dstStride, int srcWidth, int height)
+{
+    // 原地时输出行比输入行宽，先把输入行拷到行缓冲区
+    bool inPlace = plane_overlaps(src, srcStride, height, dst, dstStride, height);
+    if (inPlace)
+    {
+        std::vector<T> line(srcWidth);
+        // 输出行 y 覆盖的范围不会早于输入行 y，倒序处理保证尚未读取的行不被覆盖
+        for (int y = height - 1; y >= 0; y--)
+        {
+            memcpy(line.data(), src + static_cast<size_t>(y) * srcStride, srcWidth * sizeof(T));
+            upsample_row_horizontal(line.data(), dst + static_cast<size_t>(y) * dstStride, srcWidth);
+        }
+        return;
+    }
+
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            upsample_row_horizontal(src + static_cast<size_t>(y) * srcStride, dst + static_cast<size_t>(y) * dstStride, srcWidth);
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+template <typename T>
+void chroma_downsample_vertical(const T* src, int srcStride, T* dst, int dstStride, int width, int srcHeight)
+{
+    int  dstHeight = (srcHeight + 1) / 2;
+    auto rows      = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            const T* r0 = src + static_cast<size_t>(2 * y) * srcStride;
+            const T* r1 = src + static_cast<size_t>(std::min(2 * y + 1, srcHeight - 1)) * srcStride;
+            average_row(r0, r1, dst + static_cast<size_t>(y) * dstStride, width);
+        }
+    };
+
+    // 原地时行带之间存在读写依赖，只能从上到下串行
+    if (plane_overlaps(src, srcStride, srcHeight, dst, dstStride, dstHeight))
+    {
+        rows(0, dstHeight);
+        return;
+    }
+    parallel_for_rows(dstHeight, rows, kMinRowsPerThread);
+}
+
+template <typename T>
+void chroma_upsample_vertical(const T* src, int srcStride, T* dst, int dstStride, int width, int srcHeight)
+{
+    auto row = [&](int y) {
+        const T* cur  = src + static_cast<size_t>(y) * srcStride;
+        const T* prev = src + static_cast<size_t>(std::max(y - 1, 0)) * srcStride;
+        const T* next = src + static_cast<size_t>(std::min(y + 1, srcHeight - 1)) * srcStride;
+        // 先写奇数行再写偶数行，原地时偶数行 2y 可能就是 cur 本身
+        blend31_row(cur, next, dst + static_cast<size_t>(2 * y + 1) * dstStride, width);
+        blend31_row(cur, prev, dst + static_cast<size_t>(2 * y) * dstStride, width);
+    };
+
+    // 原地时从下往上处理，保证读取的源行还没有被覆盖
+    if (plane_overlaps(src, srcStride, srcHeight, dst, dstStride, srcHeight * 2))
+    {
+        for (int y = srcHeight - 1; y >= 0; y--)
+        {
+            row(y);
+        }
+        return;
+    }
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            row(y);
+        }
+    };
+    parallel_for_rows(srcHeight, rows, kMinRowsPerThread);
+}
+
+template <typename T>
+void uv_interleave(const T* u, int uStride, const T* v, int vStride, T* uv, int uvStride, int width, int height)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            interleave_row(u + static_cast<size_t>(y) * uStride, v + static_cast<size_t>(y) * vStride, uv + static_cast<size_t>(y) * uvStride, width);
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+template <typename T>
+void uv_deinterleave(const T* uv, int uvStride, T* u, int uStride, T* v, int vStride, int width, int height)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            deinterleave_row(uv + static_cast<size_t>(y) * uvStride, u + static_cast<size_t>(y) * uStride, v + static_cast<size_t>(y) * vStride, width);
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+template <typename T>
+int yuv_frame_convert(const YuvFrame& src, YuvFrame& dst)
+{
+    if (src.width != dst.width || src.height != dst.height)
+    {
+        SPDLOG_ERROR("Frame size mismatch: {}x{} -> {}x{}", src.width, src.height, dst.width, dst.height);
+        return -1;
+    }
+    if ((src.width & 1) || (src.height & 1))
+    {
+        SPDLOG_ERROR("Frame size must be even: {}x{}", src.width, src.height);
+        return -1;
+    }
+
+    // 帧的行跨度以字节计，平面函数以采样点数计
+    const T* sp[3];
+    T*       dp[3];
+    int      ss[3], ds[3];
+    for (int p = 0; p < 3; p++)
+    {
+        if (src.stride[p] % sizeof(T) != 0 || dst.stride[p] % sizeof(T) != 0)
+        {
+            SPDLOG_ERROR("Stride must be a multiple of {} bytes: {} / {}", sizeof(T), src.stride[p], dst.stride[p]);
+            return -1;
+        }
+        sp[p] = reinterpret_cast<const T*>(src.data[p]);
+        dp[p] = reinterpret_cast<T*>(dst.data[p]);
+        ss[p] = src.stride[p] / static_cast<int>(sizeof(T));
+        ds[p] = dst.stride[p] / static_cast<int>(sizeof(T));
+    }
+
+    int width  = src.width;
+    int height = src.height;
+    copy_plane(sp[0], ss[0], dp[0], ds[0], width, height);
+
+    int sx, sy, dx, dy;
+    yuv_chroma_shift(src.format, sx, sy);
+    yuv_chroma_shift(dst.format, dx, dy);
+    int srcCW = (width + (1 << sx) - 1) >> sx;
+    int srcCH = (height + (1 << sy) - 1) >> sy;
+    int dstCW = (width + (1 << dx) - 1) >> dx;
+    int dstCH = (height + (1 << dy) - 1) >> dy;
+
+    bool srcSemi = yuv_is_semi_planar(src.format);
+    bool dstSemi = yuv_is_semi_planar(dst.format);
+
+    // NV12 <-> NV21 只需交换 U、V
+    if (srcSemi && dstSemi)
+    {
+        if (src.format == dst.format)
+        {
+            copy_plane(sp[1], ss[1], dp[1], ds[1], srcCW * 2, srcCH);
+            return 0;
+        }
+        std::vector<T> planes(static_cast<size_t>(srcCW) * srcCH * 2);
+        T*             pu = planes.data();
+        T*             pv = pu + static_cast<size_t>(srcCW) * srcCH;
+        uv_deinterleave(sp[1], ss[1], pu, srcCW, pv, srcCW, srcCW, srcCH);
+        uv_interleave(pv, srcCW, pu, srcCW, dp[1], ds[1], srcCW, srcCH);
+        return 0;
+    }
+
+    // 源色度平面：半平面先解交织
+    std::vector<T> srcPlanes;
+    const T*       su  = sp[1];
+    const T*       sv  = sp[2];
+    int            sus = ss[1];
+    int            svs = ss[2];
+    if (srcSemi)
+    {
+        bool swap = (src.format == YUV_FORMAT_NV21);
+        // 热路径 NV12 -> I420：色度尺寸相同且不重叠时直接解交织到目标平面
+        if (sx == dx && sy == dy &&
+            !plane_overlaps(sp[1], ss[1], srcCH, dp[1], ds[1], dstCH) &&
+            !plane_overlaps(sp[1], ss[1], srcCH, dp[2], ds[2], dstCH))
+        {
+            T*  du = swap ? dp[2] : dp[1];
+            T*  dv = swap ? dp[1] : dp[2];
+            int us = swap ? ds[2] : ds[1];
+            int vs = swap ? ds[1] : ds[2];
+            uv_deinterleave(sp[1], ss[1], du, us, dv, vs, srcCW, srcCH);
+            return 0;
+        }
+        srcPlanes.resize(static_cast<size_t>(srcCW) * srcCH * 2);
+        T* pu = srcPlanes.data();
+        T* pv = pu + static_cast<size_t>(srcCW) * srcCH;
+        uv_deinterleave(sp[1], ss[1], swap ? pv : pu, srcCW, swap ? pu : pv, srcCW, srcCW, srcCH);
+        su = pu;
+        sv = pv;
+        sus = svs = srcCW;
+    }
+
+    // 目标色度平面：半平面先输出到临时平面
+    std::vector<T> dstPlanes;
+    T*             du  = dp[1];
+    T*             dv  = dp[2];
+    int            dus = ds[1];
+    int            dvs = ds[2];
+    if (dstSemi)
+    {
+        bool swap = (dst.format == YUV_FORMAT_NV21);
+        // 热路径 I420 -> NV12：色度尺寸相同且不重叠时直接交织
+        if (sx == dx && sy == dy &&
+            !plane_overlaps(su, sus, srcCH, dp[1], ds[1], dstCH) &&
+            !plane_overlaps(sv, svs, srcCH, dp[1], ds[1], dstCH))
+        {
+            uv_interleave(swap ? sv : su, swap ? svs : sus, swap ? su : sv, swap ? sus : svs, dp[1], ds[1], dstCW, dstCH);
+            return 0;
+        }
+        dstPlanes.resize(static_cast<size_t>(dstCW) * dstCH * 2);
+        du  = dstPlanes.data();
+        dv  = du + static_cast<size_t>(dstCW) * dstCH;
+        dus = dvs = dstCW;
+    }
+
+    // 同一缓冲区内上采样时，目标 U 会覆盖源 V，先处理 V；下采样则先处理 U
+    std::vector<T> scratch;
+    if (dstCW * dstCH > srcCW * srcCH)
+    {
+        resample_chroma_plane(sv, svs, srcCW, srcCH, sx, sy, dv, dvs, dx, dy, scratch);
+        resample_chroma_plane(su, sus, srcCW, srcCH, sx, sy, du, dus, dx, dy, scratch);
+    }
+    else
+    {
+        resample_chroma_plane(su, sus, srcCW, srcCH, sx, sy, du, dus, dx, dy, scratch);
+        resample_chroma_plane(sv, svs, srcCW, srcCH, sx, sy, dv, dvs, dx, dy, scratch);
+    }
+
+    if (dstSemi)
+    {
+        bool swap = (dst.format == YUV_FORMAT_NV21);
+        uv_interleave(swap ? dv : du, dstCW, swap ? du : dv, dstCW, dp[1], ds[1], dstCW, dstCH);
+    }
+
+    return 0;
+}
+
+template void chroma_downsample_horizontal<uint8_t>(const uint8_t*, int, uint8_t*, int, int, int);
+template void chroma_downsample_horizontal<uint16_t>(const uint16_t*, int, uint16_t*, int, int, int);
+template void chroma_upsample_horizontal<uint8_t>(const uint8_t*, int, uint8_t*, int, int, int);
+template void chroma_upsample_horizontal<uint16_t>(const uint16_t*, int, uint16_t*, int, int, int);
+template void chroma_downsample_vertical<uint8_t>(const uint8_t*, int, uint8_t*, int, int, int);
+template void chroma_downsample_vertical<uint16_t>(const uint16_t*, int, uint16_t*, int, int, int);
+template void chroma_upsample_vertical<uint8_t>(const uint8_t*, int, uint8_t*, int, int, int);
+template void chroma_upsample_vertical<uint16_t>(const uint16_t*, int, uint16_t*, int, int, int);
+template void uv_interleave<uint8_t>(const uint8_t*, int, const uint8_t*, int, uint8_t*, int, int, int);
+template void uv_interleave<uint16_t>(const uint16_t*, int, const uint16_t*, int, uint16_t*, int, int, int);
+template void uv_deinterleave<uint8_t>(const uint8_t*, int, uint8_t*, int, uint8_t*, int, int, int);
+template void uv_deinterleave<uint16_t>(const uint16_t*, int, uint16_t*, int, uint16_t*, int, int, int);
+template int  yuv_frame_convert<uint8_t>(const YuvFrame&, YuvFrame&);
+template int  yuv_frame_convert<uint16_t>(const YuvFrame&, YuvFrame&);
+
+int simplest_yuv_convert(const std::string& filename, int width, int height, YuvFormat srcFormat, YuvFormat dstFormat, int number, int bitDepth)
+{
+    if (bitDepth < 8 || bitDepth > 16)
+    {
+        SPDLOG_ERROR("Invalid bit depth: {}", bitDepth);
+        return -1;
+    }
+
+    std::string outname = filename + "." + yuv_format_name(dstFormat);
+    if (bitDepth > 8)
+    {
+        outname += fmt::format("p{}", bitDepth);
+    }
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(outname, std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int      sampleBytes = bitDepth > 8 ? 2 : 1;
+    int      srcSize     = yuv_frame_size(srcFormat, width, height, sampleBytes);
+    int      dstSize     = yuv_frame_size(dstFormat, width, height, sampleBytes);
+    uint8_t* srcFrame    = new uint8_t[srcSize];
+    uint8_t* dstFrame    = new uint8_t[dstSize];
+    YuvFrame src         = yuv_frame_wrap(srcFrame, srcFormat, width, height, sampleBytes);
+    YuvFrame dst         = yuv_frame_wrap(dstFrame, dstFormat, width, height, sampleBytes);
+
+    // 高位深的半平面文件按 P010/P016 高位对齐存储（与 simplest_yuv_pattern 一致），转换前后整帧移位
+    int  shift   = 16 - bitDepth;
+    auto realign = [&](uint8_t* frame, int size, int bits) {
+        uint16_t* samples = reinterpret_cast<uint16_t*>(frame);
+        plane_shift(samples, width, samples, width, width, size / 2 / width, bits);
+    };
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(srcFrame), srcSize))
+        {
+            break;
+        }
+        if (bitDepth > 8)
+        {
+            if (yuv_is_semi_planar(srcFormat) && shift > 0)
+            {
+                realign(srcFrame, srcSize, -shift);
+            }
+            yuv_frame_convert<uint16_t>(src, dst);
+            if (yuv_is_semi_planar(dstFormat) && shift > 0)
+            {
+                realign(dstFrame, dstSize, shift);
+            }
+        }
+        else
+        {
+            yuv_frame_convert(src, dst);
+        }
+        oFile.write(reinterpret_cast<char*>(dstFrame), dstSize);
+    }
+
+    delete[] srcFrame;
+    delete[] dstFrame;
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#ifndef __YUV_CONVERT_H__
+#define __YUV_CONVERT_H__
+
+#include <cstdint>
+#include <string>
+
+#include "yuv_frame.h"
+
+/**
+ * 色度位置约定（与 MPEG-2/H.264 默认一致）：
+ *  水平方向色度与偶数列亮度共点（left），垂直方向 4:2:0 色度位于两行亮度之间（center）
+ * 因此：
+ *  水平下采样  [1 2 1] / 4         水平上采样  偶数列直接拷贝，奇数列取左右均值
+ *  垂直下采样  [1 1] / 2           垂直上采样  [1 3] / 4 与 [3 1] / 4
+ * 所有平面函数都支持带行跨度的平面，dst 与 src 可以指向同一块内存（原地转换，
+ * 此时要求两者行跨度一致），原地的垂直转换退化为单线程按安全的顺序处理
+ * 平面函数按采样类型模板化（与 yuv_plane.h 相同）：uint8_t 为 8 位，uint16_t 为低位对齐的 10/12/16 位，
+ * 行跨度以采样点数计；两种类型各有 SSE2 行内核，16 位的舍入结果与标量完全一致
+ */
+
+/**
+ * @brief   色度平面水平 2:1 下采样（444 -> 422）
+ * @param   src                     [IN]        源平面
+ * @param   srcStride               [IN]        源平面行跨度
+ * @param   dst                     [OUT]       目标平面，宽度 (srcWidth + 1) / 2
+ * @param   dstStride               [IN]        目标平面行跨度
+ * @param   srcWidth                [IN]        源平面宽度
+ * @param   height                  [IN]        平面高度
+ */
+template <typename T>
+void chroma_downsample_horizontal(const T* src, int srcStride, T* dst, int dstStride, int srcWidth, int height);
+
+/**
+ * @brief   色度平面水平 1:2 上采样（422 -> 444）
+ * @param   src                     [IN]        源平面
+ * @param   srcStride               [IN]        源平面行跨度
+ * @param   dst                     [OUT]       目标平面，宽度 srcWidth * 2
+ * @param   dstStride               [IN]        目标平面行跨度
+ * @param   srcWidth                [IN]        源平面宽度
+ * @param   height                  [IN]        平面高度
+ */
+template <typename T>
+void chroma_upsample_horizontal(const T* src, int srcStride, T* dst, int dstStride, int srcWidth, int height);
+
+/**
+ * @brief   色度平面垂直 2:1 下采样（422 -> 420）
+ * @param   src                     [IN]        源平面
+ * @param   srcStride               [IN]        源平面行跨度
+ * @param   dst                     [OUT]       目标平面，高度 (srcHeight + 1) / 2
+ * @param   dstStride               [IN]        目标平面行跨度
+ * @param   width                   [IN]        平面宽度
+ * @param   srcHeight               [IN]        源平面高度
+ */
+template <typename T>
+void chroma_downsample_vertical(const T* src, int srcStride, T* dst, int dstStride, int width, int srcHeight);
+
+/**
+ * @brief   色度平面垂直 1:2 上采样（420 -> 422）
+ * @param   src                     [IN]        源平面
+ * @param   srcStride               [IN]        源平面行跨度
+ * @param   dst                     [OUT]       目标平面，高度 srcHeight * 2
+ * @param   dstStride               [IN]        目标平面行跨度
+ * @param   width                   [IN]        平面宽度
+ * @param   srcHeight               [IN]        源平面高度
+ */
+template <typename T>
+void chroma_upsample_vertical(const T* src, int srcStride, T* dst, int dstStride, int width, int srcHeight);
+
+/**
+ * @brief   U、V 平面交织为半平面（NV12 为 UV，NV21 传入时交换 u/v 即可）
+ * @param   u                       [IN]        U 平面
+ * @param   uStride                 [IN]        U 平面行跨度
+ * @param   v                       [IN]        V 平面
+ * @param   vStride                 [IN]        V 平面行跨度
+ * @param   uv                      [OUT]       交织平面
+ * @param   uvStride                [IN]        交织平面行跨度
+ * @param   width                   [IN]        色度宽度（采样点数）
+ * @param   height                  [IN]        色度高度
+ */
+template <typename T>
+void uv_interleave(const T* u, int uStride, const T* v, int vStride, T* uv, int uvStride, int width, int height);
+
+/**
+ * @brief   半平面解交织为 U、V 平面
+ * @param   uv                      [IN]        交织平面
+ * @param   uvStride                [IN]        交织平面行跨度
+ * @param   u                       [OUT]       U 平面
+ * @param   uStride                 [IN]        U 平面行跨度
+ * @param   v                       [OUT]       V 平面
+ * @param   vStride                 [IN]        V 平面行跨度
+ * @param   width                   [IN]        色度宽度（采样点数）
+ * @param   height                  [IN]        色度高度
+ */
+template <typename T>
+void uv_deinterleave(const T* uv, int uvStride, T* u, int uStride, T* v, int vStride, int width, int height);
+
+/**
+ * @brief   在 I420/I422/I444/NV12/NV21 之间转换一帧
+ * T 为 uint16_t 时平面按低位对齐的 16 位采样解释（帧的行跨度仍以字节计，必须是 2 的倍数），
+ * 半平面为低位对齐的 UV 交织；高位对齐的 P010 先用 plane_shift/p010_uv_deinterleave 转为低位对齐
+ * @param   src                     [IN]        源帧
+ * @param   dst                     [IN/OUT]    目标帧，宽高必须与源帧一致（偶数），平面由调用者分配
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+template <typename T = uint8_t>
+int yuv_frame_convert(const YuvFrame& src, YuvFrame& dst);
+
+/**
+ * @brief   转换YUV像素数据的格式
+ * @param   filename                [IN]        输入文件路径
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   srcFormat               [IN]        输入格式
+ * @param   dstFormat               [IN]        输出格式
+ * @param   number                  [IN]        处理的帧数
+ * @param   bitDepth                [IN]        位深（8~16），大于 8 时每个采样 2 字节、低位对齐（yuv420p10le 等）
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv_convert(const std::string& filename, int width, int height, YuvFormat srcFormat, YuvFormat dstFormat, int number, int bitDepth = 8);
+
+#endif
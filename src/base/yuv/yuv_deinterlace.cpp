@@ -0,0 +1,497 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_deinterlace.h"
+#include "yuv_pattern.h"
+
+namespace
+{
+    constexpr int kMinRowsPerThread = 32;
+
+    /**
+     * @brief   YADIF 一行的参考行
+     * 缺失行位于 cur，上下相邻行为 cur + mrefs / cur + prefs；
+     * prev2/next2 为与缺失行同一时刻前后的两场（同奇偶行），用于时间预测
+     */
+    typedef struct YadifRows
+    {
+        const uint8_t* prev;  // 上一帧
+        const uint8_t* cur;   // 当前帧
+        const uint8_t* next;  // 下一帧
+        const uint8_t* prev2; // 缺失行时间上的前一场
+        const uint8_t* next2; // 缺失行时间上的后一场
+        int            mrefs; // 上一行偏移
+        int            prefs; // 下一行偏移
+        bool           check; // 是否做隔行的空间检查（需要上下各两行）
+    } YadifRows;
+
+    void yadif_row_c(uint8_t* dst, const YadifRows& r, int begin, int end, int width)
+    {
+        const uint8_t* cur = r.cur;
+        int            m   = r.mrefs;
+        int            p   = r.prefs;
+        for (int x = begin; x < end; x++)
+        {
+            int c     = cur[x + m];
+            int e     = cur[x + p];
+            int d     = (r.prev2[x] + r.next2[x]) >> 1;
+            int diff0 = std::abs(r.prev2[x] - r.next2[x]);
+            int diff1 = (std::abs(r.prev[x + m] - c) + std::abs(r.prev[x + p] - e)) >> 1;
+            int diff2 = (std::abs(r.next[x + m] - c) + std::abs(r.next[x + p] - e)) >> 1;
+            int diff  = std::max({diff0 >> 1, diff1, diff2});
+            int pred  = (c + e) >> 1;
+
+            // 边缘方向检测：依次尝试 -1、-2 和 +1、+2 方向，更小的代价才采用
+            if (x >= 3 && x + 3 < width)
+            {
+                int  score = std::abs(cur[x + m - 1] - cur[x + p - 1]) + std::abs(c - e) + std::abs(cur[x + m + 1] - cur[x + p + 1]) - 1;
+                auto check = [&](int j) {
+                    int s = std::abs(cur[x + m - 1 + j] - cur[x + p - 1 - j]) + std::abs(cur[x + m + j] - cur[x + p - j]) + std::abs(cur[x + m + 1 + j] - cur[x + p + 1 - j]);
+                    if (s < score)
+                    {
+                        score = s;
+                        pred  = (cur[x + m + j] + cur[x + p - j]) >> 1;
+                        return true;
+                    }
+                    return false;
+                };
+                if (check(-1))
+                {
+                    check(-2);
+                }
+                if (check(1))
+                {
+                    check(2);
+                }
+            }
+
+            if (r.check)
+            {
+                int b  = (r.prev2[x + 2 * m] + r.next2[x + 2 * m]) >> 1;
+                int f  = (r.prev2[x + 2 * p] + r.next2[x + 2 * p]) >> 1;
+                int hi = std::max({d - e, d - c, std::min(b - c, f - e)});
+                int lo = std::min({d - e, d - c, std::max(b - c, f - e)});
+                diff   = std::max({diff, lo, -hi});
+            }
+
+            dst[x] = static_cast<uint8_t>(std::clamp(pred, d - diff, d + diff));
+        }
+    }
+
+#if SIMD_SSE2
+    inline __m128i load8(const uint8_t* p)
+    {
+        return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128());
+    }
+
+    inline __m128i absdiff16(__m128i a, __m128i b)
+    {
+        return _mm_max_epi16(_mm_sub_epi16(a, b), _mm_sub_epi16(b, a));
+    }
+
+    inline __m128i select16(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+#endif
+
+    void yadif_row(uint8_t* dst, const YadifRows& r, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        // 左右各 3 个像素需要边界处理，交给标量；中间 8 个一组在 16 位通道上计算
+        yadif_row_c(dst, r, 0, std::min(3, width), width);
+        x = 3;
+
+        const uint8_t* cm  = r.cur + r.mrefs;
+        const uint8_t* cp  = r.cur + r.prefs;
+        const __m128i  one = _mm_set1_epi16(1);
+        for (; x + 11 <= width; x += 8)
+        {
+            __m128i c     = load8(cm + x);
+            __m128i e     = load8(cp + x);
+            __m128i p2    = load8(r.prev2 + x);
+            __m128i n2    = load8(r.next2 + x);
+            __m128i d     = _mm_srli_epi16(_mm_add_epi16(p2, n2), 1);
+            __m128i diff0 = _mm_srli_epi16(absdiff16(p2, n2), 1);
+            __m128i diff1 = _mm_srli_epi16(_mm_add_epi16(absdiff16(load8(r.prev + r.mrefs + x), c), absdiff16(load8(r.prev + r.prefs + x), e)), 1);
+            __m128i diff2 = _mm_srli_epi16(_mm_add_epi16(absdiff16(load8(r.next + r.mrefs + x), c), absdiff16(load8(r.next + r.prefs + x), e)), 1);
+            __m128i diff  = _mm_max_epi16(_mm_max_epi16(diff0, diff1), diff2);
+            __m128i pred  = _mm_srli_epi16(_mm_add_epi16(c, e), 1);
+            __m128i score = _mm_sub_epi16(_mm_add_epi16(_mm_add_epi16(absdiff16(load8(cm + x - 1), load8(cp + x - 1)), absdiff16(c, e)), absdiff16(load8(cm + x + 1), load8(cp + x + 1))), one);
+
+            // 方向 j 的代价小于当前代价（且 enable 为真）时更新，返回更新掩码
+            auto check = [&](int j, __m128i enable) {
+                __m128i s = _mm_add_epi16(_mm_add_epi16(absdiff16(load8(cm + x - 1 + j), load8(cp + x - 1 - j)), absdiff16(load8(cm + x + j), load8(cp + x - j))),
+                                          absdiff16(load8(cm + x + 1 + j), load8(cp + x + 1 - j)));
+                __m128i mask = _mm_and_si128(enable, _mm_cmplt_epi16(s, score));
+                score        = select16(mask, s, score);
+                pred         = select16(mask, _mm_srli_epi16(_mm_add_epi16(load8(cm + x + j), load8(cp + x - j)), 1), pred);
+                return mask;
+            };
+            const __m128i all = _mm_cmpeq_epi16(one, one);
+            check(-2, check(-1, all));
+            check(2, check(1, all));
+
+            if (r.check)
+            {
+                __m128i b  = _mm_srli_epi16(_mm_add_epi16(load8(r.prev2 + 2 * r.mrefs + x), load8(r.next2 + 2 * r.mrefs + x)), 1);
+                __m128i f  = _mm_srli_epi16(_mm_add_epi16(load8(r.prev2 + 2 * r.prefs + x), load8(r.next2 + 2 * r.prefs + x)), 1);
+                __m128i de = _mm_sub_epi16(d, e);
+                __m128i dc = _mm_sub_epi16(d, c);
+                __m128i hi = _mm_max_epi16(_mm_max_epi16(de, dc), _mm_min_epi16(_mm_sub_epi16(b, c), _mm_sub_epi16(f, e)));
+                __m128i lo = _mm_min_epi16(_mm_min_epi16(de, dc), _mm_max_epi16(_mm_sub_epi16(b, c), _mm_sub_epi16(f, e)));
+                diff       = _mm_max_epi16(_mm_max_epi16(diff, lo), _mm_sub_epi16(_mm_setzero_si128(), hi));
+            }
+
+            pred = _mm_max_epi16(_mm_min_epi16(pred, _mm_add_epi16(d, diff)), _mm_sub_epi16(d, diff));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(pred, pred));
+        }
+#endif
+        yadif_row_c(dst, r, x, width, width);
+    }
+
+    /**
+     * @brief   bob：dst = (a + b + 1) >> 1
+     */
+    void average_row(uint8_t* dst, const uint8_t* a, const uint8_t* b, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_avg_epu8(va, vb));
+        }
+#elif SIMD_NEON
+        for (; x + 16 <= width; x += 16)
+        {
+            vst1q_u8(dst + x, vrhaddq_u8(vld1q_u8(a + x), vld1q_u8(b + x)));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            dst[x] = static_cast<uint8_t>((a[x] + b[x] + 1) >> 1);
+        }
+    }
+
+    /**
+     * @brief   blend：dst = (a + 2b + c + 2) >> 2
+     */
+    void blend_row(uint8_t* dst, const uint8_t* a, const uint8_t* b, const uint8_t* c, int width)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i two  = _mm_set1_epi16(2);
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            __m128i vc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + x));
+            __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vc, zero)), _mm_slli_epi16(_mm_unpacklo_epi8(vb, zero), 1));
+            __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vc, zero)), _mm_slli_epi16(_mm_unpackhi_epi8(vb, zero), 1));
+            lo         = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+            hi         = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(lo, hi));
+        }
+#elif SIMD_NEON
+        for (; x + 16 <= width; x += 16)
+        {
+            uint8x16_t va = vld1q_u8(a + x);
+            uint8x16_t vb = vld1q_u8(b + x);
+            uint8x16_t vc = vld1q_u8(c + x);
+            uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(va), vget_low_u8(vc)), vshll_n_u8(vget_low_u8(vb), 1));
+            uint16x8_t hi = vaddq_u16(vaddl_u8(vget_high_u8(va), vget_high_u8(vc)), vshll_n_u8(vget_high_u8(vb), 1));
+            vst1q_u8(dst + x, vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2)));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            dst[x] = static_cast<uint8_t>((a[x] + 2 * b[x] + c[x] + 2) >> 2);
+        }
+    }
+
+    /**
+     * @brief   逐行交错：偶数帧行来自 a，奇数帧行来自 b（用于生成测试用的交错序列）
+     */
+    void interleave_fields(const uint8_t* a, const uint8_t* b, uint8_t* dst, int width, int height)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            const uint8_t* src = (y & 1) ? b : a;
+            memcpy(dst + static_cast<size_t>(y) * width, src + static_cast<size_t>(y) * width, width);
+        }
+    }
+} // namespace
+
+void field_split(const uint8_t* src, int stride, int width, int height, uint8_t* top, int topStride, uint8_t* bottom, int bottomStride)
+{
+    for (int y = 0; y < height; y++)
+    {
+        uint8_t* dst = (y & 1) ? bottom + static_cast<size_t>(y / 2) * bottomStride : top + static_cast<size_t>(y / 2) * topStride;
+        memcpy(dst, src + static_cast<size_t>(y) * stride, width);
+    }
+}
+
+void field_merge(const uint8_t* top, int topStride, const uint8_t* bottom, int bottomStride, uint8_t* dst, int stride, int width, int height)
+{
+    for (int y = 0; y < height; y++)
+    {
+        const uint8_t* src = (y & 1) ? bottom + static_cast<size_t>(y / 2) * bottomStride : top + static_cast<size_t>(y / 2) * topStride;
+        memcpy(dst + static_cast<size_t>(y) * stride, src, width);
+    }
+}
+
+Deinterlacer::Deinterlacer(DeinterlaceMode mode, FieldOrder order)
+    : m_mode(mode)
+    , m_order(order)
+{
+}
+
+void Deinterlacer::Process(const YuvFrame& prev, const YuvFrame& cur, const YuvFrame& next, int field, YuvFrame& out) const
+{
+    int shiftX, shiftY;
+    yuv_chroma_shift(cur.format, shiftX, shiftY);
+    for (int p = 0; p < 3; p++)
+    {
+        int width  = p ? (cur.width + (1 << shiftX) - 1) >> shiftX : cur.width;
+        int height = p ? (cur.height + (1 << shiftY) - 1) >> shiftY : cur.height;
+        ProcessPlane(prev.data[p], cur.data[p], next.data[p], cur.stride[p], out.data[p], out.stride[p], width, height, field);
+    }
+}
+
+void Deinterlacer::ProcessPlane(const uint8_t* prev, const uint8_t* cur, const uint8_t* next, int stride, uint8_t* dst, int dstStride, int width, int height, int field) const
+{
+    // 保留行的奇偶：顶场先出时先出场是偶数行
+    int keep = (static_cast<int>(m_order) ^ field) & 1;
+    // 缺失行的时间邻居：先出场取上一帧和当前帧的另一场，后出场取当前帧和下一帧
+    const uint8_t* prev2 = field ? cur : prev;
+    const uint8_t* next2 = field ? next : cur;
+
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            uint8_t*       d     = dst + static_cast<size_t>(y) * dstStride;
+            size_t         line  = static_cast<size_t>(y) * stride;
+            int            mrefs = y > 0 ? -stride : stride;
+            int            prefs = y + 1 < height ? stride : -stride;
+            const uint8_t* c     = cur + line;
+            if (m_mode == DEINTERLACE_BLEND)
+            {
+                blend_row(d, c + mrefs, c, c + prefs, width);
+                continue;
+            }
+            if ((y & 1) == keep || height < 2)
+            {
+                memcpy(d, c, width);
+                continue;
+            }
+            if (m_mode == DEINTERLACE_BOB)
+            {
+                average_row(d, c + mrefs, c + prefs, width);
+                continue;
+            }
+            YadifRows r = {prev + line, c, next + line, prev2 + line, next2 + line, mrefs, prefs, y >= 2 && y + 2 < height};
+            yadif_row(d, r, width);
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+int deinterlace_benchmark()
+{
+    constexpr int kWidth      = 1920;
+    constexpr int kHeight     = 1080;
+    constexpr int kIterations = 20;
+    int           frameSize   = yuv_frame_size(YUV_FORMAT_I420, kWidth, kHeight);
+
+    // 用波带片相邻两帧交错出 1080i 帧，运动使两场之间出现梳齿
+    PatternGenerator                    generator(PATTERN_ZONE_PLATE, YUV_FORMAT_I420, kWidth, kHeight);
+    std::vector<AlignedBuffer<uint8_t>> fields(4);
+    for (int i = 0; i < 4; i++)
+    {
+        fields[i].Resize(frameSize);
+        memcpy(fields[i].Data(), generator.Render(i).data[0], frameSize);
+    }
+    AlignedBuffer<uint8_t> prev(frameSize), cur(frameSize), out(frameSize), reference(frameSize);
+    interleave_fields(fields[0].Data(), fields[1].Data(), prev.Data(), kWidth, frameSize / kWidth);
+    interleave_fields(fields[2].Data(), fields[3].Data(), cur.Data(), kWidth, frameSize / kWidth);
+
+    YuvFrame prevFrame = yuv_frame_wrap(prev.Data(), YUV_FORMAT_I420, kWidth, kHeight);
+    YuvFrame curFrame  = yuv_frame_wrap(cur.Data(), YUV_FORMAT_I420, kWidth, kHeight);
+    YuvFrame outFrame  = yuv_frame_wrap(out.Data(), YUV_FORMAT_I420, kWidth, kHeight);
+
+    // YADIF 行内核对比标量实现（亮度第 101 行）
+    YadifRows r = {prev.Data() + 101 * kWidth, cur.Data() + 101 * kWidth, cur.Data() + 101 * kWidth, prev.Data() + 101 * kWidth, cur.Data() + 101 * kWidth, -kWidth, kWidth, true};
+    yadif_row(out.Data(), r, kWidth);
+    yadif_row_c(reference.Data(), r, 0, kWidth, kWidth);
+    if (memcmp(out.Data(), reference.Data(), kWidth) != 0)
+    {
+        SPDLOG_ERROR("Deinterlace: YADIF SIMD result mismatch");
+        return -1;
+    }
+
+    const DeinterlaceMode modes[] = {DEINTERLACE_BOB, DEINTERLACE_BLEND, DEINTERLACE_YADIF};
+    const char*           names[] = {"bob", "blend", "yadif"};
+    for (int i = 0; i < 3; i++)
+    {
+        Deinterlacer deinterlacer(modes[i]);
+        double       seconds = benchmark_seconds([&] { deinterlacer.Process(prevFrame, curFrame, curFrame, 0, outFrame); }, kIterations);
+        SPDLOG_INFO("Deinterlace {} {}x{}i: {:.0f} fps", names[i], kWidth, kHeight, 1.0 / seconds);
+    }
+
+    return 0;
+}
+
+int simplest_yuv420_field_split(const std::string& filename, int width, int height, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream tFile(filename + ".top", std::ios::out | std::ios::binary);
+    std::ofstream bFile(filename + ".bottom", std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int      frameSize = width * height * 3 / 2; // YUV420P每帧字节数
+    uint8_t* frame     = new uint8_t[frameSize];
+    uint8_t* top       = new uint8_t[frameSize / 2];
+    uint8_t* bottom    = new uint8_t[frameSize / 2];
+    YuvFrame src       = yuv_frame_wrap(frame, YUV_FORMAT_I420, width, height);
+    YuvFrame dstTop    = yuv_frame_wrap(top, YUV_FORMAT_I420, width, height / 2);
+    YuvFrame dstBottom = yuv_frame_wrap(bottom, YUV_FORMAT_I420, width, height / 2);
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(frame), frameSize))
+        {
+            break;
+        }
+        for (int p = 0; p < 3; p++)
+        {
+            int shift = p ? 1 : 0;
+            field_split(src.data[p], src.stride[p], width >> shift, height >> shift, dstTop.data[p], dstTop.stride[p], dstBottom.data[p], dstBottom.stride[p]);
+        }
+        tFile.write(reinterpret_cast<const char*>(top), frameSize / 2);
+        bFile.write(reinterpret_cast<const char*>(bottom), frameSize / 2);
+    }
+
+    delete[] frame;
+    delete[] top;
+    delete[] bottom;
+    iFile.close();
+    tFile.close();
+    bFile.close();
+
+    return 0;
+}
+
+int simplest_yuv420_field_merge(const std::string& top, const std::string& bottom, int width, int height, int number)
+{
+    std::ifstream tFile(top, std::ios::in | std::ios::binary);
+    std::ifstream bFile(bottom, std::ios::in | std::ios::binary);
+    std::ofstream oFile(top + ".merge", std::ios::out | std::ios::binary);
+    if (!tFile.is_open() || !bFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {} or {}", top, bottom);
+        return -1;
+    }
+
+    int      frameSize = width * height * 3 / 2; // YUV420P每帧字节数
+    uint8_t* frame     = new uint8_t[frameSize];
+    uint8_t* fieldTop  = new uint8_t[frameSize / 2];
+    uint8_t* fieldBot  = new uint8_t[frameSize / 2];
+    YuvFrame dst       = yuv_frame_wrap(frame, YUV_FORMAT_I420, width, height);
+    YuvFrame srcTop    = yuv_frame_wrap(fieldTop, YUV_FORMAT_I420, width, height / 2);
+    YuvFrame srcBottom = yuv_frame_wrap(fieldBot, YUV_FORMAT_I420, width, height / 2);
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!tFile.read(reinterpret_cast<char*>(fieldTop), frameSize / 2) || !bFile.read(reinterpret_cast<char*>(fieldBot), frameSize / 2))
+        {
+            break;
+        }
+        for (int p = 0; p < 3; p++)
+        {
+            int shift = p ? 1 : 0;
+            field_merge(srcTop.data[p], srcTop.stride[p], srcBottom.data[p], srcBottom.stride[p], dst.data[p], dst.stride[p], width >> shift, height >> shift);
+        }
+        oFile.write(reinterpret_cast<const char*>(frame), frameSize);
+    }
+
+    delete[] frame;
+    delete[] fieldTop;
+    delete[] fieldBot;
+    tFile.close();
+    bFile.close();
+    oFile.close();
+
+    return 0;
+}
+
+int simplest_yuv420_deinterlace(const std::string& filename, int width, int height, DeinterlaceMode mode, FieldOrder order, bool fieldRate, int number)
+{
+    static const char* kSuffix[] = {".bob", ".blend", ".yadif"};
+
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + kSuffix[mode], std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    // 三帧环形缓冲区：上一帧、当前帧、下一帧
+    int                               frameSize = width * height * 3 / 2; // YUV420P每帧字节数
+    std::vector<std::vector<uint8_t>> ring(3, std::vector<uint8_t>(frameSize));
+    std::vector<uint8_t>              output(frameSize);
+    YuvFrame                          frames[3];
+    for (int i = 0; i < 3; i++)
+    {
+        frames[i] = yuv_frame_wrap(ring[i].data(), YUV_FORMAT_I420, width, height);
+    }
+    YuvFrame     outFrame = yuv_frame_wrap(output.data(), YUV_FORMAT_I420, width, height);
+    Deinterlacer deinterlacer(mode, order);
+
+    auto read = [&](int slot) {
+        return static_cast<bool>(iFile.read(reinterpret_cast<char*>(ring[slot].data()), frameSize));
+    };
+
+    int  prev = 0, cur = 0, next = 1;
+    bool hasCur  = number > 0 && read(cur);
+    bool hasNext = hasCur && number > 1 && read(next);
+    for (int i = 0; i < number && hasCur; i++)
+    {
+        int following = hasNext ? next : cur;
+        for (int field = 0; field < (fieldRate ? 2 : 1); field++)
+        {
+            deinterlacer.Process(frames[prev], frames[cur], frames[following], field, outFrame);
+            oFile.write(reinterpret_cast<const char*>(output.data()), frameSize);
+        }
+        if (!hasNext)
+        {
+            break;
+        }
+        prev    = cur;
+        cur     = next;
+        next    = 3 - prev - cur;
+        hasNext = i + 2 < number && read(next);
+    }
+
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#ifndef __YUV_DEINTERLACE_H__
+#define __YUV_DEINTERLACE_H__
+
+#include <cstdint>
+#include <string>
+
+#include "yuv_frame.h"
+
+enum DeinterlaceMode
+{
+    DEINTERLACE_BOB   = 0, // 只保留一场，缺失行取上下两行平均
+    DEINTERLACE_BLEND = 1, // 线性混合：每行按 [1 2 1] 垂直滤波，两场合成一帧
+    DEINTERLACE_YADIF = 2, // 边缘方向的空间插值，并用前后帧的时间差限制（YADIF）
+};
+
+enum FieldOrder
+{
+    FIELD_ORDER_TFF = 0, // 顶场先出（偶数行先）
+    FIELD_ORDER_BFF = 1, // 底场先出（奇数行先）
+};
+
+/**
+ * @brief   从交错帧中拆出两场
+ * @param   src                     [IN]        交错帧平面
+ * @param   stride                  [IN]        行跨度（字节）
+ * @param   width                   [IN]        平面宽度
+ * @param   height                  [IN]        平面高度
+ * @param   top                     [OUT]       顶场（偶数行），(height + 1) / 2 行
+ * @param   topStride               [IN]        顶场行跨度
+ * @param   bottom                  [OUT]       底场（奇数行），height / 2 行
+ * @param   bottomStride            [IN]        底场行跨度
+ */
+void field_split(const uint8_t* src, int stride, int width, int height, uint8_t* top, int topStride, uint8_t* bottom, int bottomStride);
+
+/**
+ * @brief   两场合成交错帧，field_split 的逆操作
+ */
+void field_merge(const uint8_t* top, int topStride, const uint8_t* bottom, int bottomStride, uint8_t* dst, int stride, int width, int height);
+
+/**
+ * @brief   去隔行
+ * 1. bob 用 pavgb / vrhadd，blend 在 16 位通道上做 [1 2 1]（SSE2/NEON）；
+ *    YADIF 的方向检测和时间限制在 SSE2 的 16 位通道上完成，每次 8 个像素，其他平台走标量
+ * 2. 每个输出行只依赖输入帧，按行带多线程
+ * 3. 每个输入帧可以输出一帧（保留先出场）或两帧（场率输出，两场各重建一帧）；
+ *    blend 与场无关，两次输出相同
+ * 只支持平面格式（I420/I422/I444），平面行跨度任意
+ */
+class Deinterlacer
+{
+public:
+    /**
+     * @param   mode                    [IN]        去隔行方式
+     * @param   order                   [IN]        场序
+     */
+    Deinterlacer(DeinterlaceMode mode, FieldOrder order = FIELD_ORDER_TFF);
+    ~Deinterlacer() = default;
+
+    /**
+     * @brief   用 cur 的一场重建整帧
+     * @param   prev                    [IN]        上一帧（第一帧时传 cur）
+     * @param   cur                     [IN]        当前帧
+     * @param   next                    [IN]        下一帧（最后一帧时传 cur）
+     * @param   field                   [IN]        0 为先出场，1 为后出场
+     * @param   out                     [OUT]       输出帧，格式和尺寸与 cur 相同
+     */
+    void Process(const YuvFrame& prev, const YuvFrame& cur, const YuvFrame& next, int field, YuvFrame& out) const;
+
+private:
+    void ProcessPlane(const uint8_t* prev, const uint8_t* cur, const uint8_t* next, int stride, uint8_t* dst, int dstStride, int width, int height, int field) const;
+
+private:
+    DeinterlaceMode m_mode;  // 去隔行方式
+    FieldOrder      m_order; // 场序
+};
+
+/**
+ * @brief   去隔行吞吐测试（1080i 波带片序列，YADIF 行内核对比标量实现）
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int deinterlace_benchmark();
+
+/**
+ * @brief   拆分YUV420P交错帧为顶场和底场，分别写入 <filename>.top 和 <filename>.bottom（宽 x 高/2 的 YUV420P）
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度（4 的倍数）
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_field_split(const std::string& filename, int width, int height, int number);
+
+/**
+ * @brief   把顶场和底场合成为YUV420P交错帧，写入 <top>.merge
+ * @param   top                     [IN]        顶场文件路径
+ * @param   bottom                  [IN]        底场文件路径
+ * @param   width                   [IN]        合成后图像帧的宽度
+ * @param   height                  [IN]        合成后图像帧的高度（4 的倍数）
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_field_merge(const std::string& top, const std::string& bottom, int width, int height, int number);
+
+/**
+ * @brief   对YUV420P交错序列去隔行，写入 <filename>.bob / .blend / .yadif
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   mode                    [IN]        去隔行方式
+ * @param   order                   [IN]        场序
+ * @param   fieldRate               [IN]        true 时每个输入帧输出两帧
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_deinterlace(const std::string& filename, int width, int height, DeinterlaceMode mode, FieldOrder order, bool fieldRate, int number);
+
+#endif
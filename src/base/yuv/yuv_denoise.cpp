@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_denoise.h"
+#include "yuv_pattern.h"
+#include "yuv_plane.h"
+
+namespace
+{
+    constexpr int kMinRowsPerThread = 32;
+
+    void denoise_row_c(uint8_t* dst, const uint8_t* cur, const uint8_t* const* refs, int count, int threshold, int gain, int begin, int end)
+    {
+        for (int x = begin; x < end; x++)
+        {
+            int c   = cur[x];
+            int sum = 0;
+            for (int i = 0; i < count; i++)
+            {
+                int d = refs[i][x] - c;
+                int w = (std::max(threshold - std::abs(d), 0) * gain) >> 8;
+                sum += d * w;
+            }
+            dst[x] = static_cast<uint8_t>(std::clamp(c + (sum >> 8), 0, 255));
+        }
+    }
+
+    /**
+     * @brief   给帧加三角分布噪声（[-7, 7]），用于测试
+     */
+    void add_noise(uint8_t* data, size_t size, uint32_t seed)
+    {
+        uint32_t state = seed * 2654435761u + 1;
+        for (size_t i = 0; i < size; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            int noise = static_cast<int>(state & 7) + static_cast<int>((state >> 8) & 7) - 7;
+            data[i]   = static_cast<uint8_t>(std::clamp(data[i] + noise, 0, 255));
+        }
+    }
+
+    double psnr(uint64_t sse, size_t samples)
+    {
+        return sse ? 10.0 * std::log10(255.0 * 255.0 * samples / sse) : 100.0;
+    }
+} // namespace
+
+void denoise_row(uint8_t* dst, const uint8_t* cur, const uint8_t* const* refs, int count, int threshold, int gain, int width)
+{
+    int x = 0;
+#if SIMD_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i vt   = _mm_set1_epi16(static_cast<int16_t>(threshold));
+    const __m128i vg   = _mm_set1_epi16(static_cast<int16_t>(gain));
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i c   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + x));
+        __m128i cLo = _mm_unpacklo_epi8(c, zero);
+        __m128i cHi = _mm_unpackhi_epi8(c, zero);
+        __m128i sLo = zero;
+        __m128i sHi = zero;
+        for (int i = 0; i < count; i++)
+        {
+            // w = (max(T - |d|, 0) * gain) >> 8，乘积不超过 16 位无符号范围；w > 0 时 |d| < T，d * w 不超过 16 位有符号范围
+            __m128i r   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(refs[i] + x));
+            __m128i dLo = _mm_sub_epi16(_mm_unpacklo_epi8(r, zero), cLo);
+            __m128i dHi = _mm_sub_epi16(_mm_unpackhi_epi8(r, zero), cHi);
+            __m128i wLo = _mm_srli_epi16(_mm_mullo_epi16(_mm_subs_epu16(vt, _mm_max_epi16(dLo, _mm_sub_epi16(zero, dLo))), vg), 8);
+            __m128i wHi = _mm_srli_epi16(_mm_mullo_epi16(_mm_subs_epu16(vt, _mm_max_epi16(dHi, _mm_sub_epi16(zero, dHi))), vg), 8);
+            sLo         = _mm_add_epi16(sLo, _mm_mullo_epi16(dLo, wLo));
+            sHi         = _mm_add_epi16(sHi, _mm_mullo_epi16(dHi, wHi));
+        }
+        cLo = _mm_add_epi16(cLo, _mm_srai_epi16(sLo, 8));
+        cHi = _mm_add_epi16(cHi, _mm_srai_epi16(sHi, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(cLo, cHi));
+    }
+#elif SIMD_NEON
+    const uint16x8_t vt = vdupq_n_u16(static_cast<uint16_t>(threshold));
+    const uint16x8_t vg = vdupq_n_u16(static_cast<uint16_t>(gain));
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16_t c   = vld1q_u8(cur + x);
+        int16x8_t  cLo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(c)));
+        int16x8_t  cHi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(c)));
+        int16x8_t  sLo = vdupq_n_s16(0);
+        int16x8_t  sHi = vdupq_n_s16(0);
+        for (int i = 0; i < count; i++)
+        {
+            uint8x16_t r   = vld1q_u8(refs[i] + x);
+            int16x8_t  dLo = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(r))), cLo);
+            int16x8_t  dHi = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(r))), cHi);
+            uint16x8_t wLo = vshrq_n_u16(vmulq_u16(vqsubq_u16(vt, vreinterpretq_u16_s16(vabsq_s16(dLo))), vg), 8);
+            uint16x8_t wHi = vshrq_n_u16(vmulq_u16(vqsubq_u16(vt, vreinterpretq_u16_s16(vabsq_s16(dHi))), vg), 8);
+            sLo            = vmlaq_s16(sLo, dLo, vreinterpretq_s16_u16(wLo));
+            sHi            = vmlaq_s16(sHi, dHi, vreinterpretq_s16_u16(wHi));
+        }
+        cLo = vaddq_s16(cLo, vshrq_n_s16(sLo, 8));
+        cHi = vaddq_s16(cHi, vshrq_n_s16(sHi, 8));
+        vst1q_u8(dst + x, vcombine_u8(vqmovun_s16(cLo), vqmovun_s16(cHi)));
+    }
+#endif
+    denoise_row_c(dst, cur, refs, count, threshold, gain, x, width);
+}
+
+TemporalDenoiser::TemporalDenoiser(YuvFormat format, int width, int height, int references)
+    : m_references(std::clamp(references, 1, kMaxReferences))
+    , m_strength(192)
+    , m_threshold{10, 6}
+    , m_pool(format, width, height, m_references + 1)
+    , m_ring{}
+    , m_count(0)
+{
+}
+
+void TemporalDenoiser::SetStrength(int strength)
+{
+    m_strength = std::clamp(strength, 0, 255);
+}
+
+void TemporalDenoiser::SetThreshold(int luma, int chroma)
+{
+    m_threshold[0] = std::clamp(luma, 1, 127);
+    m_threshold[1] = std::clamp(chroma, 1, 127);
+}
+
+void TemporalDenoiser::Reset()
+{
+    for (int i = 0; i < m_count; i++)
+    {
+        m_pool.Release(m_ring[i]);
+    }
+    m_count = 0;
+}
+
+const YuvFrame& TemporalDenoiser::Process(const YuvFrame& frame)
+{
+    // 帧池容量为参考帧数 + 1，参考帧之外总有一帧空闲用作输出
+    YuvFrame* out = m_pool.Acquire();
+
+    int shiftX, shiftY;
+    yuv_chroma_shift(frame.format, shiftX, shiftY);
+    int planes = yuv_is_semi_planar(frame.format) ? 2 : 3;
+    for (int p = 0; p < planes; p++)
+    {
+        int chromaWidth = (frame.width + (1 << shiftX) - 1) >> shiftX;
+        int width       = p ? (yuv_is_semi_planar(frame.format) ? chromaWidth * 2 : chromaWidth) : frame.width;
+        int height      = p ? (frame.height + (1 << shiftY) - 1) >> shiftY : frame.height;
+        int threshold   = m_threshold[p ? 1 : 0];
+        int gain        = m_count ? (m_strength / m_count) * 256 / threshold : 0;
+
+        auto rows = [&](int begin, int end) {
+            const uint8_t* refs[kMaxReferences];
+            for (int y = begin; y < end; y++)
+            {
+                for (int i = 0; i < m_count; i++)
+                {
+                    refs[i] = m_ring[i]->data[p] + static_cast<size_t>(y) * m_ring[i]->stride[p];
+                }
+                denoise_row(out->data[p] + static_cast<size_t>(y) * out->stride[p], frame.data[p] + static_cast<size_t>(y) * frame.stride[p], refs, m_count, threshold, gain, width);
+            }
+        };
+        parallel_for_rows(height, rows, kMinRowsPerThread);
+    }
+
+    // 轮换：丢弃最旧的参考帧，新的输出成为最近一帧参考
+    if (m_count == m_references)
+    {
+        m_pool.Release(m_ring[--m_count]);
+    }
+    std::move_backward(m_ring, m_ring + m_count, m_ring + m_count + 1);
+    m_ring[0] = out;
+    m_count++;
+
+    return *out;
+}
+
+int denoise_benchmark()
+{
+    constexpr int kWidth      = 1920;
+    constexpr int kHeight     = 1080;
+    constexpr int kFrames     = 8;
+    constexpr int kIterations = 40;
+    int           frameSize   = yuv_frame_size(YUV_FORMAT_I420, kWidth, kHeight);
+
+    // 运动方块序列：干净帧用于计算 PSNR，加噪帧作为输入
+    PatternGenerator                    generator(PATTERN_MOVING_BOX, YUV_FORMAT_I420, kWidth, kHeight);
+    std::vector<AlignedBuffer<uint8_t>> clean(kFrames), noisy(kFrames);
+    std::vector<YuvFrame>               frames(kFrames);
+    for (int i = 0; i < kFrames; i++)
+    {
+        clean[i].Resize(frameSize);
+        noisy[i].Resize(frameSize);
+        memcpy(clean[i].Data(), generator.Render(i).data[0], frameSize);
+        memcpy(noisy[i].Data(), clean[i].Data(), frameSize);
+        add_noise(noisy[i].Data(), frameSize, i);
+        frames[i] = yuv_frame_wrap(noisy[i].Data(), YUV_FORMAT_I420, kWidth, kHeight);
+    }
+
+    // 行内核对比标量实现（两个参考行）
+    AlignedBuffer<uint8_t> out(kWidth), reference(kWidth);
+    const uint8_t*         refs[2] = {noisy[0].Data(), noisy[1].Data()};
+    denoise_row(out.Data(), noisy[2].Data(), refs, 2, 10, 96 * 256 / 10, kWidth);
+    denoise_row_c(reference.Data(), noisy[2].Data(), refs, 2, 10, 96 * 256 / 10, 0, kWidth);
+    if (memcmp(out.Data(), reference.Data(), kWidth) != 0)
+    {
+        SPDLOG_ERROR("Denoise: SIMD result mismatch");
+        return -1;
+    }
+
+    TemporalDenoiser denoiser(YUV_FORMAT_I420, kWidth, kHeight, 2);
+    uint64_t         noisySse    = 0;
+    uint64_t         denoisedSse = 0;
+    for (int i = 0; i < kFrames; i++)
+    {
+        const YuvFrame& result = denoiser.Process(frames[i]);
+        noisySse += plane_sse<uint8_t>(noisy[i].Data(), kWidth, clean[i].Data(), kWidth, kWidth, kHeight);
+        denoisedSse += plane_sse<uint8_t>(result.data[0], result.stride[0], clean[i].Data(), kWidth, kWidth, kHeight);
+    }
+    size_t samples = static_cast<size_t>(kWidth) * kHeight * kFrames;
+    SPDLOG_INFO("Denoise PSNR-Y: noisy {:.2f} dB, denoised {:.2f} dB", psnr(noisySse, samples), psnr(denoisedSse, samples));
+
+    int    index   = 0;
+    double seconds = benchmark_seconds([&] { denoiser.Process(frames[index++ % kFrames]); }, kIterations);
+    SPDLOG_INFO("Denoise 2 refs {}x{}: {:.0f} fps", kWidth, kHeight, 1.0 / seconds);
+
+    return 0;
+}
+
+int simplest_yuv420_denoise(const std::string& filename, int width, int height, int references, int strength, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + ".denoise", std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int      frameSize = width * height * 3 / 2; // YUV420P每帧字节数
+    uint8_t* pic       = new uint8_t[frameSize];
+    YuvFrame frame     = yuv_frame_wrap(pic, YUV_FORMAT_I420, width, height);
+
+    TemporalDenoiser denoiser(YUV_FORMAT_I420, width, height, references);
+    denoiser.SetStrength(strength);
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(pic), frameSize))
+        {
+            break;
+        }
+        // 输出帧的行跨度按 64 字节对齐，逐行写出
+        const YuvFrame& result = denoiser.Process(frame);
+        for (int p = 0; p < 3; p++)
+        {
+            int w = p ? width / 2 : width;
+            int h = p ? height / 2 : height;
+            for (int y = 0; y < h; y++)
+            {
+                oFile.write(reinterpret_cast<const char*>(result.data[p] + static_cast<size_t>(y) * result.stride[p]), w);
+            }
+        }
+    }
+
+    delete[] pic;
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#ifndef __YUV_DENOISE_H__
+#define __YUV_DENOISE_H__
+
+#include <cstdint>
+#include <string>
+
+#include "yuv_frame.h"
+#include "yuv_frame_pool.h"
+
+/**
+ * @brief   时域递归降噪（3D 降噪的时间部分）
+ * 1. 参考帧为之前若干帧的降噪输出，放在从帧池一次性取出的环形缓冲区里，逐帧轮换，不再分配内存
+ * 2. 每个参考帧按与当前像素的差值自适应加权：w = strength / N * max(0, T - |ref - cur|) / T，
+ *    差值超过阈值 T 视为运动，该参考帧不参与，避免拖影；out = cur + Σ w * (ref - cur) / 256
+ * 3. 16 位定点 SIMD（SSE2 / NEON）每次处理 16 个采样，平面按行带多线程
+ * 支持全部 YuvFormat，半平面格式的 UV 交织平面按一个平面处理
+ */
+class TemporalDenoiser
+{
+public:
+    static constexpr int kMaxReferences = 4;
+
+    /**
+     * @param   format                  [IN]        像素格式
+     * @param   width                   [IN]        宽度
+     * @param   height                  [IN]        高度
+     * @param   references              [IN]        参考帧数（1 ~ kMaxReferences）
+     */
+    TemporalDenoiser(YuvFormat format, int width, int height, int references = 2);
+    ~TemporalDenoiser() = default;
+
+    /**
+     * @brief   降噪强度：所有参考帧静止时的总权重（/256），默认 192
+     */
+    void SetStrength(int strength);
+
+    /**
+     * @brief   运动判定阈值（1 ~ 127）：差值达到阈值的像素不做时域平均，默认亮度 10、色度 6
+     */
+    void SetThreshold(int luma, int chroma);
+
+    /**
+     * @brief   丢弃所有参考帧（场景切换或跳转后调用）
+     */
+    void Reset();
+
+    /**
+     * @brief   降噪一帧
+     * @param   frame                   [IN]        输入帧，格式和尺寸与构造参数一致
+     * @return  降噪结果，指向内部环形缓冲区，下一次 Process 或 Reset 之前有效
+     */
+    const YuvFrame& Process(const YuvFrame& frame);
+
+private:
+    int          m_references;           // 参考帧数
+    int          m_strength;             // 降噪强度
+    int          m_threshold[2];         // 亮度/色度运动阈值
+    YuvFramePool m_pool;                 // 帧池，references + 1 帧
+    YuvFrame*    m_ring[kMaxReferences]; // 参考帧，m_ring[0] 为最近一帧输出
+    int          m_count;                // 有效参考帧数
+};
+
+/**
+ * @brief   降噪一行
+ * @param   dst                     [OUT]       输出行
+ * @param   cur                     [IN]        当前行
+ * @param   refs                    [IN]        参考行
+ * @param   count                   [IN]        参考行数
+ * @param   threshold               [IN]        运动阈值（1 ~ 127）
+ * @param   gain                    [IN]        权重系数：每个参考帧的最大权重 * 256 / threshold
+ * @param   width                   [IN]        采样数
+ */
+void denoise_row(uint8_t* dst, const uint8_t* cur, const uint8_t* const* refs, int count, int threshold, int gain, int width);
+
+/**
+ * @brief   降噪吞吐测试（1080p 加噪运动方块序列，对比标量实现并输出降噪前后的 PSNR）
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int denoise_benchmark();
+
+/**
+ * @brief   对YUV420P像素数据做时域降噪，写入 <filename>.denoise
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   references              [IN]        参考帧数
+ * @param   strength                [IN]        降噪强度（0 ~ 255）
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_denoise(const std::string& filename, int width, int height, int references, int strength, int number);
+
+#endif
@@ -0,0 +1,486 @@
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/thread_pool.hpp"
+#include "yuv_filter.h"
+#include "yuv_lut.h"
+
+namespace
+{
+    constexpr int kBandRows = 16; // 行带高度（偶数，保证色度行与亮度行对齐）
+
+    inline int round_even(int value)
+    {
+        return value & ~1;
+    }
+
+    template <typename T>
+    bool read_plane(std::ifstream& file, T* dst, int stride, int width, int height)
+    {
+        if (stride == width)
+        {
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(width) * height * sizeof(T)));
+        }
+        for (int y = 0; y < height; y++)
+        {
+            if (!file.read(reinterpret_cast<char*>(dst + static_cast<size_t>(y) * stride), width * sizeof(T)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T>
+    void write_plane(std::ofstream& file, const T* src, int stride, int width, int height)
+    {
+        if (stride == width)
+        {
+            file.write(reinterpret_cast<const char*>(src), static_cast<std::streamsize>(width) * height * sizeof(T));
+            return;
+        }
+        for (int y = 0; y < height; y++)
+        {
+            file.write(reinterpret_cast<const char*>(src + static_cast<size_t>(y) * stride), width * sizeof(T));
+        }
+    }
+
+    /**
+     * 在 [rowBegin, rowEnd) 范围内把平面上 [x0, x1) 列置为 value
+     */
+    template <typename T>
+    void fill_span(T* plane, int stride, int rowBegin, int rowEnd, int x0, int x1, T value)
+    {
+        if (x1 <= x0)
+        {
+            return;
+        }
+        for (int y = rowBegin; y < rowEnd; y++)
+        {
+            T* row = plane + static_cast<size_t>(y) * stride;
+            std::fill(row + x0, row + x1, value);
+        }
+    }
+
+    // 亮度查表：8 位走 SIMD 内核，高位深逐点查表，超出位深的值按最大值处理（与 PointLut 相同）
+    void apply_lut_row(const std::vector<uint8_t>& lut, uint8_t* p, int width)
+    {
+        lut_apply_row(lut.data(), p, p, width);
+    }
+
+    void apply_lut_row(const std::vector<uint16_t>& lut, uint16_t* p, int width)
+    {
+        uint16_t max = static_cast<uint16_t>(lut.size() - 1);
+        for (int x = 0; x < width; x++)
+        {
+            p[x] = lut[std::min(p[x], max)];
+        }
+    }
+} // namespace
+
+template <typename T>
+YuvFilterChain<T>::YuvFilterChain(int width, int height, int bitDepth)
+    : m_width(width)
+    , m_height(height)
+    , m_bit_depth(bitDepth)
+    , m_view{0, 0, width, height}
+    , m_bounds{0, 0, width, height}
+{
+    // 位深不合法时记为 0，查表按 8 位建立，Run 直接返回失败
+    if (bitDepth < 8 || bitDepth > static_cast<int>(sizeof(T)) * 8 || (sizeof(T) > 1 && bitDepth == 8))
+    {
+        SPDLOG_ERROR("Invalid bit depth: {}", bitDepth);
+        m_bit_depth = 0;
+    }
+}
+
+template <typename T>
+typename YuvFilterChain<T>::Stage& YuvFilterChain<T>::AddStage(StageType type)
+{
+    m_stages.emplace_back();
+    Stage& stage = m_stages.back();
+    stage.type   = type;
+    stage.before = m_view;
+    stage.after  = m_view;
+    return stage;
+}
+
+template <typename T>
+T YuvFilterChain<T>::Level(int value) const
+{
+    int shift = std::max(m_bit_depth - 8, 0);
+    return static_cast<T>(std::clamp(value, 0, 255) << shift);
+}
+
+template <typename T>
+YuvFilterChain<T>& YuvFilterChain<T>::Gray()
+{
+    AddStage(STAGE_GRAY);
+    return *this;
+}
+
+template <typename T>
+YuvFilterChain<T>& YuvFilterChain<T>::ScaleLuma(int num, int den)
+{
+    Stage& stage = AddStage(STAGE_LUT);
+    int    max   = (1 << std::max(m_bit_depth, 8)) - 1;
+    stage.lut.resize(max + 1);
+    den = std::max(den, 1);
+    for (int i = 0; i <= max; i++)
+    {
+        stage.lut[i] = static_cast<T>(std::clamp(static_cast<int>(static_cast<int64_t>(i) * num / den), 0, max));
+    }
+    return *this;
+}
+
+template <typename T>
+YuvFilterChain<T>& YuvFilterChain<T>::Lut(const PointLut& luma)
+{
+    if (luma.BitDepth() != m_bit_depth)
+    {
+        SPDLOG_ERROR("YuvFilterChain: {}-bit LUT on a {}-bit chain", luma.BitDepth(), m_bit_depth);
+        return *this;
+    }
+    Stage& stage = AddStage(STAGE_LUT);
+    if (luma.Table8() != nullptr)
+    {
+        stage.lut.assign(luma.Table8(), luma.Table8() + 256);
+    }
+    else
+    {
+        stage.lut.assign(luma.Table16(), luma.Table16() + (1 << m_bit_depth));
+    }
+    return *this;
+}
+
+template <typename T>
+YuvFilterChain<T>& YuvFilterChain<T>::Border(int size, int value)
+{
+    Stage& stage   = AddStage(STAGE_BORDER);
+    stage.size     = std::max(size, 0);
+    stage.color[0] = Level(value);
+    return *this;
+}
+
+template <typename T>
+YuvFilterChain<T>& YuvFilterChain<T>::Crop(int x, int y, int width, int height)
+{
+    Stage& stage = AddStage(STAGE_CROP);
+    x            = round_even(std::clamp(x, 0, m_view.width - 2));
+    y            = round_even(std::clamp(y, 0, m_view.height - 2));
+    width        = round_even(std::clamp(width, 2, m_view.width - x));
+    height       = round_even(std::clamp(height, 2, m_view.height - y));
+    stage.after  = {m_view.x + x, m_view.y + y, width, height};
+    m_view       = stage.after;
+    return *this;
+}
+
+template <typename T>
+YuvFilterChain<T>& YuvFilterChain<T>::Pad(int left, int top, int right, int bottom, int y, int u, int v)
+{
+    Stage& stage   = AddStage(STAGE_PAD);
+    left           = round_even(std::max(left, 0));
+    top            = round_even(std::max(top, 0));
+    right          = round_even(std::max(right, 0));
+    bottom         = round_even(std::max(bottom, 0));
+    stage.after    = {m_view.x - left, m_view.y - top, m_view.width + left + right, m_view.height + top + bottom};
+    stage.color[0] = Level(y);
+    stage.color[1] = Level(u);
+    stage.color[2] = Level(v);
+    m_view         = stage.after;
+
+    // 画布需要同时容纳输入帧和所有阶段的可见区域
+    int x0   = std::min(m_bounds.x, m_view.x);
+    int y0   = std::min(m_bounds.y, m_view.y);
+    int x1   = std::max(m_bounds.x + m_bounds.width, m_view.x + m_view.width);
+    int y1   = std::max(m_bounds.y + m_bounds.height, m_view.y + m_view.height);
+    m_bounds = {x0, y0, x1 - x0, y1 - y0};
+    return *this;
+}
+
+template <typename T>
+YuvFilterChain<T>& YuvFilterChain<T>::Overlay(const T* image, int width, int height, int x, int y, int opacity)
+{
+    Stage& stage       = AddStage(STAGE_OVERLAY);
+    width              = round_even(width);
+    height             = round_even(height);
+    x                  = round_even(x);
+    y                  = round_even(y);
+    stage.image_width  = width;
+    stage.image_height = height;
+    stage.opacity      = std::clamp(opacity, 0, 256);
+    stage.image.assign(image, image + static_cast<size_t>(width) * height * 3 / 2);
+
+    // 与可见区域求交
+    int x0         = std::max(m_view.x + x, m_view.x);
+    int y0         = std::max(m_view.y + y, m_view.y);
+    int x1         = std::min(m_view.x + x + width, m_view.x + m_view.width);
+    int y1         = std::min(m_view.y + y + height, m_view.y + m_view.height);
+    stage.target   = {x0, y0, std::max(x1 - x0, 0), std::max(y1 - y0, 0)};
+    stage.offset_x = x0 - (m_view.x + x);
+    stage.offset_y = y0 - (m_view.y + y);
+    return *this;
+}
+
+template <typename T>
+void YuvFilterChain<T>::ApplyStage(const Stage& stage, const Canvas& canvas, int begin, int end) const
+{
+    // 把以输入帧为原点的矩形换算到画布上，并与行带 [begin, end) 求交
+    auto rows = [&](const Rect& rect, int shift, int& rowBegin, int& rowEnd) {
+        rowBegin = std::max((rect.y + canvas.origin_y) >> shift, begin >> shift);
+        rowEnd   = std::min((rect.y + canvas.origin_y + rect.height) >> shift, end >> shift);
+        return rowBegin < rowEnd;
+    };
+    int rowBegin, rowEnd;
+
+    switch (stage.type)
+    {
+    case STAGE_GRAY:
+    {
+        const Rect& view = stage.before;
+        if (rows(view, 1, rowBegin, rowEnd))
+        {
+            int x0 = (view.x + canvas.origin_x) >> 1;
+            T  half = static_cast<T>(1 << (m_bit_depth - 1));
+            fill_span(canvas.plane[1], canvas.stride[1], rowBegin, rowEnd, x0, x0 + view.width / 2, half);
+            fill_span(canvas.plane[2], canvas.stride[2], rowBegin, rowEnd, x0, x0 + view.width / 2, half);
+        }
+        break;
+    }
+    case STAGE_LUT:
+    {
+        const Rect& view = stage.before;
+        if (rows(view, 0, rowBegin, rowEnd))
+        {
+            for (int y = rowBegin; y < rowEnd; y++)
+            {
+                T* p = canvas.plane[0] + static_cast<size_t>(y) * canvas.stride[0] + view.x + canvas.origin_x;
+                apply_lut_row(stage.lut, p, view.width);
+            }
+        }
+        break;
+    }
+    case STAGE_BORDER:
+    {
+        const Rect& view = stage.before;
+        if (rows(view, 0, rowBegin, rowEnd))
+        {
+            int x0     = view.x + canvas.origin_x;
+            int x1     = x0 + view.width;
+            int y0     = view.y + canvas.origin_y;
+            int y1     = y0 + view.height;
+            int size   = std::min(stage.size, std::max(view.width, view.height));
+            int inner0 = std::min(x0 + size, x1);
+            int inner1 = std::max(x1 - size, inner0);
+            for (int y = rowBegin; y < rowEnd; y++)
+            {
+                if (y < y0 + size || y >= y1 - size)
+                {
+                    fill_span(canvas.plane[0], canvas.stride[0], y, y + 1, x0, x1, stage.color[0]);
+                }
+                else
+                {
+                    fill_span(canvas.plane[0], canvas.stride[0], y, y + 1, x0, inner0, stage.color[0]);
+                    fill_span(canvas.plane[0], canvas.stride[0], y, y + 1, inner1, x1, stage.color[0]);
+                }
+            }
+        }
+        break;
+    }
+    case STAGE_CROP:
+        // 只移动可见区域，不触碰像素
+        break;
+    case STAGE_PAD:
+    {
+        // 只填充 after 中不属于 before 的部分
+        for (int p = 0; p < 3; p++)
+        {
+            int         shift = (p == 0) ? 0 : 1;
+            const Rect& outer = stage.after;
+            const Rect& inner = stage.before;
+            if (!rows(outer, shift, rowBegin, rowEnd))
+            {
+                continue;
+            }
+            int ox0 = (outer.x + canvas.origin_x) >> shift;
+            int ox1 = (outer.x + canvas.origin_x + outer.width) >> shift;
+            int ix0 = (inner.x + canvas.origin_x) >> shift;
+            int ix1 = (inner.x + canvas.origin_x + inner.width) >> shift;
+            int iy0 = (inner.y + canvas.origin_y) >> shift;
+            int iy1 = (inner.y + canvas.origin_y + inner.height) >> shift;
+            for (int y = rowBegin; y < rowEnd; y++)
+            {
+                if (y < iy0 || y >= iy1)
+                {
+                    fill_span(canvas.plane[p], canvas.stride[p], y, y + 1, ox0, ox1, stage.color[p]);
+                }
+                else
+                {
+                    fill_span(canvas.plane[p], canvas.stride[p], y, y + 1, ox0, ix0, stage.color[p]);
+                    fill_span(canvas.plane[p], canvas.stride[p], y, y + 1, ix1, ox1, stage.color[p]);
+                }
+            }
+        }
+        break;
+    }
+    case STAGE_OVERLAY:
+    {
+        const Rect& target = stage.target;
+        if (target.width == 0 || target.height == 0)
+        {
+            break;
+        }
+        const T* planes[3];
+        planes[0] = stage.image.data();
+        planes[1] = planes[0] + stage.image_width * stage.image_height;
+        planes[2] = planes[1] + stage.image_width * stage.image_height / 4;
+        for (int p = 0; p < 3; p++)
+        {
+            int shift = (p == 0) ? 0 : 1;
+            if (!rows(target, shift, rowBegin, rowEnd))
+            {
+                continue;
+            }
+            int imageStride = stage.image_width >> shift;
+            int width       = target.width >> shift;
+            int srcX        = stage.offset_x >> shift;
+            int srcY        = (stage.offset_y >> shift) - ((target.y + canvas.origin_y) >> shift);
+            int dstX        = (target.x + canvas.origin_x) >> shift;
+            int alpha       = stage.opacity;
+            for (int y = rowBegin; y < rowEnd; y++)
+            {
+                const T* s = planes[p] + static_cast<size_t>(srcY + y) * imageStride + srcX;
+                T*       d = canvas.plane[p] + static_cast<size_t>(y) * canvas.stride[p] + dstX;
+                if (alpha == 256)
+                {
+                    memcpy(d, s, width * sizeof(T));
+                    continue;
+                }
+                for (int x = 0; x < width; x++)
+                {
+                    d[x] = static_cast<T>((s[x] * alpha + d[x] * (256 - alpha) + 128) >> 8);
+                }
+            }
+        }
+        break;
+    }
+    }
+}
+
+template <typename T>
+void YuvFilterChain<T>::ProcessBand(const Canvas& canvas, int begin, int end) const
+{
+    for (const Stage& stage : m_stages)
+    {
+        ApplyStage(stage, canvas, begin, end);
+    }
+}
+
+template <typename T>
+int YuvFilterChain<T>::Run(const std::string& input, const std::string& output, int number) const
+{
+    if ((m_width & 1) || (m_height & 1) || m_width <= 0 || m_height <= 0)
+    {
+        SPDLOG_ERROR("Invalid frame size: {}x{}", m_width, m_height);
+        return -1;
+    }
+    if (m_bit_depth == 0)
+    {
+        SPDLOG_ERROR("Invalid bit depth");
+        return -1;
+    }
+
+    std::ifstream iFile(input, std::ios::in | std::ios::binary);
+    std::ofstream oFile(output, std::ios::out | std::ios::binary);
+    if (!iFile.is_open() || !oFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {} or {}", input, output);
+        return -1;
+    }
+
+    int canvasWidth  = m_bounds.width;
+    int canvasHeight = m_bounds.height;
+    int canvasSize   = canvasWidth * canvasHeight * 3 / 2;
+
+    // 每个在途帧占用一块画布，画布数 = 在途帧上限 = 线程数的2倍
+    ThreadPool                    pool;
+    int                           slots = pool.Size() * 2;
+    std::vector<AlignedBuffer<T>> buffers(slots);
+    std::vector<Canvas>           canvases(slots);
+    for (int i = 0; i < slots; i++)
+    {
+        buffers[i].Resize(canvasSize);
+        Canvas& canvas   = canvases[i];
+        canvas.plane[0]  = buffers[i].Data();
+        canvas.plane[1]  = canvas.plane[0] + canvasWidth * canvasHeight;
+        canvas.plane[2]  = canvas.plane[1] + canvasWidth * canvasHeight / 4;
+        canvas.stride[0] = canvasWidth;
+        canvas.stride[1] = canvasWidth / 2;
+        canvas.stride[2] = canvasWidth / 2;
+        canvas.origin_x  = -m_bounds.x;
+        canvas.origin_y  = -m_bounds.y;
+    }
+
+    auto writeFrame = [&](const Canvas& canvas) {
+        for (int p = 0; p < 3; p++)
+        {
+            int      shift = (p == 0) ? 0 : 1;
+            const T* src   = canvas.plane[p] + static_cast<size_t>((m_view.y + canvas.origin_y) >> shift) * canvas.stride[p] + ((m_view.x + canvas.origin_x) >> shift);
+            write_plane(oFile, src, canvas.stride[p], m_view.width >> shift, m_view.height >> shift);
+        }
+    };
+
+    std::deque<std::pair<int, std::future<void>>> pending;
+    for (int i = 0; i < number; i++)
+    {
+        int slot = i % slots;
+        if (static_cast<int>(pending.size()) == slots)
+        {
+            // 队首帧占用的正是本帧要用的画布
+            pending.front().second.get();
+            writeFrame(canvases[pending.front().first]);
+            pending.pop_front();
+        }
+
+        const Canvas& canvas = canvases[slot];
+        bool          ok     = true;
+        for (int p = 0; p < 3 && ok; p++)
+        {
+            int shift = (p == 0) ? 0 : 1;
+            T*  dst   = canvas.plane[p] + static_cast<size_t>(canvas.origin_y >> shift) * canvas.stride[p] + (canvas.origin_x >> shift);
+            ok             = read_plane(iFile, dst, canvas.stride[p], m_width >> shift, m_height >> shift);
+        }
+        if (!ok)
+        {
+            break;
+        }
+
+        pending.emplace_back(slot, pool.Submit([this, &canvas, canvasHeight]() {
+            for (int begin = 0; begin < canvasHeight; begin += kBandRows)
+            {
+                ProcessBand(canvas, begin, std::min(begin + kBandRows, canvasHeight));
+            }
+        }));
+    }
+    while (!pending.empty())
+    {
+        pending.front().second.get();
+        writeFrame(canvases[pending.front().first]);
+        pending.pop_front();
+    }
+
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
+
+template class YuvFilterChain<uint8_t>;
+template class YuvFilterChain<uint16_t>;
@@ -0,0 +1,153 @@
+#ifndef __YUV_FILTER_H__
+#define __YUV_FILTER_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PointLut;
+
+/**
+ * @brief   YUV420P 滤镜链，按采样类型模板化：uint8_t 为 8 位，uint16_t 为低位对齐的 10/12/16 位（yuv420p10le 等）
+ * 1. 阶段按添加顺序执行，所有几何信息（裁剪、填充后的可见区域）在添加时确定
+ * 2. 每帧只读入一次，放进足以容纳所有阶段可见区域的画布中，裁剪只移动可见区域，
+ *    填充只写新增的边缘，全部阶段都在画布上原地完成，不产生中间帧
+ * 3. 画布按16行一个行带处理，每个行带依次经过所有阶段后再处理下一个行带，数据始终在缓存中
+ * 4. Run 以帧为单位多线程并行，按帧顺序写出；画布在帧之间复用
+ * 裁剪、填充、叠加的坐标和尺寸都相对于当前可见区域，并向下取偶数（420 色度对齐）
+ * 边框、填充的颜色按 8 位刻度给出，高位深时左移 bitDepth - 8 位（与 plane_widen 一致）
+ */
+template <typename T>
+class YuvFilterChain
+{
+public:
+    /**
+     * @param   width                   [IN]        输入宽度（偶数）
+     * @param   height                  [IN]        输入高度（偶数）
+     * @param   bitDepth                [IN]        位深，uint8_t 只能为 8，uint16_t 为 9~16
+     */
+    YuvFilterChain(int width, int height, int bitDepth = sizeof(T) == 1 ? 8 : 10);
+    ~YuvFilterChain() = default;
+
+    /**
+     * @brief   去掉颜色（U、V 置为中值，8 位为 128）
+     */
+    YuvFilterChain& Gray();
+
+    /**
+     * @brief   亮度缩放 Y = Y * num / den（查表），例如 (1, 2) 为亮度减半
+     */
+    YuvFilterChain& ScaleLuma(int num, int den);
+
+    /**
+     * @brief   亮度查表（伽马、对比度、色阶等点运算），表的位深必须与滤镜链一致
+     */
+    YuvFilterChain& Lut(const PointLut& luma);
+
+    /**
+     * @brief   在可见区域四周画边框（只修改亮度）
+     * @param   size                    [IN]        边框宽度
+     * @param   value                   [IN]        边框亮度（8 位刻度）
+     */
+    YuvFilterChain& Border(int size, int value = 0);
+
+    /**
+     * @brief   裁剪，可见区域变为 (x, y, width, height)
+     */
+    YuvFilterChain& Crop(int x, int y, int width, int height);
+
+    /**
+     * @brief   四周填充纯色（8 位刻度），可见区域相应扩大
+     */
+    YuvFilterChain& Pad(int left, int top, int right, int bottom, int y = 16, int u = 128, int v = 128);
+
+    /**
+     * @brief   叠加一幅 YUV420P 图像，超出可见区域的部分被裁掉
+     * @param   image                   [IN]        连续存储的 YUV420P 图像，位深与滤镜链相同（内部拷贝一份）
+     * @param   width                   [IN]        图像宽度（偶数）
+     * @param   height                  [IN]        图像高度（偶数）
+     * @param   x                       [IN]        相对可见区域的水平位置（可为负）
+     * @param   y                       [IN]        相对可见区域的垂直位置（可为负）
+     * @param   opacity                 [IN]        不透明度 0~256，256 为直接覆盖
+     */
+    YuvFilterChain& Overlay(const T* image, int width, int height, int x, int y, int opacity = 256);
+
+    int OutputWidth() const
+    {
+        return m_view.width;
+    }
+
+    int OutputHeight() const
+    {
+        return m_view.height;
+    }
+
+    /**
+     * @brief   对输入文件的每一帧执行滤镜链
+     * @param   input                   [IN]        yuv420 输入文件路径（高位深时每个采样 2 字节）
+     * @param   output                  [IN]        yuv420 输出文件路径，帧尺寸为 OutputWidth() x OutputHeight()
+     * @param   number                  [IN]        处理的帧数
+     * @return  0                                   成功
+     *          其他                                失败
+     */
+    int Run(const std::string& input, const std::string& output, int number) const;
+
+private:
+    enum StageType
+    {
+        STAGE_GRAY    = 0,
+        STAGE_LUT     = 1,
+        STAGE_BORDER  = 2,
+        STAGE_CROP    = 3,
+        STAGE_PAD     = 4,
+        STAGE_OVERLAY = 5,
+    };
+
+    typedef struct Rect
+    {
+        int x;
+        int y;
+        int width;
+        int height;
+    } Rect;
+
+    typedef struct Stage
+    {
+        StageType      type;
+        Rect           before;       // 执行前的可见区域（以输入帧左上角为原点）
+        Rect           after;        // 执行后的可见区域
+        int            size;         // 边框宽度
+        T              color[3];     // 边框/填充颜色（已换算到位深）
+        std::vector<T> lut;          // 亮度查找表，1 << bitDepth 项
+        std::vector<T> image;        // 叠加图像（YUV420P）
+        int            image_width;  // 叠加图像宽度
+        int            image_height; // 叠加图像高度
+        Rect           target;       // 叠加图像实际覆盖的区域（已按可见区域裁剪）
+        int            offset_x;     // target 左上角对应叠加图像中的位置
+        int            offset_y;
+        int            opacity;      // 叠加不透明度
+    } Stage;
+
+    typedef struct Canvas
+    {
+        T*  plane[3];
+        int stride[3]; // 行跨度（采样点数）
+        int origin_x;  // 输入帧左上角在画布中的位置
+        int origin_y;
+    } Canvas;
+
+    Stage& AddStage(StageType type);
+    T      Level(int value) const;
+    void   ProcessBand(const Canvas& canvas, int begin, int end) const;
+    void   ApplyStage(const Stage& stage, const Canvas& canvas, int begin, int end) const;
+
+private:
+    int                m_width;     // 输入宽度
+    int                m_height;    // 输入高度
+    int                m_bit_depth; // 位深
+    Rect               m_view;      // 当前可见区域
+    Rect               m_bounds;    // 所有阶段可见区域的外包矩形，即画布大小
+    std::vector<Stage> m_stages;    // 阶段列表
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef __YUV_FRAME_H__
+#define __YUV_FRAME_H__
+
+#include <cstdint>
+
+enum YuvFormat
+{
+    YUV_FORMAT_I420 = 0, // YUV420P，Y、U、V 三个平面
+    YUV_FORMAT_I422 = 1, // YUV422P
+    YUV_FORMAT_I444 = 2, // YUV444P
+    YUV_FORMAT_NV12 = 3, // Y 平面 + UV 交织平面
+    YUV_FORMAT_NV21 = 4, // Y 平面 + VU 交织平面
+};
+
+/**
+ * @brief   帧视图，不持有内存
+ * 平面可以来自同一块连续缓冲区，也可以分别指向带行跨度的外部内存；
+ * 半平面格式（NV12/NV21）只使用 data[0] 和 data[1]；高位深帧的平面存放低位对齐的 uint16_t 采样
+ */
+typedef struct YuvFrame
+{
+    YuvFormat format;    // 像素格式
+    int       width;     // 宽度
+    int       height;    // 高度
+    uint8_t*  data[3];   // 平面指针
+    int       stride[3]; // 平面行跨度（字节）
+} YuvFrame;
+
+/**
+ * @brief   色度平面的水平/垂直下采样倍数（log2）
+ */
+inline void yuv_chroma_shift(YuvFormat format, int& shiftX, int& shiftY)
+{
+    shiftX = (format == YUV_FORMAT_I444) ? 0 : 1;
+    shiftY = (format == YUV_FORMAT_I420 || format == YUV_FORMAT_NV12 || format == YUV_FORMAT_NV21) ? 1 : 0;
+}
+
+/**
+ * @brief   是否为半平面（UV交织）格式
+ */
+inline bool yuv_is_semi_planar(YuvFormat format)
+{
+    return format == YUV_FORMAT_NV12 || format == YUV_FORMAT_NV21;
+}
+
+/**
+ * @brief   格式名，同时用作输出文件扩展名
+ */
+inline const char* yuv_format_name(YuvFormat format)
+{
+    switch (format)
+    {
+    case YUV_FORMAT_I422: return "i422";
+    case YUV_FORMAT_I444: return "i444";
+    case YUV_FORMAT_NV12: return "nv12";
+    case YUV_FORMAT_NV21: return "nv21";
+    default: return "i420";
+    }
+}
+
+/**
+ * @brief   连续存储时一帧的字节数
+ * @param   sampleBytes             [IN]        每个采样的字节数，高位深（低位对齐的 16 位采样）为 2
+ */
+inline int yuv_frame_size(YuvFormat format, int width, int height, int sampleBytes = 1)
+{
+    int shiftX, shiftY;
+    yuv_chroma_shift(format, shiftX, shiftY);
+    int chromaWidth  = (width + (1 << shiftX) - 1) >> shiftX;
+    int chromaHeight = (height + (1 << shiftY) - 1) >> shiftY;
+    return (width * height + chromaWidth * chromaHeight * 2) * sampleBytes;
+}
+
+/**
+ * @brief   把连续缓冲区按格式切分为帧视图（与 ffmpeg rawvideo 布局一致）
+ * @param   buffer                  [IN]        帧数据，至少 yuv_frame_size 字节
+ * @param   format                  [IN]        像素格式
+ * @param   width                   [IN]        宽度
+ * @param   height                  [IN]        高度
+ * @param   sampleBytes             [IN]        每个采样的字节数，高位深为 2（行跨度相应加倍）
+ * @return  帧视图
+ */
+inline YuvFrame yuv_frame_wrap(uint8_t* buffer, YuvFormat format, int width, int height, int sampleBytes = 1)
+{
+    int shiftX, shiftY;
+    yuv_chroma_shift(format, shiftX, shiftY);
+    int chromaWidth  = (width + (1 << shiftX) - 1) >> shiftX;
+    int chromaHeight = (height + (1 << shiftY) - 1) >> shiftY;
+
+    YuvFrame frame  = {};
+    frame.format    = format;
+    frame.width     = width;
+    frame.height    = height;
+    frame.data[0]   = buffer;
+    frame.stride[0] = width * sampleBytes;
+    if (yuv_is_semi_planar(format))
+    {
+        frame.data[1]   = buffer + width * height * sampleBytes;
+        frame.stride[1] = chromaWidth * 2 * sampleBytes;
+    }
+    else
+    {
+        frame.data[1]   = buffer + width * height * sampleBytes;
+        frame.data[2]   = frame.data[1] + chromaWidth * chromaHeight * sampleBytes;
+        frame.stride[1] = chromaWidth * sampleBytes;
+        frame.stride[2] = chromaWidth * sampleBytes;
+    }
+    return frame;
+}
+
+#endif
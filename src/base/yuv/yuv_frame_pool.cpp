@@ -0,0 +1,66 @@
+#include "yuv_frame_pool.h"
+
+namespace
+{
+    int align_stride(int bytes)
+    {
+        return (bytes + static_cast<int>(AlignedBuffer<uint8_t>::kAlignment) - 1) & ~(static_cast<int>(AlignedBuffer<uint8_t>::kAlignment) - 1);
+    }
+} // namespace
+
+YuvFramePool::YuvFramePool(YuvFormat format, int width, int height, int capacity)
+    : m_frames(capacity)
+{
+    int shiftX, shiftY;
+    yuv_chroma_shift(format, shiftX, shiftY);
+    int chromaWidth  = (width + (1 << shiftX) - 1) >> shiftX;
+    int chromaHeight = (height + (1 << shiftY) - 1) >> shiftY;
+    int planes       = yuv_is_semi_planar(format) ? 2 : 3;
+
+    int    strides[3] = {align_stride(width), align_stride(yuv_is_semi_planar(format) ? chromaWidth * 2 : chromaWidth), 0};
+    size_t sizes[3]   = {static_cast<size_t>(strides[0]) * height, static_cast<size_t>(strides[1]) * chromaHeight, 0};
+    if (planes == 3)
+    {
+        strides[2] = strides[1];
+        sizes[2]   = sizes[1];
+    }
+    size_t frameSize = sizes[0] + sizes[1] + sizes[2];
+    m_buffer.Resize(frameSize * capacity);
+
+    m_free.reserve(capacity);
+    for (int i = 0; i < capacity; i++)
+    {
+        YuvFrame& frame = m_frames[i];
+        uint8_t*  data  = m_buffer.Data() + frameSize * i;
+        frame           = {};
+        frame.format    = format;
+        frame.width     = width;
+        frame.height    = height;
+        for (int p = 0; p < planes; p++)
+        {
+            frame.data[p]   = data;
+            frame.stride[p] = strides[p];
+            data += sizes[p];
+        }
+        m_free.push_back(&frame);
+    }
+}
+
+YuvFrame* YuvFramePool::Acquire()
+{
+    if (m_free.empty())
+    {
+        return nullptr;
+    }
+    YuvFrame* frame = m_free.back();
+    m_free.pop_back();
+    return frame;
+}
+
+void YuvFramePool::Release(YuvFrame* frame)
+{
+    if (frame)
+    {
+        m_free.push_back(frame);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef __YUV_FRAME_POOL_H__
+#define __YUV_FRAME_POOL_H__
+
+#include <vector>
+
+#include "base/common/aligned_buffer.hpp"
+#include "yuv_frame.h"
+
+/**
+ * @brief   固定容量的帧池
+ * 1. 构造时一次性分配 capacity 帧，之后 Acquire/Release 只在空闲表上进出，不再分配内存
+ * 2. 每个平面的行跨度按 64 字节取整，平面起始地址 64 字节对齐，便于 SIMD 整行处理
+ * 3. 不加锁，由持有者在同一线程内取还
+ */
+class YuvFramePool
+{
+public:
+    /**
+     * @param   format                  [IN]        像素格式
+     * @param   width                   [IN]        宽度
+     * @param   height                  [IN]        高度
+     * @param   capacity                [IN]        帧数
+     */
+    YuvFramePool(YuvFormat format, int width, int height, int capacity);
+    ~YuvFramePool() = default;
+
+    YuvFramePool(const YuvFramePool&)            = delete;
+    YuvFramePool& operator=(const YuvFramePool&) = delete;
+
+    /**
+     * @brief   取出一帧，内容未初始化
+     * @return  帧指针，池已取空时返回 nullptr
+     */
+    YuvFrame* Acquire();
+
+    /**
+     * @brief   归还 Acquire 取出的帧
+     */
+    void Release(YuvFrame* frame);
+
+    int Capacity() const
+    {
+        return static_cast<int>(m_frames.size());
+    }
+
+    int Available() const
+    {
+        return static_cast<int>(m_free.size());
+    }
+
+private:
+    AlignedBuffer<uint8_t> m_buffer; // 所有帧共用的一块内存
+    std::vector<YuvFrame>  m_frames; // 帧视图
+    std::vector<YuvFrame*> m_free;   // 空闲帧
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef __YUV_LUT_H__
+#define __YUV_LUT_H__
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief   点运算查找表
+ * 1. 亮度/色度的逐点变换（伽马、对比度、亮度、色阶、曲线）按调用顺序复合，
+ *    复合过程在 [0, 1] 浮点域进行，避免逐级量化误差，最终编译为 1 << bitDepth 项的表
+ * 2. 8 位表用 pshufb 半字节查表（SSSE3 每次16个采样、AVX2 每次32个），不需要 gather；
+ *    10/12/16 位表较大，逐点查表
+ * 3. Apply 按行带多线程
+ * 所有参数都是归一化值，与位深无关
+ */
+class PointLut
+{
+public:
+    /**
+     * @param   bitDepth                [IN]        采样位深（8~16）
+     */
+    explicit PointLut(int bitDepth = 8);
+    ~PointLut() = default;
+
+    /**
+     * @brief   伽马：y = x ^ (1 / gamma)，gamma > 1 提亮暗部
+     */
+    PointLut& Gamma(double gamma);
+
+    /**
+     * @brief   对比度：以 0.5 为中心缩放，y = (x - 0.5) * contrast + 0.5
+     */
+    PointLut& Contrast(double contrast);
+
+    /**
+     * @brief   亮度：y = x + offset
+     */
+    PointLut& Brightness(double offset);
+
+    /**
+     * @brief   色阶：把 [inLow, inHigh] 映射到 [outLow, outHigh]，中间调按 gamma 调整
+     */
+    PointLut& Levels(double inLow, double inHigh, double outLow, double outHigh, double gamma = 1.0);
+
+    /**
+     * @brief   曲线：过给定控制点的单调三次插值（Fritsch-Carlson），控制点按 x 排序
+     * @param   points                  [IN]        控制点 (x, y)，至少两个
+     */
+    PointLut& Curves(std::vector<std::pair<double, double>> points);
+
+    /**
+     * @brief   对 8 位平面查表，dst 可与 src 相同（要求位深为 8）
+     * @param   src                     [IN]        源平面
+     * @param   srcStride               [IN]        源平面行跨度（字节）
+     * @param   dst                     [OUT]       目标平面
+     * @param   dstStride               [IN]        目标平面行跨度（字节）
+     * @param   width                   [IN]        平面宽度
+     * @param   height                  [IN]        平面高度
+     */
+    void Apply(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height) const;
+
+    /**
+     * @brief   对 10/12/16 位平面查表（低位对齐存储），超出位深的值按最大值处理
+     * @param   srcStride               [IN]        源平面行跨度（采样点数）
+     * @param   dstStride               [IN]        目标平面行跨度（采样点数）
+     */
+    void Apply(const uint16_t* src, int srcStride, uint16_t* dst, int dstStride, int width, int height) const;
+
+    int BitDepth() const
+    {
+        return m_bit_depth;
+    }
+
+    /**
+     * @brief   8 位表（256 项），位深不为 8 时为空
+     */
+    const uint8_t* Table8() const
+    {
+        return m_table8.empty() ? nullptr : m_table8.data();
+    }
+
+    /**
+     * @brief   高位深表（1 << BitDepth() 项），位深为 8 时为空
+     */
+    const uint16_t* Table16() const
+    {
+        return m_table16.empty() ? nullptr : m_table16.data();
+    }
+
+private:
+    void Compile();
+
+private:
+    int                   m_bit_depth; // 采样位深
+    std::vector<double>   m_curve;     // 归一化的复合曲线
+    std::vector<uint8_t>  m_table8;    // 8 位表
+    std::vector<uint16_t> m_table16;   // 高位深表
+};
+
+/**
+ * @brief   8 位查表内核：dst[i] = table[src[i]]，运行时选择 AVX2/SSSE3，否则回退标量实现
+ * @param   table                   [IN]        256 项查找表
+ * @param   src                     [IN]        源数据
+ * @param   dst                     [OUT]       目标数据，可与 src 相同
+ * @param   count                   [IN]        采样数
+ */
+void lut_apply_row(const uint8_t* table, const uint8_t* src, uint8_t* dst, int count);
+
+/**
+ * @brief   8 位查表内核的吞吐测试（1080p 亮度平面，对比标量实现）
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int lut_benchmark();
+
+/**
+ * @brief   对YUV420P像素数据的亮度做调色（伽马、对比度、亮度）
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   gamma                   [IN]        伽马
+ * @param   contrast                [IN]        对比度
+ * @param   brightness              [IN]        亮度偏移（归一化）
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_grade(const std::string& filename, int width, int height, double gamma, double contrast, double brightness, int number);
+
+#endif
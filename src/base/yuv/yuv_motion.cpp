@@ -0,0 +1,353 @@
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_motion.h"
+#include "yuv_pattern.h"
+
+namespace
+{
+    typedef int (*SadFunc)(const uint8_t*, int, const uint8_t*, int);
+
+    // 六边形模板（顺时针）与小菱形模板
+    constexpr int kHex[6][2]     = {{-1, -2}, {-2, 0}, {-1, 2}, {1, 2}, {2, 0}, {1, -2}};
+    constexpr int kDiamond[4][2] = {{0, -1}, {-1, 0}, {1, 0}, {0, 1}};
+
+    int sad_c(const uint8_t* a, int aStride, const uint8_t* b, int bStride, int size)
+    {
+        int sum = 0;
+        for (int y = 0; y < size; y++)
+        {
+            for (int x = 0; x < size; x++)
+            {
+                sum += std::abs(a[y * aStride + x] - b[y * bStride + x]);
+            }
+        }
+        return sum;
+    }
+
+    int sad_16x16_c(const uint8_t* a, int aStride, const uint8_t* b, int bStride)
+    {
+        return sad_c(a, aStride, b, bStride, 16);
+    }
+
+    /**
+     * @brief   帧内代价：块与其均值的 SAD，均值由与全零块的 SAD 得到
+     */
+    uint32_t intra_cost(const uint8_t* src, int stride, int size, SadFunc sad)
+    {
+        alignas(16) static const uint8_t zero[16 * 16] = {};
+        alignas(16) uint8_t              dc[16 * 16];
+
+        int area = size * size;
+        int mean = (sad(src, stride, zero, 16) + area / 2) / area;
+        memset(dc, mean, sizeof(dc));
+        return static_cast<uint32_t>(sad(src, stride, dc, 16));
+    }
+} // namespace
+
+int block_sad_16x16(const uint8_t* a, int aStride, const uint8_t* b, int bStride)
+{
+#if SIMD_SSE2
+    __m128i acc = _mm_setzero_si128();
+    for (int y = 0; y < 16; y++)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + y * aStride));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + y * bStride));
+        acc        = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+    }
+    return _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+#elif SIMD_NEON
+    uint16x8_t acc = vdupq_n_u16(0);
+    for (int y = 0; y < 16; y++)
+    {
+        uint8x16_t va = vld1q_u8(a + y * aStride);
+        uint8x16_t vb = vld1q_u8(b + y * bStride);
+        acc           = vabal_u8(acc, vget_low_u8(va), vget_low_u8(vb));
+        acc           = vabal_u8(acc, vget_high_u8(va), vget_high_u8(vb));
+    }
+    uint32x4_t sum = vpaddlq_u16(acc);
+    return static_cast<int>(vgetq_lane_u32(sum, 0) + vgetq_lane_u32(sum, 1) + vgetq_lane_u32(sum, 2) + vgetq_lane_u32(sum, 3));
+#else
+    return sad_c(a, aStride, b, bStride, 16);
+#endif
+}
+
+int block_sad_8x8(const uint8_t* a, int aStride, const uint8_t* b, int bStride)
+{
+#if SIMD_SSE2
+    // 两行 8 字节拼成一个寄存器，psadbw 一次处理两行
+    __m128i acc = _mm_setzero_si128();
+    for (int y = 0; y < 8; y += 2)
+    {
+        __m128i va = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + y * aStride)), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + (y + 1) * aStride)));
+        __m128i vb = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + y * bStride)), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + (y + 1) * bStride)));
+        acc        = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+    }
+    return _mm_cvtsi128_si32(acc) + _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+#elif SIMD_NEON
+    uint16x8_t acc = vdupq_n_u16(0);
+    for (int y = 0; y < 8; y++)
+    {
+        acc = vabal_u8(acc, vld1_u8(a + y * aStride), vld1_u8(b + y * bStride));
+    }
+    uint32x4_t sum = vpaddlq_u16(acc);
+    return static_cast<int>(vgetq_lane_u32(sum, 0) + vgetq_lane_u32(sum, 1) + vgetq_lane_u32(sum, 2) + vgetq_lane_u32(sum, 3));
+#else
+    return sad_c(a, aStride, b, bStride, 8);
+#endif
+}
+
+MotionEstimator::MotionEstimator(int width, int height, int blockSize, MotionSearch search, int range)
+    : m_width(width)
+    , m_height(height)
+    , m_block_size(blockSize == 8 ? 8 : 16)
+    , m_search(search)
+    , m_range(std::max(range, 1))
+    , m_blocks_x(width / m_block_size)
+    , m_blocks_y(height / m_block_size)
+    , m_vectors(static_cast<size_t>(m_blocks_x) * m_blocks_y)
+    , m_previous(m_vectors.size())
+{
+}
+
+double MotionEstimator::Estimate(const uint8_t* cur, int curStride, const uint8_t* ref, int refStride)
+{
+    std::atomic<uint64_t> total(0);
+    m_previous.swap(m_vectors);
+
+    auto rows = [&](int begin, int end) {
+        uint64_t cost = 0;
+        for (int by = begin; by < end; by++)
+        {
+            cost += SearchRow(by, cur, curStride, ref, refStride);
+        }
+        total += cost;
+    };
+    parallel_for_rows(m_blocks_y, rows, 2);
+
+    double pixels = static_cast<double>(m_blocks_x) * m_blocks_y * m_block_size * m_block_size;
+    return pixels > 0 ? total / pixels : 0.0;
+}
+
+uint64_t MotionEstimator::SearchRow(int by, const uint8_t* cur, int curStride, const uint8_t* ref, int refStride)
+{
+    SadFunc  sad    = (m_block_size == 16) ? block_sad_16x16 : block_sad_8x8;
+    int      size   = m_block_size;
+    int      lambda = size / 4; // 矢量代价权重，抑制平坦区域的随机矢量
+    uint64_t total  = 0;
+    int      y0     = by * size;
+
+    for (int bx = 0; bx < m_blocks_x; bx++)
+    {
+        int            x0    = bx * size;
+        size_t         index = static_cast<size_t>(by) * m_blocks_x + bx;
+        const uint8_t* src   = cur + static_cast<size_t>(y0) * curStride + x0;
+
+        // 预测矢量：左邻块，第一列用上一次估计的同位置块
+        const MotionVector& temporal = m_previous[index];
+        const MotionVector& left     = bx > 0 ? m_vectors[index - 1] : temporal;
+        int                 px       = left.x;
+        int                 py       = left.y;
+
+        auto cost = [&](int dx, int dy, uint32_t& blockSad) -> uint32_t {
+            if (std::abs(dx) > m_range || std::abs(dy) > m_range || x0 + dx < 0 || y0 + dy < 0 || x0 + dx + size > m_width || y0 + dy + size > m_height)
+            {
+                return UINT32_MAX;
+            }
+            blockSad = static_cast<uint32_t>(sad(src, curStride, ref + static_cast<ptrdiff_t>(y0 + dy) * refStride + x0 + dx, refStride));
+            return blockSad + lambda * (std::abs(dx - px) + std::abs(dy - py));
+        };
+
+        uint32_t sadZero = 0;
+        uint32_t best    = cost(0, 0, sadZero);
+        uint32_t sadBest = sadZero;
+        int      bestX   = 0;
+        int      bestY   = 0;
+
+        auto check = [&](int dx, int dy) {
+            uint32_t blockSad = 0;
+            uint32_t c        = cost(dx, dy, blockSad);
+            if (c < best)
+            {
+                best    = c;
+                sadBest = blockSad;
+                bestX   = dx;
+                bestY   = dy;
+                return true;
+            }
+            return false;
+        };
+        if (left.x != 0 || left.y != 0)
+        {
+            check(left.x, left.y);
+        }
+        if ((temporal.x != left.x || temporal.y != left.y) && (temporal.x != 0 || temporal.y != 0))
+        {
+            check(temporal.x, temporal.y);
+        }
+
+        // 模板迭代：中心最优时停止，迭代次数受搜索范围限制
+        if (m_search == MOTION_SEARCH_HEX)
+        {
+            for (int i = 0; i < m_range; i++)
+            {
+                int  cx = bestX, cy = bestY;
+                bool moved = false;
+                for (const auto& p : kHex)
+                {
+                    moved |= check(cx + p[0], cy + p[1]);
+                }
+                if (!moved)
+                {
+                    break;
+                }
+            }
+            int cx = bestX, cy = bestY;
+            for (const auto& p : kDiamond)
+            {
+                check(cx + p[0], cy + p[1]);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < m_range * 2; i++)
+            {
+                int  cx = bestX, cy = bestY;
+                bool moved = false;
+                for (const auto& p : kDiamond)
+                {
+                    moved |= check(cx + p[0], cy + p[1]);
+                }
+                if (!moved)
+                {
+                    break;
+                }
+            }
+        }
+
+        // 平坦区域各候选 SAD 相同，不沿用邻块矢量，保持零矢量
+        if (sadZero <= sadBest)
+        {
+            bestX   = 0;
+            bestY   = 0;
+            sadBest = sadZero;
+        }
+
+        MotionVector& mv = m_vectors[index];
+        mv.x             = static_cast<int16_t>(bestX);
+        mv.y             = static_cast<int16_t>(bestY);
+        mv.sad           = sadBest;
+        mv.intra         = intra_cost(src, curStride, size, sad);
+        total += std::min(mv.sad, mv.intra);
+    }
+    return total;
+}
+
+int motion_benchmark()
+{
+    constexpr int kWidth      = 1920;
+    constexpr int kHeight     = 1080;
+    constexpr int kIterations = 20;
+    size_t        count       = static_cast<size_t>(kWidth) * kHeight;
+
+    // 波带片相位逐帧平移，取相邻两帧的亮度
+    PatternGenerator       generator(PATTERN_ZONE_PLATE, YUV_FORMAT_I420, kWidth, kHeight);
+    AlignedBuffer<uint8_t> ref(count);
+    AlignedBuffer<uint8_t> cur(count);
+    memcpy(ref.Data(), generator.Render(0).data[0], count);
+    memcpy(cur.Data(), generator.Render(1).data[0], count);
+
+    // 对所有块在 (3, 1) 偏移处求 SAD，对比标量实现
+    int  blocksX  = kWidth / 16 - 1;
+    int  blocksY  = kHeight / 16 - 1;
+    int  checksum = 0;
+    auto sweep    = [&](SadFunc sad) {
+        int sum = 0;
+        for (int by = 0; by < blocksY; by++)
+        {
+            for (int bx = 0; bx < blocksX; bx++)
+            {
+                size_t offset = static_cast<size_t>(by) * 16 * kWidth + bx * 16;
+                sum += sad(cur.Data() + offset, kWidth, ref.Data() + offset + kWidth + 3, kWidth);
+            }
+        }
+        checksum = sum;
+    };
+
+    double scalar = benchmark_throughput([&] { sweep(sad_16x16_c); }, count, kIterations);
+    int    expect = checksum;
+    double simd   = benchmark_throughput([&] { sweep(block_sad_16x16); }, count, kIterations);
+    if (checksum != expect)
+    {
+        SPDLOG_ERROR("Motion: SAD SIMD result mismatch");
+        return -1;
+    }
+
+    MotionEstimator hex(kWidth, kHeight, 16, MOTION_SEARCH_HEX);
+    MotionEstimator diamond(kWidth, kHeight, 16, MOTION_SEARCH_DIAMOND);
+    double          hexFrame     = benchmark_seconds([&] { hex.Estimate(cur.Data(), kWidth, ref.Data(), kWidth); }, kIterations);
+    double          diamondFrame = benchmark_seconds([&] { diamond.Estimate(cur.Data(), kWidth, ref.Data(), kWidth); }, kIterations);
+
+    SPDLOG_INFO("Motion SAD 16x16: {:.2f} -> {:.2f} GB/s single thread", scalar, simd);
+    SPDLOG_INFO("Motion {}x{}: hex {:.0f} fps, diamond {:.0f} fps", kWidth, kHeight, 1.0 / hexFrame, 1.0 / diamondFrame);
+
+    return 0;
+}
+
+int simplest_yuv420_motion(const std::string& filename, int width, int height, int blockSize, MotionSearch search, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + ".motion", std::ios::out);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int             frameSize = width * height * 3 / 2; // YUV420P每帧字节数
+    uint8_t*        cur       = new uint8_t[frameSize];
+    uint8_t*        ref       = new uint8_t[frameSize];
+    MotionEstimator estimator(width, height, blockSize, search);
+
+    oFile << "frame,complexity,mean_mv,intra_ratio\n";
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(cur), frameSize))
+        {
+            break;
+        }
+        if (i > 0)
+        {
+            double complexity = estimator.Estimate(cur, width, ref, width);
+            double length     = 0.0;
+            int    intra      = 0;
+            for (const auto& mv : estimator.Vectors())
+            {
+                length += std::sqrt(static_cast<double>(mv.x * mv.x + mv.y * mv.y));
+                intra += mv.intra < mv.sad ? 1 : 0;
+            }
+            size_t blocks = std::max<size_t>(estimator.Vectors().size(), 1);
+            oFile << fmt::format("{},{:.3f},{:.3f},{:.4f}\n", i, complexity, length / blocks, static_cast<double>(intra) / blocks);
+            SPDLOG_INFO("Frame {}: complexity = {:.2f}, mean mv = {:.2f}", i, complexity, length / blocks);
+        }
+        std::swap(cur, ref);
+    }
+
+    delete[] cur;
+    delete[] ref;
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
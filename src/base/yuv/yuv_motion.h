@@ -0,0 +1,120 @@
+#ifndef __YUV_MOTION_H__
+#define __YUV_MOTION_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum MotionSearch
+{
+    MOTION_SEARCH_DIAMOND = 0, // 小菱形迭代（4 点）
+    MOTION_SEARCH_HEX     = 1, // 六边形迭代（6 点）+ 小菱形细化，与 x264 的 hex 相同
+};
+
+/**
+ * @brief   块运动矢量（整像素）
+ */
+typedef struct MotionVector
+{
+    int16_t  x;     // 水平位移
+    int16_t  y;     // 垂直位移
+    uint32_t sad;   // 最佳匹配的 SAD
+    uint32_t intra; // 帧内代价：块与其均值的 SAD
+} MotionVector;
+
+/**
+ * @brief   两帧亮度平面之间的块运动估计
+ * 1. 每个块以零矢量、左邻块矢量和上一次估计中同位置块的矢量为候选起点，
+ *    再按菱形或六边形模板迭代搜索，代价为 SAD + lambda * |mv - 预测矢量|
+ * 2. 只用同一行左侧和上一帧的矢量做预测，块行之间没有依赖，按块行多线程
+ * 3. 复杂度为每像素的 min(帧间 SAD, 帧内 SAD) 平均值，可作为编码前的内容复杂度估计
+ * 只处理完整的块，宽高不是块大小整数倍时右侧和底部剩余像素不参与估计
+ */
+class MotionEstimator
+{
+public:
+    /**
+     * @param   width                   [IN]        亮度宽度
+     * @param   height                  [IN]        亮度高度
+     * @param   blockSize               [IN]        块大小（16 或 8）
+     * @param   search                  [IN]        搜索模板
+     * @param   range                   [IN]        搜索范围（像素）
+     */
+    MotionEstimator(int width, int height, int blockSize = 16, MotionSearch search = MOTION_SEARCH_HEX, int range = 16);
+    ~MotionEstimator() = default;
+
+    /**
+     * @brief   估计当前帧相对参考帧的运动
+     * @param   cur                     [IN]        当前帧亮度平面
+     * @param   curStride               [IN]        当前帧行跨度（字节）
+     * @param   ref                     [IN]        参考帧（通常是上一帧）亮度平面
+     * @param   refStride               [IN]        参考帧行跨度（字节）
+     * @return  复杂度（每像素平均代价）
+     */
+    double Estimate(const uint8_t* cur, int curStride, const uint8_t* ref, int refStride);
+
+    /**
+     * @brief   最近一次估计的运动矢量，按块行优先排列
+     */
+    const std::vector<MotionVector>& Vectors() const
+    {
+        return m_vectors;
+    }
+
+    int BlocksX() const
+    {
+        return m_blocks_x;
+    }
+
+    int BlocksY() const
+    {
+        return m_blocks_y;
+    }
+
+private:
+    uint64_t SearchRow(int by, const uint8_t* cur, int curStride, const uint8_t* ref, int refStride);
+
+private:
+    int                       m_width;      // 亮度宽度
+    int                       m_height;     // 亮度高度
+    int                       m_block_size; // 块大小
+    MotionSearch              m_search;     // 搜索模板
+    int                       m_range;      // 搜索范围
+    int                       m_blocks_x;   // 每行块数
+    int                       m_blocks_y;   // 块行数
+    std::vector<MotionVector> m_vectors;    // 本次估计的矢量
+    std::vector<MotionVector> m_previous;   // 上一次估计的矢量，作为时间预测
+};
+
+/**
+ * @brief   16x16 块 SAD（SSE2 psadbw / NEON vabal）
+ */
+int block_sad_16x16(const uint8_t* a, int aStride, const uint8_t* b, int bStride);
+
+/**
+ * @brief   8x8 块 SAD
+ */
+int block_sad_8x8(const uint8_t* a, int aStride, const uint8_t* b, int bStride);
+
+/**
+ * @brief   运动估计吞吐测试（1080p 波带片序列，SAD 内核对比标量实现）
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int motion_benchmark();
+
+/**
+ * @brief   对YUV420P序列做逐帧运动估计，输出每帧的复杂度
+ * @param   filename                [IN]        yuv420 输入文件路径（可用 ffmpeg 把 sintel.h264 解码为 yuv420p）
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   blockSize               [IN]        块大小（16 或 8）
+ * @param   search                  [IN]        搜索模板
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ * 每帧一行写入 <filename>.motion（CSV）：帧号、复杂度、平均矢量长度、帧内块占比
+ */
+int simplest_yuv420_motion(const std::string& filename, int width, int height, int blockSize, MotionSearch search, int number);
+
+#endif
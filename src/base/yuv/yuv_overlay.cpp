@@ -0,0 +1,387 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/benchmark.hpp"
+#include "base/common/color.hpp"
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_overlay.h"
+
+namespace
+{
+    constexpr int kMinPairsPerThread = 16; // 每个线程最少处理的行对数（一对亮度行对应一行色度）
+
+    inline int inverse_alpha(int alpha)
+    {
+        return 256 - alpha - (alpha >> 7);
+    }
+
+    void blend_row_c(uint8_t* dst, const uint8_t* color, const uint8_t* alpha, int count)
+    {
+        for (int x = 0; x < count; x++)
+        {
+            dst[x] = static_cast<uint8_t>(std::min(color[x] + ((dst[x] * inverse_alpha(alpha[x]) + 128) >> 8), 255));
+        }
+    }
+
+    OverlayRect intersect(const OverlayRect& a, const OverlayRect& b)
+    {
+        int x0 = std::max(a.x, b.x);
+        int y0 = std::max(a.y, b.y);
+        int x1 = std::min(a.x + a.width, b.x + b.width);
+        int y1 = std::min(a.y + a.height, b.y + b.height);
+        if (x1 <= x0 || y1 <= y0)
+        {
+            return {0, 0, 0, 0};
+        }
+        return {x0, y0, x1 - x0, y1 - y0};
+    }
+
+    OverlayRect unite(const OverlayRect& a, const OverlayRect& b)
+    {
+        if (a.width == 0 || a.height == 0)
+        {
+            return b;
+        }
+        if (b.width == 0 || b.height == 0)
+        {
+            return a;
+        }
+        int x0 = std::min(a.x, b.x);
+        int y0 = std::min(a.y, b.y);
+        int x1 = std::max(a.x + a.width, b.x + b.width);
+        int y1 = std::max(a.y + a.height, b.y + b.height);
+        return {x0, y0, x1 - x0, y1 - y0};
+    }
+
+    /**
+     * @brief   生成测试精灵：边缘柔和的圆盘，颜色随位置渐变（预乘 RGBA）
+     */
+    std::vector<uint8_t> make_disc(int width, int height)
+    {
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+        float                cx     = width * 0.5f;
+        float                cy     = height * 0.5f;
+        float                radius = std::min(cx, cy);
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                float    dx    = (x + 0.5f - cx) / radius;
+                float    dy    = (y + 0.5f - cy) / radius;
+                float    d     = std::sqrt(dx * dx + dy * dy);
+                int      alpha = static_cast<int>(std::clamp((1.0f - d) * 4.0f, 0.0f, 1.0f) * 255.0f + 0.5f);
+                uint8_t* p     = &rgba[(static_cast<size_t>(y) * width + x) * 4];
+                p[0]           = static_cast<uint8_t>((255 * x / width) * alpha / 255);
+                p[1]           = static_cast<uint8_t>((255 * y / height) * alpha / 255);
+                p[2]           = static_cast<uint8_t>(160 * alpha / 255);
+                p[3]           = static_cast<uint8_t>(alpha);
+            }
+        }
+        return rgba;
+    }
+} // namespace
+
+void overlay_blend_row(uint8_t* dst, const uint8_t* color, const uint8_t* alpha, int count)
+{
+    int x = 0;
+#if SIMD_SSE2
+    // dst * (256 - a') 最大 255 * 256，加上舍入项仍在 16 位无符号范围内
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i full  = _mm_set1_epi16(256);
+    const __m128i round = _mm_set1_epi16(128);
+    for (; x + 16 <= count; x += 16)
+    {
+        __m128i d   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x));
+        __m128i a   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha + x));
+        __m128i c   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(color + x));
+        __m128i aLo = _mm_unpacklo_epi8(a, zero);
+        __m128i aHi = _mm_unpackhi_epi8(a, zero);
+        __m128i iLo = _mm_sub_epi16(full, _mm_add_epi16(aLo, _mm_srli_epi16(aLo, 7)));
+        __m128i iHi = _mm_sub_epi16(full, _mm_add_epi16(aHi, _mm_srli_epi16(aHi, 7)));
+        __m128i lo  = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), iLo), round), 8);
+        __m128i hi  = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), iHi), round), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_adds_epu8(_mm_packus_epi16(lo, hi), c));
+    }
+#elif SIMD_NEON
+    const uint16x8_t full = vdupq_n_u16(256);
+    for (; x + 16 <= count; x += 16)
+    {
+        uint8x16_t d   = vld1q_u8(dst + x);
+        uint8x16_t a   = vld1q_u8(alpha + x);
+        uint16x8_t aLo = vmovl_u8(vget_low_u8(a));
+        uint16x8_t aHi = vmovl_u8(vget_high_u8(a));
+        uint16x8_t iLo = vsubq_u16(full, vsraq_n_u16(aLo, aLo, 7));
+        uint16x8_t iHi = vsubq_u16(full, vsraq_n_u16(aHi, aHi, 7));
+        uint16x8_t lo  = vmulq_u16(vmovl_u8(vget_low_u8(d)), iLo);
+        uint16x8_t hi  = vmulq_u16(vmovl_u8(vget_high_u8(d)), iHi);
+        // vrshrn 即 (x + 128) >> 8
+        uint8x16_t out = vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+        vst1q_u8(dst + x, vqaddq_u8(out, vld1q_u8(color + x)));
+    }
+#endif
+    blend_row_c(dst + x, color + x, alpha + x, count - x);
+}
+
+OverlaySprite::OverlaySprite(const uint8_t* rgba, int width, int height, int stride)
+    : m_width((width + 1) & ~1)
+    , m_height((height + 1) & ~1)
+    , m_bounds{0, 0, 0, 0}
+{
+    size_t lumaSize   = static_cast<size_t>(m_width) * m_height;
+    int    chromaW    = m_width / 2;
+    size_t chromaSize = lumaSize / 4;
+    m_y.Resize(lumaSize);
+    m_alpha.Resize(lumaSize);
+    m_u.Resize(chromaSize);
+    m_v.Resize(chromaSize);
+    m_chroma.Resize(chromaSize);
+
+    // 奇数宽高补一列/一行透明像素
+    int x0 = m_width, y0 = m_height, x1 = 0, y1 = 0;
+    for (int y = 0; y < m_height; y++)
+    {
+        for (int x = 0; x < m_width; x++)
+        {
+            const uint8_t* p = (x < width && y < height) ? rgba + static_cast<size_t>(y) * stride + x * 4 : nullptr;
+            int            a = p ? p[3] : 0;
+            int            yVal, uVal, vVal;
+            color_rgb_to_yuv_premultiplied(p ? p[0] : 0, p ? p[1] : 0, p ? p[2] : 0, a, yVal, uVal, vVal);
+            m_y[static_cast<size_t>(y) * m_width + x]     = static_cast<uint8_t>(std::clamp(yVal, 0, 255));
+            m_alpha[static_cast<size_t>(y) * m_width + x] = static_cast<uint8_t>(a);
+            if (a != 0)
+            {
+                x0 = std::min(x0, x);
+                y0 = std::min(y0, y);
+                x1 = std::max(x1, x + 1);
+                y1 = std::max(y1, y + 1);
+            }
+        }
+    }
+
+    // 色度：2x2 预乘分量求平均后转换
+    for (int y = 0; y < m_height / 2; y++)
+    {
+        for (int x = 0; x < chromaW; x++)
+        {
+            int sum[4] = {0, 0, 0, 0};
+            for (int k = 0; k < 4; k++)
+            {
+                int sx = x * 2 + (k & 1);
+                int sy = y * 2 + (k >> 1);
+                if (sx >= width || sy >= height)
+                {
+                    continue;
+                }
+                const uint8_t* p = rgba + static_cast<size_t>(sy) * stride + sx * 4;
+                for (int c = 0; c < 4; c++)
+                {
+                    sum[c] += p[c];
+                }
+            }
+            int yVal, uVal, vVal;
+            color_rgb_to_yuv_premultiplied((sum[0] + 2) >> 2, (sum[1] + 2) >> 2, (sum[2] + 2) >> 2, (sum[3] + 2) >> 2, yVal, uVal, vVal);
+            size_t index    = static_cast<size_t>(y) * chromaW + x;
+            m_u[index]      = static_cast<uint8_t>(std::clamp(uVal, 0, 255));
+            m_v[index]      = static_cast<uint8_t>(std::clamp(vVal, 0, 255));
+            m_chroma[index] = static_cast<uint8_t>((sum[3] + 2) >> 2);
+        }
+    }
+
+    if (x1 > x0 && y1 > y0)
+    {
+        x0       = x0 & ~1;
+        y0       = y0 & ~1;
+        m_bounds = {x0, y0, ((x1 + 1) & ~1) - x0, ((y1 + 1) & ~1) - y0};
+    }
+}
+
+OverlayCompositor::OverlayCompositor(int width, int height)
+    : m_width(width & ~1)
+    , m_height(height & ~1)
+{
+}
+
+int OverlayCompositor::Add(const OverlaySprite* sprite, int x, int y)
+{
+    m_layers.push_back({sprite, x & ~1, y & ~1, true});
+    return static_cast<int>(m_layers.size()) - 1;
+}
+
+void OverlayCompositor::Move(int layer, int x, int y)
+{
+    if (layer >= 0 && layer < static_cast<int>(m_layers.size()))
+    {
+        m_layers[layer].x = x & ~1;
+        m_layers[layer].y = y & ~1;
+    }
+}
+
+void OverlayCompositor::SetVisible(int layer, bool visible)
+{
+    if (layer >= 0 && layer < static_cast<int>(m_layers.size()))
+    {
+        m_layers[layer].visible = visible;
+    }
+}
+
+void OverlayCompositor::Clear()
+{
+    m_layers.clear();
+}
+
+OverlayRect OverlayCompositor::Dirty(const Layer& layer) const
+{
+    if (!layer.visible || !layer.sprite)
+    {
+        return {0, 0, 0, 0};
+    }
+    const OverlayRect& bounds = layer.sprite->Bounds();
+    return intersect({layer.x + bounds.x, layer.y + bounds.y, bounds.width, bounds.height}, {0, 0, m_width, m_height});
+}
+
+OverlayRect OverlayCompositor::Composite(YuvFrame& frame) const
+{
+    std::vector<OverlayRect> dirty(m_layers.size());
+    OverlayRect              total = {0, 0, 0, 0};
+    for (size_t i = 0; i < m_layers.size(); i++)
+    {
+        dirty[i] = Dirty(m_layers[i]);
+        total    = unite(total, dirty[i]);
+    }
+    if (total.width == 0 || total.height == 0)
+    {
+        return total;
+    }
+
+    // 行带以亮度行对为单位，保证色度行不跨行带
+    auto rows = [&](int begin, int end) {
+        int bandY0 = total.y + begin * 2;
+        int bandY1 = total.y + end * 2;
+        for (size_t i = 0; i < m_layers.size(); i++)
+        {
+            const OverlayRect& rect = dirty[i];
+            int                y0   = std::max(rect.y, bandY0);
+            int                y1   = std::min(rect.y + rect.height, bandY1);
+            if (rect.width == 0 || y1 <= y0)
+            {
+                continue;
+            }
+            const OverlaySprite& sprite = *m_layers[i].sprite;
+            int                  sx     = rect.x - m_layers[i].x;
+            for (int y = y0; y < y1; y++)
+            {
+                size_t offset = static_cast<size_t>(y - m_layers[i].y) * sprite.m_width + sx;
+                overlay_blend_row(frame.data[0] + static_cast<size_t>(y) * frame.stride[0] + rect.x, sprite.m_y.Data() + offset, sprite.m_alpha.Data() + offset, rect.width);
+            }
+            int chromaW = sprite.m_width / 2;
+            for (int y = y0 / 2; y < y1 / 2; y++)
+            {
+                size_t offset = static_cast<size_t>(y - m_layers[i].y / 2) * chromaW + sx / 2;
+                size_t dstU   = static_cast<size_t>(y) * frame.stride[1] + rect.x / 2;
+                size_t dstV   = static_cast<size_t>(y) * frame.stride[2] + rect.x / 2;
+                overlay_blend_row(frame.data[1] + dstU, sprite.m_u.Data() + offset, sprite.m_chroma.Data() + offset, rect.width / 2);
+                overlay_blend_row(frame.data[2] + dstV, sprite.m_v.Data() + offset, sprite.m_chroma.Data() + offset, rect.width / 2);
+            }
+        }
+    };
+    parallel_for_rows(total.height / 2, rows, kMinPairsPerThread);
+
+    return total;
+}
+
+int overlay_benchmark()
+{
+    constexpr int kWidth        = 1920;
+    constexpr int kHeight       = 1080;
+    constexpr int kSpriteWidth  = 128;
+    constexpr int kSpriteHeight = 64;
+    constexpr int kSprites      = 64;
+    constexpr int kIterations   = 200;
+
+    std::vector<uint8_t> rgba = make_disc(kSpriteWidth, kSpriteHeight);
+    OverlaySprite        sprite(rgba.data(), kSpriteWidth, kSpriteHeight, kSpriteWidth * 4);
+    OverlayCompositor    compositor(kWidth, kHeight);
+    for (int i = 0; i < kSprites; i++)
+    {
+        compositor.Add(&sprite, (i % 8) * 240 + 16, (i / 8) * 132 + 8);
+    }
+
+    std::vector<uint8_t> buffer(yuv_frame_size(YUV_FORMAT_I420, kWidth, kHeight));
+    for (size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = static_cast<uint8_t>(i * 7 + (i >> 10));
+    }
+    YuvFrame frame = yuv_frame_wrap(buffer.data(), YUV_FORMAT_I420, kWidth, kHeight);
+
+    // 行内核对比标量实现（预乘颜色不超过 alpha）
+    std::vector<uint8_t> color(kWidth), alpha(kWidth), row(kWidth), expect(kWidth);
+    for (int i = 0; i < kWidth; i++)
+    {
+        alpha[i]  = static_cast<uint8_t>(i * 37);
+        color[i]  = static_cast<uint8_t>(alpha[i] * (i % 5) / 4);
+        row[i]    = static_cast<uint8_t>(i * 11);
+        expect[i] = row[i];
+    }
+    overlay_blend_row(row.data(), color.data(), alpha.data(), kWidth);
+    blend_row_c(expect.data(), color.data(), alpha.data(), kWidth);
+    if (row != expect)
+    {
+        SPDLOG_ERROR("Overlay: SIMD result mismatch");
+        return -1;
+    }
+
+    double seconds = benchmark_seconds([&] { compositor.Composite(frame); }, kIterations);
+    SPDLOG_INFO("Overlay {}x{}: {} sprites of {}x{}, {:.0f} fps", kWidth, kHeight, kSprites, kSpriteWidth, kSpriteHeight, 1.0 / seconds);
+
+    return 0;
+}
+
+int simplest_yuv420_overlay(const std::string& filename, int width, int height, const std::string& rgbaFile, int spriteWidth, int spriteHeight, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ifstream sFile(rgbaFile, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + ".overlay", std::ios::out | std::ios::binary);
+    if (!iFile.is_open() || !sFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {} or {}", filename, rgbaFile);
+        return -1;
+    }
+
+    std::vector<uint8_t> rgba(static_cast<size_t>(spriteWidth) * spriteHeight * 4);
+    if (!sFile.read(reinterpret_cast<char*>(rgba.data()), rgba.size()))
+    {
+        SPDLOG_ERROR("Failed to read sprite: {}", rgbaFile);
+        return -1;
+    }
+
+    int                  frameSize = width * height * 3 / 2; // YUV420P每帧字节数
+    std::vector<uint8_t> buffer(frameSize);
+    YuvFrame             frame = yuv_frame_wrap(buffer.data(), YUV_FORMAT_I420, width, height);
+    OverlaySprite        sprite(rgba.data(), spriteWidth, spriteHeight, spriteWidth * 4);
+    OverlayCompositor    compositor(width, height);
+    compositor.Add(&sprite, 8, 8);
+    int moving = compositor.Add(&sprite, -spriteWidth, height - spriteHeight - 8);
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(buffer.data()), frameSize))
+        {
+            break;
+        }
+        compositor.Move(moving, i * 8 % (width + spriteWidth) - spriteWidth, height - spriteHeight - 8);
+        compositor.Composite(frame);
+        oFile.write(reinterpret_cast<const char*>(buffer.data()), frameSize);
+    }
+
+    iFile.close();
+    sFile.close();
+    oFile.close();
+
+    return 0;
+}
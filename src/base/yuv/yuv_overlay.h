@@ -0,0 +1,170 @@
+#ifndef __YUV_OVERLAY_H__
+#define __YUV_OVERLAY_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/common/aligned_buffer.hpp"
+#include "yuv_frame.h"
+
+/**
+ * @brief   矩形区域
+ */
+typedef struct OverlayRect
+{
+    int x;      // 左上角 x
+    int y;      // 左上角 y
+    int width;  // 宽度，0 表示空
+    int height; // 高度，0 表示空
+} OverlayRect;
+
+/**
+ * @brief   叠加用的精灵（台标、时间码等）
+ * 构造时把预乘 RGBA 转换一次并以预乘 YUVA420 缓存：亮度与 alpha 为全分辨率，
+ * 色度与 alpha 按 2x2 平均（预乘分量可以直接平均）；同时记录 alpha 非零的包围盒，
+ * 混合时只处理这一部分
+ */
+class OverlaySprite
+{
+public:
+    /**
+     * @param   rgba                    [IN]        预乘 RGBA 像素数据
+     * @param   width                   [IN]        宽度
+     * @param   height                  [IN]        高度
+     * @param   stride                  [IN]        行跨度（字节）
+     */
+    OverlaySprite(const uint8_t* rgba, int width, int height, int stride);
+    ~OverlaySprite() = default;
+
+    int Width() const
+    {
+        return m_width;
+    }
+
+    int Height() const
+    {
+        return m_height;
+    }
+
+    /**
+     * @brief   alpha 非零的区域（相对精灵左上角，按偶数对齐），全透明时宽高为 0
+     */
+    const OverlayRect& Bounds() const
+    {
+        return m_bounds;
+    }
+
+private:
+    friend class OverlayCompositor;
+
+    int                    m_width;  // 宽度（向上取偶）
+    int                    m_height; // 高度（向上取偶）
+    OverlayRect            m_bounds; // 不透明部分的包围盒
+    AlignedBuffer<uint8_t> m_y;      // 预乘亮度
+    AlignedBuffer<uint8_t> m_alpha;  // 亮度 alpha
+    AlignedBuffer<uint8_t> m_u;      // 预乘 U（半分辨率）
+    AlignedBuffer<uint8_t> m_v;      // 预乘 V（半分辨率）
+    AlignedBuffer<uint8_t> m_chroma; // 色度 alpha（半分辨率）
+};
+
+/**
+ * @brief   把多个精灵按图层顺序混合到 YUV420P 帧上
+ * 1. 混合公式 dst = src' + dst * (256 - a') >> 8（src' 为预乘分量，a' = a + (a >> 7) 把 255 映射到 256），
+ *    16 位定点 SIMD（SSE2 / NEON）每次处理 16 个采样
+ * 2. 只处理各图层不透明包围盒与帧的交集（脏矩形），图层位置按色度网格取偶
+ * 3. 所有脏矩形的并集按行带多线程，每个行带依次混合与它相交的图层，图层顺序不变
+ * 精灵由调用方持有，生命周期需覆盖 Composite 调用
+ */
+class OverlayCompositor
+{
+public:
+    /**
+     * @param   width                   [IN]        帧宽度
+     * @param   height                  [IN]        帧高度
+     */
+    OverlayCompositor(int width, int height);
+    ~OverlayCompositor() = default;
+
+    /**
+     * @brief   添加图层
+     * @param   sprite                  [IN]        精灵
+     * @param   x                       [IN]        精灵左上角在帧中的 x（可以为负或超出帧）
+     * @param   y                       [IN]        精灵左上角在帧中的 y
+     * @return  图层编号
+     */
+    int Add(const OverlaySprite* sprite, int x, int y);
+
+    /**
+     * @brief   移动图层
+     */
+    void Move(int layer, int x, int y);
+
+    /**
+     * @brief   显示/隐藏图层
+     */
+    void SetVisible(int layer, bool visible);
+
+    /**
+     * @brief   清除所有图层
+     */
+    void Clear();
+
+    /**
+     * @brief   按图层顺序混合到帧上
+     * @param   frame                   [IN/OUT]    YUV420P 帧，尺寸与构造参数一致
+     * @return  本次修改的区域（所有脏矩形的并集），没有修改时宽高为 0
+     */
+    OverlayRect Composite(YuvFrame& frame) const;
+
+private:
+    typedef struct Layer
+    {
+        const OverlaySprite* sprite;  // 精灵
+        int                  x;       // 位置 x（偶数）
+        int                  y;       // 位置 y（偶数）
+        bool                 visible; // 是否显示
+    } Layer;
+
+    /**
+     * @brief   图层在帧上的脏矩形（偶数对齐）
+     */
+    OverlayRect Dirty(const Layer& layer) const;
+
+private:
+    int                m_width;  // 帧宽度
+    int                m_height; // 帧高度
+    std::vector<Layer> m_layers; // 图层，按添加顺序从下到上
+};
+
+/**
+ * @brief   预乘混合一行：dst = color + dst * (256 - alpha') >> 8
+ * @param   dst                     [IN/OUT]    目标行
+ * @param   color                   [IN]        预乘颜色
+ * @param   alpha                   [IN]        alpha
+ * @param   count                   [IN]        采样数
+ */
+void overlay_blend_row(uint8_t* dst, const uint8_t* color, const uint8_t* alpha, int count);
+
+/**
+ * @brief   叠加吞吐测试（1080p 帧上 64 个 128x64 的精灵，对比标量实现）
+ * @return  0                                   成功
+ *          其他                                SIMD 结果与标量结果不一致
+ */
+int overlay_benchmark();
+
+/**
+ * @brief   在YUV420P像素数据上叠加预乘 RGBA 精灵：左上角固定一个，另一个随帧号水平移动
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   rgbaFile                [IN]        预乘 RGBA 精灵文件路径
+ * @param   spriteWidth             [IN]        精灵宽度
+ * @param   spriteHeight            [IN]        精灵高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_overlay(const std::string& filename, int width, int height, const std::string& rgbaFile, int spriteWidth, int spriteHeight, int number);
+
+#endif
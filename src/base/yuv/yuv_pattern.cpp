@@ -0,0 +1,492 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_pattern.h"
+#include "yuv_plane.h"
+
+namespace
+{
+    constexpr int    kMinRowsPerThread = 32;
+    constexpr double kPi               = 3.14159265358979323846;
+
+    typedef struct YuvColor
+    {
+        uint8_t y;
+        uint8_t u;
+        uint8_t v;
+    } YuvColor;
+
+    // BT.601 限幅范围下的 SMPTE 彩条颜色
+    constexpr YuvColor kGray75   = {180, 128, 128};
+    constexpr YuvColor kYellow   = {162, 44, 142};
+    constexpr YuvColor kCyan     = {131, 156, 44};
+    constexpr YuvColor kGreen    = {112, 72, 58};
+    constexpr YuvColor kMagenta  = {84, 184, 198};
+    constexpr YuvColor kRed      = {65, 100, 212};
+    constexpr YuvColor kBlue     = {35, 212, 114};
+    constexpr YuvColor kBlack    = {16, 128, 128};
+    constexpr YuvColor kWhite    = {235, 128, 128};
+    constexpr YuvColor kMinusI   = {16, 158, 95};
+    constexpr YuvColor kPlusQ    = {16, 174, 149};
+    constexpr YuvColor kBlackLow = {7, 128, 128};
+    constexpr YuvColor kBlackHi  = {25, 128, 128};
+
+    const char* pattern_name(PatternType type)
+    {
+        switch (type)
+        {
+        case PATTERN_GRADIENT_H: return "gradient_h";
+        case PATTERN_GRADIENT_V: return "gradient_v";
+        case PATTERN_ZONE_PLATE: return "zoneplate";
+        case PATTERN_MOVING_BOX: return "movingbox";
+        case PATTERN_NOISE: return "noise";
+        default: return "smptebars";
+        }
+    }
+
+    /**
+     * SMPTE 彩条三段：上 2/3 为 7 条 75% 彩条，中间 1/12 为反向色块，下 1/4 为 -I/白/+Q/黑与 PLUGE
+     */
+    YuvColor bars_color(int band, int x, int width)
+    {
+        static const YuvColor top[7]    = {kGray75, kYellow, kCyan, kGreen, kMagenta, kRed, kBlue};
+        static const YuvColor middle[7] = {kBlue, kBlack, kMagenta, kBlack, kCyan, kBlack, kGray75};
+        if (band == 0)
+        {
+            return top[x * 7 / width];
+        }
+        if (band == 1)
+        {
+            return middle[x * 7 / width];
+        }
+
+        // 底部以 1/84 宽度为单位：前4块各占 5/4 条宽，PLUGE 三块各占 1/3 条宽，最后一条为黑
+        int unit = x * 84 / width;
+        if (unit < 15)
+        {
+            return kMinusI;
+        }
+        if (unit < 30)
+        {
+            return kWhite;
+        }
+        if (unit < 45)
+        {
+            return kPlusQ;
+        }
+        if (unit < 60)
+        {
+            return kBlack;
+        }
+        if (unit < 64)
+        {
+            return kBlackLow;
+        }
+        if (unit >= 68 && unit < 72)
+        {
+            return kBlackHi;
+        }
+        return kBlack;
+    }
+
+    int bars_band(int y, int height)
+    {
+        if (y < height * 2 / 3)
+        {
+            return 0;
+        }
+        return (y < height * 3 / 4) ? 1 : 2;
+    }
+
+    void fill_rows(uint8_t* plane, int stride, const uint8_t* row, int rowBytes, int begin, int end)
+    {
+        for (int y = begin; y < end; y++)
+        {
+            memcpy(plane + static_cast<size_t>(y) * stride, row, rowBytes);
+        }
+    }
+
+    int triangle_wave(int position, int range)
+    {
+        if (range <= 0)
+        {
+            return 0;
+        }
+        position %= 2 * range;
+        return position <= range ? position : 2 * range - position;
+    }
+
+    uint32_t hash32(uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    /**
+     * 4 路 xorshift32 并行生成噪声，每步输出 16 字节；标量实现逐路模拟，与 SIMD 结果逐字节一致
+     */
+    void noise_row(uint8_t* dst, int width, uint32_t seed)
+    {
+        uint32_t state[4];
+        for (int i = 0; i < 4; i++)
+        {
+            state[i] = hash32(seed * 4 + i) | 1;
+        }
+
+        int x = 0;
+#if SIMD_SSE2
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+        for (; x + 16 <= width; x += 16)
+        {
+            s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+            s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+            s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), s);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), s);
+#endif
+        for (; x < width; x += 16)
+        {
+            uint8_t chunk[16];
+            for (int i = 0; i < 4; i++)
+            {
+                state[i] ^= state[i] << 13;
+                state[i] ^= state[i] >> 17;
+                state[i] ^= state[i] << 5;
+                memcpy(chunk + 4 * i, &state[i], 4);
+            }
+            memcpy(dst + x, chunk, std::min(16, width - x));
+        }
+    }
+} // namespace
+
+PatternGenerator::PatternGenerator(PatternType type, YuvFormat format, int width, int height)
+    : m_type(type)
+    , m_width(width)
+    , m_height(height)
+    , m_low(16)
+    , m_high(235)
+    , m_frame_size(yuv_frame_size(format, width, height))
+    , m_last(-1)
+    , m_buffer(m_frame_size)
+{
+    m_frame = yuv_frame_wrap(m_buffer.Data(), format, width, height);
+}
+
+void PatternGenerator::SetLevels(int low, int high)
+{
+    m_low  = std::clamp(low, 0, 255);
+    m_high = std::clamp(high, 0, 255);
+    m_last = -1;
+}
+
+const YuvFrame& PatternGenerator::Render(int index)
+{
+    bool valid = (m_last >= 0);
+    switch (m_type)
+    {
+    case PATTERN_SMPTE_BARS:
+        if (!valid)
+        {
+            DrawBars();
+        }
+        break;
+    case PATTERN_GRADIENT_H:
+    case PATTERN_GRADIENT_V:
+        if (!valid)
+        {
+            FillChroma(128, 128);
+            DrawGradient();
+        }
+        break;
+    case PATTERN_ZONE_PLATE:
+        if (!valid)
+        {
+            FillChroma(128, 128);
+        }
+        DrawZonePlate(index);
+        break;
+    case PATTERN_MOVING_BOX:
+        if (!valid)
+        {
+            FillChroma(128, 128);
+        }
+        DrawBox(index);
+        break;
+    case PATTERN_NOISE:
+        if (!valid)
+        {
+            FillChroma(128, 128);
+        }
+        DrawNoise(index);
+        break;
+    }
+    m_last = index;
+    return m_frame;
+}
+
+void PatternGenerator::FillChroma(uint8_t u, uint8_t v)
+{
+    int shiftX, shiftY;
+    yuv_chroma_shift(m_frame.format, shiftX, shiftY);
+    int chromaWidth  = (m_width + (1 << shiftX) - 1) >> shiftX;
+    int chromaHeight = (m_height + (1 << shiftY) - 1) >> shiftY;
+
+    if (!yuv_is_semi_planar(m_frame.format))
+    {
+        for (int y = 0; y < chromaHeight; y++)
+        {
+            memset(m_frame.data[1] + static_cast<size_t>(y) * m_frame.stride[1], u, chromaWidth);
+            memset(m_frame.data[2] + static_cast<size_t>(y) * m_frame.stride[2], v, chromaWidth);
+        }
+        return;
+    }
+
+    // 半平面：先构建一行交织数据，再逐行拷贝
+    if (m_frame.format == YUV_FORMAT_NV21)
+    {
+        std::swap(u, v);
+    }
+    std::vector<uint8_t> row(static_cast<size_t>(chromaWidth) * 2);
+    for (int x = 0; x < chromaWidth; x++)
+    {
+        row[2 * x]     = u;
+        row[2 * x + 1] = v;
+    }
+    fill_rows(m_frame.data[1], m_frame.stride[1], row.data(), chromaWidth * 2, 0, chromaHeight);
+}
+
+void PatternGenerator::DrawBars()
+{
+    int shiftX, shiftY;
+    yuv_chroma_shift(m_frame.format, shiftX, shiftY);
+    int  chromaWidth  = (m_width + (1 << shiftX) - 1) >> shiftX;
+    int  chromaHeight = (m_height + (1 << shiftY) - 1) >> shiftY;
+    bool semi         = yuv_is_semi_planar(m_frame.format);
+    bool swap         = (m_frame.format == YUV_FORMAT_NV21);
+
+    // 三段各构建一次 Y、U、V（或 UV 交织）行，再整行拷贝到所有同段的行
+    std::vector<uint8_t> rowY[3], rowU[3], rowV[3];
+    for (int band = 0; band < 3; band++)
+    {
+        rowY[band].resize(m_width);
+        rowU[band].resize(semi ? chromaWidth * 2 : chromaWidth);
+        rowV[band].resize(chromaWidth);
+        for (int x = 0; x < m_width; x++)
+        {
+            rowY[band][x] = bars_color(band, x, m_width).y;
+        }
+        // 色度与偶数列亮度共点，直接取对应列的颜色
+        for (int x = 0; x < chromaWidth; x++)
+        {
+            YuvColor color = bars_color(band, x << shiftX, m_width);
+            if (semi)
+            {
+                rowU[band][2 * x]     = swap ? color.v : color.u;
+                rowU[band][2 * x + 1] = swap ? color.u : color.v;
+            }
+            else
+            {
+                rowU[band][x] = color.u;
+                rowV[band][x] = color.v;
+            }
+        }
+    }
+
+    for (int y = 0; y < m_height; y++)
+    {
+        int band = bars_band(y, m_height);
+        memcpy(m_frame.data[0] + static_cast<size_t>(y) * m_frame.stride[0], rowY[band].data(), m_width);
+    }
+    for (int y = 0; y < chromaHeight; y++)
+    {
+        int band = bars_band(y << shiftY, m_height);
+        memcpy(m_frame.data[1] + static_cast<size_t>(y) * m_frame.stride[1], rowU[band].data(), rowU[band].size());
+        if (!semi)
+        {
+            memcpy(m_frame.data[2] + static_cast<size_t>(y) * m_frame.stride[2], rowV[band].data(), chromaWidth);
+        }
+    }
+}
+
+void PatternGenerator::DrawGradient()
+{
+    if (m_type == PATTERN_GRADIENT_V)
+    {
+        for (int y = 0; y < m_height; y++)
+        {
+            uint8_t value = static_cast<uint8_t>(m_low + (m_high - m_low) * y / m_height);
+            memset(m_frame.data[0] + static_cast<size_t>(y) * m_frame.stride[0], value, m_width);
+        }
+        return;
+    }
+
+    std::vector<uint8_t> row(m_width);
+    for (int x = 0; x < m_width; x++)
+    {
+        row[x] = static_cast<uint8_t>(m_low + (m_high - m_low) * x / m_width);
+    }
+    fill_rows(m_frame.data[0], m_frame.stride[0], row.data(), m_width, 0, m_height);
+}
+
+void PatternGenerator::DrawZonePlate(int index)
+{
+    /**
+     * 相位 φ(r) = π r² / (2R)，在半径 R 处频率达到奈奎斯特；用 uint32 表示 [0, 2π)，
+     * 溢出回绕即取模，因此 x²、y² 两项可以分别预先计算再相加
+     */
+    constexpr int kLutBits = 10;
+    if (m_phase_x.empty())
+    {
+        uint64_t radius = static_cast<uint64_t>(std::max(m_width, m_height)) / 2;
+
+        auto phase = [radius](int d) {
+            // d 为两倍坐标（以像素中心为原点），d² / 4 = r²
+            return static_cast<uint32_t>((static_cast<uint64_t>(d) * d << 28) / radius);
+        };
+        m_phase_x.resize(m_width);
+        m_phase_y.resize(m_height);
+        for (int x = 0; x < m_width; x++)
+        {
+            m_phase_x[x] = phase(2 * x - m_width + 1);
+        }
+        for (int y = 0; y < m_height; y++)
+        {
+            m_phase_y[y] = phase(2 * y - m_height + 1);
+        }
+    }
+
+    uint8_t lut[1 << kLutBits];
+    for (int i = 0; i < (1 << kLutBits); i++)
+    {
+        double s = (1.0 + std::sin(2.0 * kPi * i / (1 << kLutBits))) / 2.0;
+        lut[i]   = static_cast<uint8_t>(std::lround(m_low + (m_high - m_low) * s));
+    }
+
+    // 每帧相位前移 2π/32
+    uint32_t timePhase = static_cast<uint32_t>(index) << 27;
+
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            uint8_t* dst  = m_frame.data[0] + static_cast<size_t>(y) * m_frame.stride[0];
+            uint32_t base = m_phase_y[y] + timePhase;
+            for (int x = 0; x < m_width; x++)
+            {
+                dst[x] = lut[(m_phase_x[x] + base) >> (32 - kLutBits)];
+            }
+        }
+    };
+    parallel_for_rows(m_height, rows, kMinRowsPerThread);
+}
+
+void PatternGenerator::BoxPosition(int index, int& x, int& y) const
+{
+    // 方块边长为画面的 1/8（偶数），水平每帧 4 像素、垂直每帧 2 像素往返运动
+    int boxWidth  = std::max(2, (m_width / 8) & ~1);
+    int boxHeight = std::max(2, (m_height / 8) & ~1);
+    x             = triangle_wave(index * 4, m_width - boxWidth);
+    y             = triangle_wave(index * 2, m_height - boxHeight);
+}
+
+void PatternGenerator::FillLumaRect(int x, int y, int w, int h, uint8_t value)
+{
+    w = std::min(w, m_width - x);
+    h = std::min(h, m_height - y);
+    for (int row = y; row < y + h; row++)
+    {
+        memset(m_frame.data[0] + static_cast<size_t>(row) * m_frame.stride[0] + x, value, w);
+    }
+}
+
+void PatternGenerator::DrawBox(int index)
+{
+    int boxWidth  = std::max(2, (m_width / 8) & ~1);
+    int boxHeight = std::max(2, (m_height / 8) & ~1);
+    int x, y;
+
+    if (m_last < 0)
+    {
+        FillLumaRect(0, 0, m_width, m_height, static_cast<uint8_t>(m_low));
+    }
+    else
+    {
+        // 增量：只擦除上一帧方块所在区域
+        BoxPosition(m_last, x, y);
+        FillLumaRect(x, y, boxWidth, boxHeight, static_cast<uint8_t>(m_low));
+    }
+    BoxPosition(index, x, y);
+    FillLumaRect(x, y, boxWidth, boxHeight, static_cast<uint8_t>(m_high));
+}
+
+void PatternGenerator::DrawNoise(int index)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            uint32_t seed = static_cast<uint32_t>(index) * 0x9e3779b9u + static_cast<uint32_t>(y);
+            noise_row(m_frame.data[0] + static_cast<size_t>(y) * m_frame.stride[0], m_width, seed);
+        }
+    };
+    parallel_for_rows(m_height, rows, kMinRowsPerThread);
+}
+
+int simplest_yuv_pattern(PatternType type, YuvFormat format, int width, int height, int number, int bitDepth)
+{
+    if (width <= 0 || height <= 0 || (width & 1) || (height & 1))
+    {
+        SPDLOG_ERROR("Invalid pattern size: {}x{}", width, height);
+        return -1;
+    }
+    if (bitDepth < 8 || bitDepth > 16)
+    {
+        SPDLOG_ERROR("Invalid bit depth: {}", bitDepth);
+        return -1;
+    }
+
+    std::string filename = fmt::format("pattern_{}_{}x{}.{}", pattern_name(type), width, height, yuv_format_name(format));
+    if (bitDepth > 8)
+    {
+        filename += fmt::format("p{}", bitDepth);
+    }
+    std::ofstream oFile(filename, std::ios::out | std::ios::binary);
+    if (!oFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    PatternGenerator      generator(type, format, width, height);
+    bool                  semiPlanar = format == YUV_FORMAT_NV12 || format == YUV_FORMAT_NV21;
+    int                   shift      = semiPlanar ? 16 - 8 : bitDepth - 8;  // 半平面高位对齐，平面低位对齐
+    int                   rows       = generator.FrameSize() / width;       // 各平面连续存储，按宽为 width 的平面整体扩展
+    std::vector<uint16_t> wide(bitDepth > 8 ? generator.FrameSize() : 0);
+
+    for (int i = 0; i < number; i++)
+    {
+        const YuvFrame& frame = generator.Render(i);
+        if (bitDepth > 8)
+        {
+            plane_widen(frame.data[0], width, wide.data(), width, width, rows, shift);
+            oFile.write(reinterpret_cast<const char*>(wide.data()), wide.size() * sizeof(uint16_t));
+        }
+        else
+        {
+            oFile.write(reinterpret_cast<const char*>(frame.data[0]), generator.FrameSize());
+        }
+    }
+
+    oFile.close();
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#ifndef __YUV_PATTERN_H__
+#define __YUV_PATTERN_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/common/aligned_buffer.hpp"
+#include "yuv_frame.h"
+
+enum PatternType
+{
+    PATTERN_SMPTE_BARS = 0, // SMPTE 彩条（75% 彩条 + 反向色块 + PLUGE）
+    PATTERN_GRADIENT_H = 1, // 水平亮度渐变
+    PATTERN_GRADIENT_V = 2, // 垂直亮度渐变
+    PATTERN_ZONE_PLATE = 3, // 圆形波带片，随帧号平移相位
+    PATTERN_MOVING_BOX = 4, // 在背景上往返运动的方块
+    PATTERN_NOISE      = 5, // 亮度均匀噪声，每帧不同
+};
+
+/**
+ * @brief   测试图生成器
+ * 1. 静态图样（彩条、渐变）在第一次渲染时按行构建一次，之后每帧直接复用同一块缓冲区
+ * 2. 动态图样增量生成：运动方块只擦除旧位置、绘制新位置；波带片的 x²、y² 相位项预先计算，
+ *    每帧只叠加时间相位；色度平面在所有动态图样中保持不变，只写一次
+ * 3. 波带片和噪声按行带多线程生成，噪声按（帧号, 行号）播种，结果与线程数无关
+ */
+class PatternGenerator
+{
+public:
+    /**
+     * @param   type                    [IN]        图样类型
+     * @param   format                  [IN]        像素格式
+     * @param   width                   [IN]        宽度（偶数）
+     * @param   height                  [IN]        高度（偶数）
+     */
+    PatternGenerator(PatternType type, YuvFormat format, int width, int height);
+    ~PatternGenerator() = default;
+
+    /**
+     * @brief   设置亮度范围（用于渐变的两端，以及运动方块的背景/前景），需在第一次渲染前调用
+     */
+    void SetLevels(int low, int high);
+
+    /**
+     * @brief   渲染第 index 帧
+     * 按顺序调用时动态图样走增量路径，跳帧时整帧重绘；返回的视图指向内部缓冲区，
+     * 在下一次调用前有效，连续存储，大小为 FrameSize()
+     */
+    const YuvFrame& Render(int index);
+
+    int FrameSize() const
+    {
+        return m_frame_size;
+    }
+
+private:
+    void FillChroma(uint8_t u, uint8_t v);
+    void DrawBars();
+    void DrawGradient();
+    void DrawZonePlate(int index);
+    void DrawBox(int index);
+    void DrawNoise(int index);
+    void BoxPosition(int index, int& x, int& y) const;
+    void FillLumaRect(int x, int y, int w, int h, uint8_t value);
+
+private:
+    PatternType            m_type;       // 图样类型
+    int                    m_width;      // 宽度
+    int                    m_height;     // 高度
+    int                    m_low;        // 亮度下限
+    int                    m_high;       // 亮度上限
+    int                    m_frame_size; // 每帧字节数
+    int                    m_last;       // 上一次渲染的帧号，-1 表示缓冲区内容无效
+    AlignedBuffer<uint8_t> m_buffer;     // 帧缓冲区
+    YuvFrame               m_frame;      // 帧视图
+    std::vector<uint32_t>  m_phase_x;    // 波带片 x² 相位项
+    std::vector<uint32_t>  m_phase_y;    // 波带片 y² 相位项
+};
+
+/**
+ * @brief   生成测试图序列
+ * @param   type                    [IN]        图样类型
+ * @param   format                  [IN]        像素格式
+ * @param   width                   [IN]        图像帧的宽度（偶数）
+ * @param   height                  [IN]        图像帧的高度（偶数）
+ * @param   number                  [IN]        生成的帧数
+ * @param   bitDepth                [IN]        采样位深（8/10/12/16），高于 8 位时每个采样2字节：
+ *                                              平面格式低位对齐（yuv420p10le 等），半平面格式高位对齐（P010 等）
+ * @return  0                                   成功
+ *          其他                                失败
+ * 输出文件为 pattern_<类型>_<宽>x<高>.<格式>，高位深为 .<格式>p<位深>
+ */
+int simplest_yuv_pattern(PatternType type, YuvFormat format, int width, int height, int number, int bitDepth = 8);
+
+#endif
@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_plane.h"
+
+namespace
+{
+    constexpr int kMinRowsPerThread = 32;
+
+    uint64_t sse_row(const uint8_t* a, const uint8_t* b, int width)
+    {
+        uint64_t sum = 0;
+        int      x   = 0;
+#if SIMD_SSE2
+        // 差值平方用 pmaddwd 两两相加，每行结束时把 32 位累加器汇总（4K 一行也不会溢出）
+        const __m128i zero = _mm_setzero_si128();
+        __m128i       acc  = _mm_setzero_si128();
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero));
+            __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero));
+            acc        = _mm_add_epi32(acc, _mm_madd_epi16(lo, lo));
+            acc        = _mm_add_epi32(acc, _mm_madd_epi16(hi, hi));
+        }
+        uint32_t lanes[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        sum = static_cast<uint64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+#elif SIMD_NEON
+        uint32x4_t acc = vdupq_n_u32(0);
+        for (; x + 16 <= width; x += 16)
+        {
+            uint8x16_t d  = vabdq_u8(vld1q_u8(a + x), vld1q_u8(b + x));
+            uint16x8_t lo = vmull_u8(vget_low_u8(d), vget_low_u8(d));
+            uint16x8_t hi = vmull_u8(vget_high_u8(d), vget_high_u8(d));
+            acc           = vpadalq_u16(acc, lo);
+            acc           = vpadalq_u16(acc, hi);
+        }
+        sum = static_cast<uint64_t>(vgetq_lane_u32(acc, 0)) + vgetq_lane_u32(acc, 1) + vgetq_lane_u32(acc, 2) + vgetq_lane_u32(acc, 3);
+#endif
+        for (; x < width; x++)
+        {
+            int diff = a[x] - b[x];
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+    uint64_t sse_row(const uint16_t* a, const uint16_t* b, int width)
+    {
+        uint64_t sum = 0;
+        int      x   = 0;
+#if SIMD_SSE2
+        // |a - b| 用两次无符号饱和减法得到，平方的高低16位拼成32位后扩展到64位累加，16位满幅也不溢出
+        const __m128i zero = _mm_setzero_si128();
+        __m128i       acc  = _mm_setzero_si128();
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            __m128i d  = _mm_or_si128(_mm_subs_epu16(va, vb), _mm_subs_epu16(vb, va));
+            __m128i lo = _mm_mullo_epi16(d, d);
+            __m128i hi = _mm_mulhi_epu16(d, d);
+            __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+            __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+            acc        = _mm_add_epi64(acc, _mm_unpacklo_epi32(p0, zero));
+            acc        = _mm_add_epi64(acc, _mm_unpackhi_epi32(p0, zero));
+            acc        = _mm_add_epi64(acc, _mm_unpacklo_epi32(p1, zero));
+            acc        = _mm_add_epi64(acc, _mm_unpackhi_epi32(p1, zero));
+        }
+        uint64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        sum = lanes[0] + lanes[1];
+#elif SIMD_NEON
+        uint64x2_t acc = vdupq_n_u64(0);
+        for (; x + 8 <= width; x += 8)
+        {
+            uint16x8_t d  = vabdq_u16(vld1q_u16(a + x), vld1q_u16(b + x));
+            uint32x4_t lo = vmull_u16(vget_low_u16(d), vget_low_u16(d));
+            uint32x4_t hi = vmull_u16(vget_high_u16(d), vget_high_u16(d));
+            acc           = vpadalq_u32(acc, lo);
+            acc           = vpadalq_u32(acc, hi);
+        }
+        sum = vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1);
+#endif
+        for (; x < width; x++)
+        {
+            int64_t diff = static_cast<int64_t>(a[x]) - b[x];
+            sum += static_cast<uint64_t>(diff * diff);
+        }
+        return sum;
+    }
+
+    uint64_t sad_row(const uint8_t* a, const uint8_t* b, int width)
+    {
+        uint64_t sum = 0;
+        int      x   = 0;
+#if SIMD_SSE2
+        // psadbw 直接得到两个 64 位部分和
+        __m128i acc = _mm_setzero_si128();
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            acc        = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+        }
+        uint64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        sum = lanes[0] + lanes[1];
+#elif SIMD_NEON
+        uint32x4_t acc = vdupq_n_u32(0);
+        for (; x + 16 <= width; x += 16)
+        {
+            uint8x16_t va = vld1q_u8(a + x);
+            uint8x16_t vb = vld1q_u8(b + x);
+            uint16x8_t d  = vabdl_u8(vget_low_u8(va), vget_low_u8(vb));
+            d             = vabal_u8(d, vget_high_u8(va), vget_high_u8(vb));
+            acc           = vpadalq_u16(acc, d);
+        }
+        sum = static_cast<uint64_t>(vgetq_lane_u32(acc, 0)) + vgetq_lane_u32(acc, 1) + vgetq_lane_u32(acc, 2) + vgetq_lane_u32(acc, 3);
+#endif
+        for (; x < width; x++)
+        {
+            sum += static_cast<uint64_t>(std::abs(a[x] - b[x]));
+        }
+        return sum;
+    }
+
+    void fill_row(uint8_t* row, int width, uint8_t value)
+    {
+        memset(row, value, width);
+    }
+
+    void fill_row(uint16_t* row, int width, uint16_t value)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        const __m128i v = _mm_set1_epi16(static_cast<short>(value));
+        for (; x + 8 <= width; x += 8)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), v);
+        }
+#elif SIMD_NEON
+        const uint16x8_t v = vdupq_n_u16(value);
+        for (; x + 8 <= width; x += 8)
+        {
+            vst1q_u16(row + x, v);
+        }
+#endif
+        for (; x < width; x++)
+        {
+            row[x] = value;
+        }
+    }
+
+    void shift_row(const uint16_t* src, uint16_t* dst, int width, int shift)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        const __m128i count = _mm_cvtsi32_si128(shift > 0 ? shift : -shift);
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            v         = (shift > 0) ? _mm_sll_epi16(v, count) : _mm_srl_epi16(v, count);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), v);
+        }
+#elif SIMD_NEON
+        const int16x8_t count = vdupq_n_s16(static_cast<int16_t>(shift));
+        for (; x + 8 <= width; x += 8)
+        {
+            vst1q_u16(dst + x, vshlq_u16(vld1q_u16(src + x), count));
+        }
+#endif
+        for (; x < width; x++)
+        {
+            dst[x] = static_cast<uint16_t>(shift > 0 ? src[x] << shift : src[x] >> -shift);
+        }
+    }
+} // namespace
+
+template <typename T>
+void plane_fill(T* plane, int stride, int width, int height, T value)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            fill_row(plane + static_cast<size_t>(y) * stride, width, value);
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+template <typename T>
+void plane_border(T* plane, int stride, int width, int height, int border, T value)
+{
+    border = std::clamp(border, 0, std::max(width, height));
+    for (int y = 0; y < height; y++)
+    {
+        T* row = plane + static_cast<size_t>(y) * stride;
+        if (y < border || y >= height - border)
+        {
+            fill_row(row, width, value);
+            continue;
+        }
+        int side = std::min(border, width);
+        fill_row(row, side, value);
+        fill_row(row + width - side, side, value);
+    }
+}
+
+template <typename T>
+uint64_t plane_sse(const T* a, int aStride, const T* b, int bStride, int width, int height)
+{
+    std::atomic<uint64_t> total(0);
+
+    auto rows = [&](int begin, int end) {
+        uint64_t sum = 0;
+        for (int y = begin; y < end; y++)
+        {
+            sum += sse_row(a + static_cast<size_t>(y) * aStride, b + static_cast<size_t>(y) * bStride, width);
+        }
+        total += sum;
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+    return total;
+}
+
+template void     plane_fill<uint8_t>(uint8_t*, int, int, int, uint8_t);
+template void     plane_fill<uint16_t>(uint16_t*, int, int, int, uint16_t);
+template void     plane_border<uint8_t>(uint8_t*, int, int, int, int, uint8_t);
+template void     plane_border<uint16_t>(uint16_t*, int, int, int, int, uint16_t);
+template uint64_t plane_sse<uint8_t>(const uint8_t*, int, const uint8_t*, int, int, int);
+template uint64_t plane_sse<uint16_t>(const uint16_t*, int, const uint16_t*, int, int, int);
+
+uint64_t plane_sad(const uint8_t* a, int aStride, const uint8_t* b, int bStride, int width, int height)
+{
+    std::atomic<uint64_t> total(0);
+
+    auto rows = [&](int begin, int end) {
+        uint64_t sum = 0;
+        for (int y = begin; y < end; y++)
+        {
+            sum += sad_row(a + static_cast<size_t>(y) * aStride, b + static_cast<size_t>(y) * bStride, width);
+        }
+        total += sum;
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+    return total;
+}
+
+void plane_widen(const uint8_t* src, int srcStride, uint16_t* dst, int dstStride, int width, int height, int shift)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            const uint8_t* s = src + static_cast<size_t>(y) * srcStride;
+            uint16_t*      d = dst + static_cast<size_t>(y) * dstStride;
+            int            x = 0;
+#if SIMD_SSE2
+            const __m128i zero  = _mm_setzero_si128();
+            const __m128i count = _mm_cvtsi32_si128(shift);
+            for (; x + 16 <= width; x += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + x));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x), _mm_sll_epi16(_mm_unpacklo_epi8(v, zero), count));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x + 8), _mm_sll_epi16(_mm_unpackhi_epi8(v, zero), count));
+            }
+#endif
+            for (; x < width; x++)
+            {
+                d[x] = static_cast<uint16_t>(s[x] << shift);
+            }
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+void plane_narrow(const uint16_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, int shift)
+{
+    int round = shift > 0 ? 1 << (shift - 1) : 0;
+
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            const uint16_t* s = src + static_cast<size_t>(y) * srcStride;
+            uint8_t*        d = dst + static_cast<size_t>(y) * dstStride;
+            int             x = 0;
+#if SIMD_SSE2
+            const __m128i bias  = _mm_set1_epi16(static_cast<short>(round));
+            const __m128i count = _mm_cvtsi32_si128(shift);
+            // 饱和加法避免 16 位满幅时进位溢出；右移后不超过 32767，packus 按有符号数饱和到 8 位
+            for (; shift > 0 && x + 16 <= width; x += 16)
+            {
+                __m128i a = _mm_srl_epi16(_mm_adds_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + x)), bias), count);
+                __m128i b = _mm_srl_epi16(_mm_adds_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + x + 8)), bias), count);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d + x), _mm_packus_epi16(a, b));
+            }
+#endif
+            for (; x < width; x++)
+            {
+                d[x] = static_cast<uint8_t>(std::min((std::min(s[x] + round, 0xffff)) >> shift, 255));
+            }
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+void plane_shift(const uint16_t* src, int srcStride, uint16_t* dst, int dstStride, int width, int height, int shift)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            shift_row(src + static_cast<size_t>(y) * srcStride, dst + static_cast<size_t>(y) * dstStride, width, shift);
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+void p010_uv_deinterleave(const uint16_t* uv, int uvStride, uint16_t* u, int uStride, uint16_t* v, int vStride, int width, int height)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            const uint16_t* s  = uv + static_cast<size_t>(y) * uvStride;
+            uint16_t*       du = u + static_cast<size_t>(y) * uStride;
+            uint16_t*       dv = v + static_cast<size_t>(y) * vStride;
+            int             x  = 0;
+#if SIMD_SSE2
+            // 右移6位后取值不超过 1023，可以用有符号 packs 从32位通道中取出低/高16位
+            for (; x + 8 <= width; x += 8)
+            {
+                __m128i a  = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * x)), 6);
+                __m128i b  = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2 * x + 8)), 6);
+                __m128i ua = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+                __m128i ub = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+                __m128i va = _mm_srai_epi32(a, 16);
+                __m128i vb = _mm_srai_epi32(b, 16);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(du + x), _mm_packs_epi32(ua, ub));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dv + x), _mm_packs_epi32(va, vb));
+            }
+#elif SIMD_NEON
+            for (; x + 8 <= width; x += 8)
+            {
+                uint16x8x2_t p = vld2q_u16(s + 2 * x);
+                vst1q_u16(du + x, vshrq_n_u16(p.val[0], 6));
+                vst1q_u16(dv + x, vshrq_n_u16(p.val[1], 6));
+            }
+#endif
+            for (; x < width; x++)
+            {
+                du[x] = static_cast<uint16_t>(s[2 * x] >> 6);
+                dv[x] = static_cast<uint16_t>(s[2 * x + 1] >> 6);
+            }
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
+
+void p010_uv_interleave(const uint16_t* u, int uStride, const uint16_t* v, int vStride, uint16_t* uv, int uvStride, int width, int height)
+{
+    auto rows = [&](int begin, int end) {
+        for (int y = begin; y < end; y++)
+        {
+            const uint16_t* su = u + static_cast<size_t>(y) * uStride;
+            const uint16_t* sv = v + static_cast<size_t>(y) * vStride;
+            uint16_t*       d  = uv + static_cast<size_t>(y) * uvStride;
+            int             x  = 0;
+#if SIMD_SSE2
+            for (; x + 8 <= width; x += 8)
+            {
+                __m128i a = _mm_slli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(su + x)), 6);
+                __m128i b = _mm_slli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sv + x)), 6);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * x), _mm_unpacklo_epi16(a, b));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 2 * x + 8), _mm_unpackhi_epi16(a, b));
+            }
+#elif SIMD_NEON
+            for (; x + 8 <= width; x += 8)
+            {
+                uint16x8x2_t p;
+                p.val[0] = vshlq_n_u16(vld1q_u16(su + x), 6);
+                p.val[1] = vshlq_n_u16(vld1q_u16(sv + x), 6);
+                vst2q_u16(d + 2 * x, p);
+            }
+#endif
+            for (; x < width; x++)
+            {
+                d[2 * x]     = static_cast<uint16_t>(su[x] << 6);
+                d[2 * x + 1] = static_cast<uint16_t>(sv[x] << 6);
+            }
+        }
+    };
+    parallel_for_rows(height, rows, kMinRowsPerThread);
+}
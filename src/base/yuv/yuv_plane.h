@@ -0,0 +1,71 @@
+#ifndef __YUV_PLANE_H__
+#define __YUV_PLANE_H__
+
+#include <cstdint>
+
+/**
+ * 平面级内核，按采样类型模板化：
+ *  uint8_t     8 位
+ *  uint16_t    10/12/16 位，低位对齐（yuv420p10le 等），P010 为高位对齐，见 p010_* 转换
+ * 行跨度均以采样点数计；uint8_t 与 uint16_t 各有 SSE2/NEON 特化，大平面按行带多线程
+ */
+
+/**
+ * @brief   把平面的 width x height 区域置为 value
+ */
+template <typename T>
+void plane_fill(T* plane, int stride, int width, int height, T value);
+
+/**
+ * @brief   在平面四周画宽度为 border 的边框
+ */
+template <typename T>
+void plane_border(T* plane, int stride, int width, int height, int border, T value);
+
+/**
+ * @brief   两个平面的误差平方和
+ * @return  Σ(a - b)²
+ */
+template <typename T>
+uint64_t plane_sse(const T* a, int aStride, const T* b, int bStride, int width, int height);
+
+/**
+ * @brief   两个 8 位平面的绝对差之和（SSE2 psadbw / NEON vabal）
+ * @return  Σ|a - b|
+ */
+uint64_t plane_sad(const uint8_t* a, int aStride, const uint8_t* b, int bStride, int width, int height);
+
+/**
+ * @brief   8 位平面扩展为高位深：dst = src << shift（8 -> 10 位时 shift = 2）
+ */
+void plane_widen(const uint8_t* src, int srcStride, uint16_t* dst, int dstStride, int width, int height, int shift);
+
+/**
+ * @brief   高位深平面量化为 8 位：dst = (src + round) >> shift，饱和到 255
+ */
+void plane_narrow(const uint16_t* src, int srcStride, uint8_t* dst, int dstStride, int width, int height, int shift);
+
+/**
+ * @brief   高/低位对齐互转：shift > 0 左移（低位对齐 -> P010），shift < 0 右移，dst 可与 src 相同
+ */
+void plane_shift(const uint16_t* src, int srcStride, uint16_t* dst, int dstStride, int width, int height, int shift);
+
+/**
+ * @brief   P010 交织色度平面拆分为低位对齐的 U、V 平面
+ * @param   uv                      [IN]        P010 UV 平面（高10位有效）
+ * @param   uvStride                [IN]        UV 平面行跨度（采样点数）
+ * @param   u                       [OUT]       U 平面
+ * @param   uStride                 [IN]        U 平面行跨度
+ * @param   v                       [OUT]       V 平面
+ * @param   vStride                 [IN]        V 平面行跨度
+ * @param   width                   [IN]        色度宽度（采样点数）
+ * @param   height                  [IN]        色度高度
+ */
+void p010_uv_deinterleave(const uint16_t* uv, int uvStride, uint16_t* u, int uStride, uint16_t* v, int vStride, int width, int height);
+
+/**
+ * @brief   低位对齐的 U、V 平面交织为 P010 色度平面
+ */
+void p010_uv_interleave(const uint16_t* u, int uStride, const uint16_t* v, int vStride, uint16_t* uv, int uvStride, int width, int height);
+
+#endif
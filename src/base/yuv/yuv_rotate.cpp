@@ -0,0 +1,123 @@
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/aligned_buffer.hpp"
+#include "base/common/benchmark.hpp"
+#include "yuv_pattern.h"
+#include "yuv_rotate.h"
+
+int yuv_frame_rotate(const YuvFrame& src, YuvFrame& dst, RotateMode mode)
+{
+    bool swap      = rotate_swaps_axes(mode);
+    int  dstWidth  = swap ? src.height : src.width;
+    int  dstHeight = swap ? src.width : src.height;
+    if (src.format != dst.format || dst.width != dstWidth || dst.height != dstHeight)
+    {
+        SPDLOG_ERROR("Rotate frame mismatch: {}x{} -> {}x{}", src.width, src.height, dst.width, dst.height);
+        return -1;
+    }
+    if (swap && src.format == YUV_FORMAT_I422)
+    {
+        SPDLOG_ERROR("Rotate: I422 does not support {}", rotate_mode_name(mode));
+        return -1;
+    }
+
+    rotate_plane<1>(src.data[0], src.stride[0], dst.data[0], dst.stride[0], src.width, src.height, mode);
+
+    int shiftX, shiftY;
+    yuv_chroma_shift(src.format, shiftX, shiftY);
+    int chromaWidth  = (src.width + (1 << shiftX) - 1) >> shiftX;
+    int chromaHeight = (src.height + (1 << shiftY) - 1) >> shiftY;
+    if (yuv_is_semi_planar(src.format))
+    {
+        rotate_plane<2>(src.data[1], src.stride[1], dst.data[1], dst.stride[1], chromaWidth, chromaHeight, mode);
+    }
+    else
+    {
+        rotate_plane<1>(src.data[1], src.stride[1], dst.data[1], dst.stride[1], chromaWidth, chromaHeight, mode);
+        rotate_plane<1>(src.data[2], src.stride[2], dst.data[2], dst.stride[2], chromaWidth, chromaHeight, mode);
+    }
+
+    return 0;
+}
+
+int rotate_benchmark()
+{
+    constexpr int    kIterations = 10;
+    const int        sizes[][2]  = {{1920, 1080}, {3840, 2160}};
+    const YuvFormat  formats[]   = {YUV_FORMAT_I420, YUV_FORMAT_NV12};
+    const RotateMode modes[]     = {ROTATE_90, ROTATE_180, ROTATE_270, ROTATE_FLIP_H, ROTATE_TRANSPOSE};
+
+    for (const auto& size : sizes)
+    {
+        for (YuvFormat format : formats)
+        {
+            int                    width     = size[0];
+            int                    height    = size[1];
+            int                    frameSize = yuv_frame_size(format, width, height);
+            PatternGenerator       generator(PATTERN_ZONE_PLATE, format, width, height);
+            AlignedBuffer<uint8_t> out(frameSize), reference(frameSize);
+            const YuvFrame&        src = generator.Render(0);
+
+            for (RotateMode mode : modes)
+            {
+                bool     swap     = rotate_swaps_axes(mode);
+                YuvFrame dst      = yuv_frame_wrap(out.Data(), format, swap ? height : width, swap ? width : height);
+                YuvFrame expected = yuv_frame_wrap(reference.Data(), format, dst.width, dst.height);
+
+                // 亮度平面对比逐像素实现（色度走同样的内核）
+                yuv_frame_rotate(src, dst, mode);
+                rotate_plane_c<1>(src.data[0], src.stride[0], expected.data[0], expected.stride[0], width, height, mode);
+                if (memcmp(dst.data[0], expected.data[0], static_cast<size_t>(width) * height) != 0)
+                {
+                    SPDLOG_ERROR("Rotate: {} result mismatch", rotate_mode_name(mode));
+                    return -1;
+                }
+
+                double seconds = benchmark_seconds([&] { yuv_frame_rotate(src, dst, mode); }, kIterations);
+                double naive   = benchmark_seconds([&] { rotate_plane_c<1>(src.data[0], src.stride[0], expected.data[0], expected.stride[0], width, height, mode); }, kIterations);
+                SPDLOG_INFO("Rotate {} {} {}x{}: {:.0f} fps (scalar luma only {:.0f} fps)", yuv_format_name(format), rotate_mode_name(mode), width, height, 1.0 / seconds, 1.0 / naive);
+            }
+        }
+    }
+
+    return 0;
+}
+
+int simplest_yuv420_rotate(const std::string& filename, int width, int height, RotateMode mode, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + "." + rotate_mode_name(mode), std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    bool     swap      = rotate_swaps_axes(mode);
+    int      frameSize = width * height * 3 / 2; // YUV420P每帧字节数
+    uint8_t* pic       = new uint8_t[frameSize];
+    uint8_t* out       = new uint8_t[frameSize];
+    YuvFrame src       = yuv_frame_wrap(pic, YUV_FORMAT_I420, width, height);
+    YuvFrame dst       = yuv_frame_wrap(out, YUV_FORMAT_I420, swap ? height : width, swap ? width : height);
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(pic), frameSize))
+        {
+            break;
+        }
+        yuv_frame_rotate(src, dst, mode);
+        oFile.write(reinterpret_cast<const char*>(out), frameSize);
+    }
+
+    delete[] pic;
+    delete[] out;
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef __YUV_ROTATE_H__
+#define __YUV_ROTATE_H__
+
+#include <string>
+
+#include "base/common/rotate.hpp"
+#include "yuv_frame.h"
+
+/**
+ * @brief   旋转/翻转一帧
+ * 亮度和 U、V 平面用 8x8 字节块转置，NV12/NV21 的 UV 交织平面按 16 位像素转置，UV 顺序不变；
+ * I422 的色度只在水平方向下采样，旋转 90/270 度或转置后无法表示，只支持翻转和 180 度
+ * @param   src                     [IN]        源帧
+ * @param   dst                     [IN/OUT]    目标帧，格式与源帧一致，转置类的宽高互换，平面由调用者分配
+ * @param   mode                    [IN]        旋转方式
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int yuv_frame_rotate(const YuvFrame& src, YuvFrame& dst, RotateMode mode);
+
+/**
+ * @brief   旋转吞吐测试（1080p / 4K 的 I420 与 NV12，对比逐像素标量实现）
+ * @return  0                                   成功
+ *          其他                                结果与标量实现不一致
+ */
+int rotate_benchmark();
+
+/**
+ * @brief   旋转/翻转YUV420P像素数据，写入 <filename>.rot90 / .fliph 等（扩展名见 rotate_mode_name）
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   mode                    [IN]        旋转方式
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_rotate(const std::string& filename, int width, int height, RotateMode mode, int number);
+
+#endif
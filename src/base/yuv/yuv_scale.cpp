@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_scale.h"
+
+namespace
+{
+    constexpr double kPi        = 3.14159265358979323846;
+    constexpr int    kCoeffBits = 14;                  // 滤波系数定点位数，系数和为 1 << 14
+    constexpr int    kInterBits = 6;                   // 水平结果保留的小数位
+    constexpr int    kHoriShift = kCoeffBits - kInterBits;
+    constexpr int    kVertShift = kCoeffBits + kInterBits;
+
+    double filter_radius(ScaleFilter filter)
+    {
+        switch (filter)
+        {
+        case SCALE_FILTER_BICUBIC: return 2.0;
+        case SCALE_FILTER_LANCZOS: return 3.0;
+        default: return 1.0;
+        }
+    }
+
+    double filter_kernel(ScaleFilter filter, double x)
+    {
+        x = std::fabs(x);
+        switch (filter)
+        {
+        case SCALE_FILTER_BICUBIC:
+        {
+            // Catmull-Rom，a = -0.5
+            const double a = -0.5;
+            if (x < 1.0)
+            {
+                return ((a + 2) * x - (a + 3)) * x * x + 1;
+            }
+            if (x < 2.0)
+            {
+                return ((a * x - 5 * a) * x + 8 * a) * x - 4 * a;
+            }
+            return 0.0;
+        }
+        case SCALE_FILTER_LANCZOS:
+        {
+            if (x < 1e-8)
+            {
+                return 1.0;
+            }
+            if (x < 3.0)
+            {
+                double px = kPi * x;
+                return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+            }
+            return 0.0;
+        }
+        default:
+            return std::max(0.0, 1.0 - x);
+        }
+    }
+
+    /**
+     * @brief   水平滤波一行，输出带 kInterBits 位小数的 int16
+     * 源行必须至少可读 offset[dstWidth - 1] + taps 个字节
+     */
+    void scale_row_horizontal(const uint8_t* src, int dstWidth, int taps, const int* offset, const int16_t* coeff, int16_t* out)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        // 每次处理两个输出像素，每个像素的抽头按4个一组送入 pmaddwd
+        const __m128i zero  = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi32(1 << (kHoriShift - 1));
+        for (; x + 2 <= dstWidth; x += 2)
+        {
+            const uint8_t* pa  = src + offset[x];
+            const uint8_t* pb  = src + offset[x + 1];
+            const int16_t* ca  = coeff + static_cast<size_t>(x) * taps;
+            const int16_t* cb  = ca + taps;
+            __m128i        acc = zero;
+            for (int k = 0; k < taps; k += 4)
+            {
+                int32_t a4, b4;
+                memcpy(&a4, pa + k, 4);
+                memcpy(&b4, pb + k, 4);
+                __m128i v = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(a4), _mm_cvtsi32_si128(b4)), zero);
+                __m128i c = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ca + k)),
+                                               _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cb + k)));
+                acc       = _mm_add_epi32(acc, _mm_madd_epi16(v, c));
+            }
+            // [a01, a23, b01, b23] -> lane0 = a, lane2 = b
+            acc        = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+            acc        = _mm_srai_epi32(_mm_add_epi32(acc, round), kHoriShift);
+            out[x]     = static_cast<int16_t>(_mm_cvtsi128_si32(acc));
+            out[x + 1] = static_cast<int16_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+        }
+#endif
+        for (; x < dstWidth; x++)
+        {
+            const uint8_t* p   = src + offset[x];
+            const int16_t* c   = coeff + static_cast<size_t>(x) * taps;
+            int            sum = 0;
+            for (int k = 0; k < taps; k++)
+            {
+                sum += p[k] * c[k];
+            }
+            out[x] = static_cast<int16_t>((sum + (1 << (kHoriShift - 1))) >> kHoriShift);
+        }
+    }
+
+    /**
+     * @brief   垂直滤波一行，rows 为 taps 个中间行（抽头数为偶数）
+     */
+    void scale_row_vertical(const int16_t* const* rows, const int16_t* coeff, int taps, int width, uint8_t* dst)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        const __m128i round = _mm_set1_epi32(1 << (kVertShift - 1));
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i lo = _mm_setzero_si128();
+            __m128i hi = _mm_setzero_si128();
+            for (int k = 0; k < taps; k += 2)
+            {
+                // 相邻两行交织后与 (c0, c1) 做 pmaddwd
+                __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + x));
+                __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1] + x));
+                __m128i c  = _mm_set1_epi32(static_cast<uint16_t>(coeff[k]) | (static_cast<uint32_t>(static_cast<uint16_t>(coeff[k + 1])) << 16));
+                lo         = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(r0, r1), c));
+                hi         = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(r0, r1), c));
+            }
+            lo          = _mm_srai_epi32(_mm_add_epi32(lo, round), kVertShift);
+            hi          = _mm_srai_epi32(_mm_add_epi32(hi, round), kVertShift);
+            __m128i pix = _mm_packus_epi16(_mm_packs_epi32(lo, hi), _mm_setzero_si128());
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x), pix);
+        }
+#endif
+        for (; x < width; x++)
+        {
+            int sum = 0;
+            for (int k = 0; k < taps; k++)
+            {
+                sum += rows[k][x] * coeff[k];
+            }
+            dst[x] = static_cast<uint8_t>(std::clamp((sum + (1 << (kVertShift - 1))) >> kVertShift, 0, 255));
+        }
+    }
+} // namespace
+
+PlaneScaler::PlaneScaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ScaleFilter filter)
+    : m_src_width(srcWidth)
+    , m_src_height(srcHeight)
+    , m_dst_width(dstWidth)
+    , m_dst_height(dstHeight)
+{
+    m_horizontal = BuildFilter(srcWidth, dstWidth, filter, 4);
+    m_vertical   = BuildFilter(srcHeight, dstHeight, filter, 2);
+}
+
+PlaneScaler::FilterBank PlaneScaler::BuildFilter(int srcSize, int dstSize, ScaleFilter filter, int align)
+{
+    FilterBank bank;
+    double     scale   = static_cast<double>(srcSize) / dstSize;
+    double     stretch = std::max(scale, 1.0); // 缩小时拉宽核，起到抗混叠作用
+    double     support = filter_radius(filter) * stretch;
+    int        taps    = std::min(static_cast<int>(std::ceil(support * 2)), srcSize);
+    bank.taps          = (taps + align - 1) / align * align;
+    bank.offset.resize(dstSize);
+    bank.coeff.assign(static_cast<size_t>(dstSize) * bank.taps, 0);
+
+    std::vector<double> weight(bank.taps);
+    for (int i = 0; i < dstSize; i++)
+    {
+        // 像素中心对齐
+        double center = (i + 0.5) * scale - 0.5;
+        int    start  = static_cast<int>(std::floor(center - support)) + 1;
+        int    offset = std::clamp(start, 0, std::max(srcSize - bank.taps, 0));
+
+        // 超出边界的抽头折叠到边缘像素
+        std::fill(weight.begin(), weight.end(), 0.0);
+        double sum = 0.0;
+        for (int j = 0; j < taps; j++)
+        {
+            int    pos = std::clamp(start + j, 0, srcSize - 1);
+            double w   = filter_kernel(filter, (start + j - center) / stretch);
+            weight[pos - offset] += w;
+            sum += w;
+        }
+
+        // 归一化为定点，舍入误差补到最大的系数上
+        int16_t* coeff = bank.coeff.data() + static_cast<size_t>(i) * bank.taps;
+        int      total = 0;
+        int      peak  = 0;
+        for (int j = 0; j < bank.taps; j++)
+        {
+            coeff[j] = static_cast<int16_t>(std::lround(weight[j] / sum * (1 << kCoeffBits)));
+            total += coeff[j];
+            if (coeff[j] > coeff[peak])
+            {
+                peak = j;
+            }
+        }
+        coeff[peak] += static_cast<int16_t>((1 << kCoeffBits) - total);
+        bank.offset[i] = offset;
+    }
+
+    return bank;
+}
+
+void PlaneScaler::ScaleRows(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int begin, int end) const
+{
+    const int ringSize = m_vertical.taps;
+    // 源宽度小于抽头数时，水平滤波会读越界，需要先拷贝到补齐的行缓冲区
+    const bool            padLine = m_horizontal.taps > m_src_width;
+    std::vector<uint8_t>  line(padLine ? m_horizontal.taps + 4 : 0);
+    std::vector<int16_t>  ring(static_cast<size_t>(ringSize) * m_dst_width);
+    std::vector<int>      ringRow(ringSize, -1);
+    std::vector<int16_t*> rows(ringSize);
+
+    for (int y = begin; y < end; y++)
+    {
+        int offset = m_vertical.offset[y];
+        for (int k = 0; k < ringSize; k++)
+        {
+            int      row  = offset + k;
+            int      slot = row % ringSize;
+            int16_t* out  = ring.data() + static_cast<size_t>(slot) * m_dst_width;
+            if (ringRow[slot] != row)
+            {
+                const uint8_t* srcRow = src + static_cast<size_t>(std::min(row, m_src_height - 1)) * srcStride;
+                if (padLine)
+                {
+                    memcpy(line.data(), srcRow, m_src_width);
+                    std::fill(line.begin() + m_src_width, line.end(), srcRow[m_src_width - 1]);
+                    srcRow = line.data();
+                }
+                scale_row_horizontal(srcRow, m_dst_width, m_horizontal.taps, m_horizontal.offset.data(), m_horizontal.coeff.data(), out);
+                ringRow[slot] = row;
+            }
+            rows[k] = out;
+        }
+        scale_row_vertical(rows.data(), m_vertical.coeff.data() + static_cast<size_t>(y) * m_vertical.taps, m_vertical.taps, m_dst_width, dst + static_cast<size_t>(y) * dstStride);
+    }
+}
+
+void PlaneScaler::Scale(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride) const
+{
+    parallel_for_rows(m_dst_height, [&](int begin, int end) { ScaleRows(src, srcStride, dst, dstStride, begin, end); });
+}
+
+int simplest_yuv420_scale(const std::string& filename, int width, int height, int dstWidth, int dstHeight, ScaleFilter filter, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + fmt::format(".{}x{}", dstWidth, dstHeight), std::ios::out | std::ios::binary);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int      frameSize    = width * height * 3 / 2;       // YUV420P每帧大小
+    int      ySize        = width * height;               // Y分量大小
+    int      dstFrameSize = dstWidth * dstHeight * 3 / 2; // 输出每帧大小
+    int      dstYSize     = dstWidth * dstHeight;         // 输出Y分量大小
+    uint8_t* frame        = new uint8_t[frameSize];
+    uint8_t* dstFrame     = new uint8_t[dstFrameSize];
+
+    // 滤波器组只生成一次，所有帧复用
+    PlaneScaler lumaScaler(width, height, dstWidth, dstHeight, filter);
+    PlaneScaler chromaScaler(width / 2, height / 2, dstWidth / 2, dstHeight / 2, filter);
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(frame), frameSize))
+        {
+            break;
+        }
+        lumaScaler.Scale(frame, width, dstFrame, dstWidth);
+        chromaScaler.Scale(frame + ySize, width / 2, dstFrame + dstYSize, dstWidth / 2);
+        chromaScaler.Scale(frame + ySize * 5 / 4, width / 2, dstFrame + dstYSize * 5 / 4, dstWidth / 2);
+        oFile.write(reinterpret_cast<char*>(dstFrame), dstFrameSize);
+    }
+
+    delete[] frame;
+    delete[] dstFrame;
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
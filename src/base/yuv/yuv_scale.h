@@ -0,0 +1,72 @@
+#ifndef __YUV_SCALE_H__
+#define __YUV_SCALE_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum ScaleFilter
+{
+    SCALE_FILTER_BILINEAR = 0, // 双线性，2抽头
+    SCALE_FILTER_BICUBIC  = 1, // 双三次（Catmull-Rom），4抽头
+    SCALE_FILTER_LANCZOS  = 2, // Lanczos3，6抽头
+};
+
+/**
+ * @brief   可分离多相缩放器（单个8位平面）
+ * 1. 构造时按 (src, dst) 尺寸一次性生成水平/垂直滤波器组，定点14位系数
+ * 2. 先水平后垂直，水平结果以 int16 保留6位小数写入环形行缓冲区
+ * 3. 垂直方向按输出行带多线程，每个线程维护自己的环形缓冲区
+ * 同一个实例可重复用于所有同尺寸的帧
+ */
+class PlaneScaler
+{
+public:
+    PlaneScaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight, ScaleFilter filter);
+    ~PlaneScaler() = default;
+
+    /**
+     * @brief   缩放一个平面
+     * @param   src                     [IN]        源平面
+     * @param   srcStride               [IN]        源平面行跨度（字节）
+     * @param   dst                     [OUT]       目标平面
+     * @param   dstStride               [IN]        目标平面行跨度（字节）
+     */
+    void Scale(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride) const;
+
+private:
+    typedef struct FilterBank
+    {
+        int                  taps;   // 每个输出像素的抽头数（已对齐）
+        std::vector<int>     offset; // 每个输出像素的第一个源像素位置
+        std::vector<int16_t> coeff;  // 系数，长度 = 输出尺寸 * taps
+    } FilterBank;
+
+    static FilterBank BuildFilter(int srcSize, int dstSize, ScaleFilter filter, int align);
+
+    void ScaleRows(const uint8_t* src, int srcStride, uint8_t* dst, int dstStride, int begin, int end) const;
+
+private:
+    int        m_src_width;
+    int        m_src_height;
+    int        m_dst_width;
+    int        m_dst_height;
+    FilterBank m_horizontal; // 水平滤波器组
+    FilterBank m_vertical;   // 垂直滤波器组
+};
+
+/**
+ * @brief   缩放YUV420P像素数据
+ * @param   filename                [IN]        yuv420 输入文件路径
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   dstWidth                [IN]        输出宽度（偶数）
+ * @param   dstHeight               [IN]        输出高度（偶数）
+ * @param   filter                  [IN]        插值滤波器
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_scale(const std::string& filename, int width, int height, int dstWidth, int dstHeight, ScaleFilter filter, int number);
+
+#endif
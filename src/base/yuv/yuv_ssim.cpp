@@ -0,0 +1,511 @@
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/parallel.hpp"
+#include "base/common/simd.h"
+#include "yuv_ssim.h"
+
+namespace
+{
+    // SSIM 常量：C1 = (0.01 * 255)^2，C2 = (0.03 * 255)^2
+    constexpr double kSsimC1 = 0.01 * 0.01 * 255 * 255;
+    constexpr double kSsimC2 = 0.03 * 0.03 * 255 * 255;
+
+    // 高斯窗口
+    constexpr int   kGaussTaps  = 11;
+    constexpr float kGaussSigma = 1.5f;
+
+    // MS-SSIM 各尺度权重
+    constexpr int    kMsScales            = 5;
+    constexpr double kMsWeight[kMsScales] = {0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+
+    /**
+     * @brief   计算一行4x4块的统计和（SoA 布局）
+     * @param   blocks  块数量，即 width / 4
+     */
+    void ssim_4x4_row(const uint8_t* a, int stride_a, const uint8_t* b, int stride_b, int blocks, int* s1, int* s2, int* ss, int* s12)
+    {
+        int x = 0;
+#if SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one  = _mm_set1_epi16(1);
+        // 把 [p01, p23, p45, p67] 两两相加得到两个块的和
+        auto fold = [](__m128i lo, __m128i hi) {
+            lo = _mm_add_epi32(lo, _mm_srli_epi64(lo, 32));
+            hi = _mm_add_epi32(hi, _mm_srli_epi64(hi, 32));
+            lo = _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 3, 2, 0));
+            hi = _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 3, 2, 0));
+            return _mm_unpacklo_epi64(lo, hi);
+        };
+        for (; x + 4 <= blocks; x += 4)
+        {
+            __m128i sumA = zero, sumB = zero;
+            __m128i sqLo = zero, sqHi = zero;
+            __m128i abLo = zero, abHi = zero;
+            for (int y = 0; y < 4; y++)
+            {
+                __m128i va  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + y * stride_a + x * 4));
+                __m128i vb  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + y * stride_b + x * 4));
+                __m128i aLo = _mm_unpacklo_epi8(va, zero);
+                __m128i aHi = _mm_unpackhi_epi8(va, zero);
+                __m128i bLo = _mm_unpacklo_epi8(vb, zero);
+                __m128i bHi = _mm_unpackhi_epi8(vb, zero);
+                // 每4个像素一个块，psadbw 只能按8字节求和，这里用16位累加
+                sumA = _mm_add_epi16(sumA, _mm_packs_epi32(_mm_madd_epi16(aLo, one), _mm_madd_epi16(aHi, one)));
+                sumB = _mm_add_epi16(sumB, _mm_packs_epi32(_mm_madd_epi16(bLo, one), _mm_madd_epi16(bHi, one)));
+                sqLo = _mm_add_epi32(sqLo, _mm_add_epi32(_mm_madd_epi16(aLo, aLo), _mm_madd_epi16(bLo, bLo)));
+                sqHi = _mm_add_epi32(sqHi, _mm_add_epi32(_mm_madd_epi16(aHi, aHi), _mm_madd_epi16(bHi, bHi)));
+                abLo = _mm_add_epi32(abLo, _mm_madd_epi16(aLo, bLo));
+                abHi = _mm_add_epi32(abHi, _mm_madd_epi16(aHi, bHi));
+            }
+            // sumA/sumB 中是 8 个像素对的和，每两个相邻对组成一个块
+            __m128i pairA = _mm_madd_epi16(sumA, one);
+            __m128i pairB = _mm_madd_epi16(sumB, one);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(s1 + x), pairA);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(s2 + x), pairB);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ss + x), fold(sqLo, sqHi));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(s12 + x), fold(abLo, abHi));
+        }
+#endif
+        for (; x < blocks; x++)
+        {
+            int t1 = 0, t2 = 0, tss = 0, t12 = 0;
+            for (int y = 0; y < 4; y++)
+            {
+                for (int i = 0; i < 4; i++)
+                {
+                    int va = a[y * stride_a + x * 4 + i];
+                    int vb = b[y * stride_b + x * 4 + i];
+                    t1 += va;
+                    t2 += vb;
+                    tss += va * va + vb * vb;
+                    t12 += va * vb;
+                }
+            }
+            s1[x]  = t1;
+            s2[x]  = t2;
+            ss[x]  = tss;
+            s12[x] = t12;
+        }
+    }
+
+    /**
+     * @brief   由8x8窗口（64个像素）的统计和计算SSIM
+     * 协方差使用无偏估计（除以 N-1），与高斯窗口版本保持一致的量纲
+     */
+    inline double ssim_end(double s1, double s2, double ss, double s12)
+    {
+        constexpr double c1 = kSsimC1 * 64 * 64;
+        constexpr double c2 = kSsimC2 * 64 * 63;
+
+        double vars  = ss * 64 - s1 * s1 - s2 * s2;
+        double covar = s12 * 64 - s1 * s2;
+        return (2 * s1 * s2 + c1) * (2 * covar + c2) / ((s1 * s1 + s2 * s2 + c1) * (vars + c2));
+    }
+
+    /**
+     * @brief   生成归一化的高斯窗口系数
+     */
+    std::vector<float> gaussian_window()
+    {
+        std::vector<float> window(kGaussTaps);
+        float              sum = 0.0f;
+        for (int i = 0; i < kGaussTaps; i++)
+        {
+            float d   = static_cast<float>(i - kGaussTaps / 2);
+            window[i] = std::exp(-(d * d) / (2 * kGaussSigma * kGaussSigma));
+            sum += window[i];
+        }
+        for (auto& w : window)
+        {
+            w /= sum;
+        }
+        return window;
+    }
+
+    /**
+     * @brief   水平高斯滤波一行，同时输出 μa、μb、E[a²]、E[b²]、E[ab]
+     * @param   outWidth    输出宽度，即 width - kGaussTaps + 1
+     */
+    void gaussian_row(const float* a, const float* b, const float* w, int outWidth, float* const out[5])
+    {
+        int x = 0;
+#if SIMD_SSE2
+        for (; x + 4 <= outWidth; x += 4)
+        {
+            __m128 m1 = _mm_setzero_ps(), m2 = _mm_setzero_ps();
+            __m128 q1 = _mm_setzero_ps(), q2 = _mm_setzero_ps(), q12 = _mm_setzero_ps();
+            for (int k = 0; k < kGaussTaps; k++)
+            {
+                __m128 wk = _mm_set1_ps(w[k]);
+                __m128 va = _mm_loadu_ps(a + x + k);
+                __m128 vb = _mm_loadu_ps(b + x + k);
+                __m128 wa = _mm_mul_ps(wk, va);
+                __m128 wb = _mm_mul_ps(wk, vb);
+                m1        = _mm_add_ps(m1, wa);
+                m2        = _mm_add_ps(m2, wb);
+                q1        = _mm_add_ps(q1, _mm_mul_ps(wa, va));
+                q2        = _mm_add_ps(q2, _mm_mul_ps(wb, vb));
+                q12       = _mm_add_ps(q12, _mm_mul_ps(wa, vb));
+            }
+            _mm_storeu_ps(out[0] + x, m1);
+            _mm_storeu_ps(out[1] + x, m2);
+            _mm_storeu_ps(out[2] + x, q1);
+            _mm_storeu_ps(out[3] + x, q2);
+            _mm_storeu_ps(out[4] + x, q12);
+        }
+#endif
+        for (; x < outWidth; x++)
+        {
+            float m1 = 0, m2 = 0, q1 = 0, q2 = 0, q12 = 0;
+            for (int k = 0; k < kGaussTaps; k++)
+            {
+                float wa = w[k] * a[x + k];
+                float wb = w[k] * b[x + k];
+                m1 += wa;
+                m2 += wb;
+                q1 += wa * a[x + k];
+                q2 += wb * b[x + k];
+                q12 += wa * b[x + k];
+            }
+            out[0][x] = m1;
+            out[1][x] = m2;
+            out[2][x] = q1;
+            out[3][x] = q2;
+            out[4][x] = q12;
+        }
+    }
+
+    /**
+     * @brief   浮点平面上的高斯窗口SSIM，平面连续存储（stride == width）
+     */
+    double ssim_gaussian_float(const float* a, const float* b, int width, int height, double* cs)
+    {
+        int outWidth  = width - kGaussTaps + 1;
+        int outHeight = height - kGaussTaps + 1;
+        if (outWidth <= 0 || outHeight <= 0)
+        {
+            if (cs)
+            {
+                *cs = 1.0;
+            }
+            return 1.0;
+        }
+
+        const std::vector<float> w = gaussian_window();
+        double                   ssimSum = 0.0;
+        double                   csSum   = 0.0;
+        std::mutex               mutex;
+
+        parallel_for_rows(outHeight, [&](int begin, int end) {
+            // 11行 x 5个统计量的环形缓冲区，行 y 存放在 y % kGaussTaps
+            std::vector<float> ring(static_cast<size_t>(kGaussTaps) * 5 * outWidth);
+            auto               slot = [&](int row, int q) { return ring.data() + (static_cast<size_t>(row % kGaussTaps) * 5 + q) * outWidth; };
+            auto               filter = [&](int row) {
+                float* out[5] = {slot(row, 0), slot(row, 1), slot(row, 2), slot(row, 3), slot(row, 4)};
+                gaussian_row(a + static_cast<size_t>(row) * width, b + static_cast<size_t>(row) * width, w.data(), outWidth, out);
+            };
+            for (int row = begin; row < begin + kGaussTaps - 1; row++)
+            {
+                filter(row);
+            }
+
+            double bandSsim = 0.0;
+            double bandCs   = 0.0;
+            for (int y = begin; y < end; y++)
+            {
+                filter(y + kGaussTaps - 1);
+                const float* rows[kGaussTaps][5];
+                for (int k = 0; k < kGaussTaps; k++)
+                {
+                    for (int q = 0; q < 5; q++)
+                    {
+                        rows[k][q] = slot(y + k, q);
+                    }
+                }
+
+                float rowSsim = 0.0f;
+                float rowCs   = 0.0f;
+                int   x       = 0;
+#if SIMD_SSE2
+                const __m128 c1   = _mm_set1_ps(static_cast<float>(kSsimC1));
+                const __m128 c2   = _mm_set1_ps(static_cast<float>(kSsimC2));
+                const __m128 two  = _mm_set1_ps(2.0f);
+                __m128       accS = _mm_setzero_ps();
+                __m128       accC = _mm_setzero_ps();
+                for (; x + 4 <= outWidth; x += 4)
+                {
+                    __m128 v[5] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+                    for (int k = 0; k < kGaussTaps; k++)
+                    {
+                        __m128 wk = _mm_set1_ps(w[k]);
+                        for (int q = 0; q < 5; q++)
+                        {
+                            v[q] = _mm_add_ps(v[q], _mm_mul_ps(wk, _mm_loadu_ps(rows[k][q] + x)));
+                        }
+                    }
+                    __m128 mu12   = _mm_mul_ps(v[0], v[1]);
+                    __m128 mu11   = _mm_mul_ps(v[0], v[0]);
+                    __m128 mu22   = _mm_mul_ps(v[1], v[1]);
+                    __m128 sigma1 = _mm_sub_ps(v[2], mu11);
+                    __m128 sigma2 = _mm_sub_ps(v[3], mu22);
+                    __m128 sigma  = _mm_sub_ps(v[4], mu12);
+                    __m128 csv    = _mm_div_ps(_mm_add_ps(_mm_mul_ps(two, sigma), c2), _mm_add_ps(_mm_add_ps(sigma1, sigma2), c2));
+                    __m128 lv     = _mm_div_ps(_mm_add_ps(_mm_mul_ps(two, mu12), c1), _mm_add_ps(_mm_add_ps(mu11, mu22), c1));
+                    accC          = _mm_add_ps(accC, csv);
+                    accS          = _mm_add_ps(accS, _mm_mul_ps(lv, csv));
+                }
+                float tmpS[4], tmpC[4];
+                _mm_storeu_ps(tmpS, accS);
+                _mm_storeu_ps(tmpC, accC);
+                rowSsim = tmpS[0] + tmpS[1] + tmpS[2] + tmpS[3];
+                rowCs   = tmpC[0] + tmpC[1] + tmpC[2] + tmpC[3];
+#endif
+                for (; x < outWidth; x++)
+                {
+                    float v[5] = {0, 0, 0, 0, 0};
+                    for (int k = 0; k < kGaussTaps; k++)
+                    {
+                        for (int q = 0; q < 5; q++)
+                        {
+                            v[q] += w[k] * rows[k][q][x];
+                        }
+                    }
+                    float mu12   = v[0] * v[1];
+                    float mu11   = v[0] * v[0];
+                    float mu22   = v[1] * v[1];
+                    float csv    = (2 * (v[4] - mu12) + static_cast<float>(kSsimC2)) / ((v[2] - mu11) + (v[3] - mu22) + static_cast<float>(kSsimC2));
+                    float lv     = (2 * mu12 + static_cast<float>(kSsimC1)) / (mu11 + mu22 + static_cast<float>(kSsimC1));
+                    rowCs       += csv;
+                    rowSsim     += lv * csv;
+                }
+                // 行内用 float 累加，跨行用 double，避免大图累计误差
+                bandSsim += rowSsim;
+                bandCs += rowCs;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ssimSum += bandSsim;
+            csSum += bandCs;
+        });
+
+        double count = static_cast<double>(outWidth) * outHeight;
+        if (cs)
+        {
+            *cs = csSum / count;
+        }
+        return ssimSum / count;
+    }
+
+    /**
+     * @brief   将8位平面转换为连续存储的浮点平面
+     */
+    std::vector<float> plane_to_float(const uint8_t* plane, int stride, int width, int height)
+    {
+        std::vector<float> out(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; y++)
+        {
+            const uint8_t* src = plane + static_cast<size_t>(y) * stride;
+            float*         dst = out.data() + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; x++)
+            {
+                dst[x] = src[x];
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief   2x2 均值下采样
+     */
+    std::vector<float> downsample_2x2(const std::vector<float>& src, int width, int height)
+    {
+        int                outWidth  = width / 2;
+        int                outHeight = height / 2;
+        std::vector<float> out(static_cast<size_t>(outWidth) * outHeight);
+        for (int y = 0; y < outHeight; y++)
+        {
+            const float* r0  = src.data() + static_cast<size_t>(2 * y) * width;
+            const float* r1  = r0 + width;
+            float*       dst = out.data() + static_cast<size_t>(y) * outWidth;
+            for (int x = 0; x < outWidth; x++)
+            {
+                dst[x] = (r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1]) * 0.25f;
+            }
+        }
+        return out;
+    }
+} // namespace
+
+double ssim_plane_8x8(const uint8_t* plane1, int stride1, const uint8_t* plane2, int stride2, int width, int height)
+{
+    int blocksX = width / 4;
+    int blocksY = height / 4;
+    if (blocksX < 2 || blocksY < 2)
+    {
+        return 1.0;
+    }
+
+    // 窗口行数 = 块行数 - 1，每个窗口由上下两行块组成
+    int        windowRows = blocksY - 1;
+    double     total      = 0.0;
+    std::mutex mutex;
+
+    auto band = [&](int begin, int end) {
+        std::vector<int> sums(static_cast<size_t>(blocksX) * 8);
+        int*             top[4] = {sums.data(), sums.data() + blocksX, sums.data() + 2 * blocksX, sums.data() + 3 * blocksX};
+        int*             bot[4] = {sums.data() + 4 * blocksX, sums.data() + 5 * blocksX, sums.data() + 6 * blocksX, sums.data() + 7 * blocksX};
+
+        auto blockRow = [&](int by, int* const dst[4]) {
+            ssim_4x4_row(plane1 + static_cast<size_t>(by) * 4 * stride1, stride1,
+                         plane2 + static_cast<size_t>(by) * 4 * stride2, stride2,
+                         blocksX, dst[0], dst[1], dst[2], dst[3]);
+        };
+
+        double bandSum = 0.0;
+        blockRow(begin, top);
+        for (int by = begin; by < end; by++)
+        {
+            blockRow(by + 1, bot);
+            for (int x = 0; x < blocksX - 1; x++)
+            {
+                double s[4];
+                for (int q = 0; q < 4; q++)
+                {
+                    s[q] = static_cast<double>(top[q][x]) + top[q][x + 1] + bot[q][x] + bot[q][x + 1];
+                }
+                bandSum += ssim_end(s[0], s[1], s[2], s[3]);
+            }
+            std::swap(top, bot);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        total += bandSum;
+    };
+    parallel_for_rows(windowRows, band, 4);
+
+    return total / (static_cast<double>(blocksX - 1) * windowRows);
+}
+
+double ssim_plane_gaussian(const uint8_t* plane1, int stride1, const uint8_t* plane2, int stride2, int width, int height, double* cs)
+{
+    std::vector<float> a = plane_to_float(plane1, stride1, width, height);
+    std::vector<float> b = plane_to_float(plane2, stride2, width, height);
+    return ssim_gaussian_float(a.data(), b.data(), width, height, cs);
+}
+
+double msssim_plane(const uint8_t* plane1, int stride1, const uint8_t* plane2, int stride2, int width, int height)
+{
+    std::vector<float> a = plane_to_float(plane1, stride1, width, height);
+    std::vector<float> b = plane_to_float(plane2, stride2, width, height);
+
+    double ssim[kMsScales] = {0};
+    double cs[kMsScales]   = {0};
+    int    scales          = 0;
+    while (scales < kMsScales && width >= kGaussTaps && height >= kGaussTaps)
+    {
+        ssim[scales] = ssim_gaussian_float(a.data(), b.data(), width, height, &cs[scales]);
+        scales++;
+        if (scales < kMsScales)
+        {
+            a = downsample_2x2(a, width, height);
+            b = downsample_2x2(b, width, height);
+            width /= 2;
+            height /= 2;
+        }
+    }
+    if (scales == 0)
+    {
+        return 1.0;
+    }
+
+    // 尺度不足5个时，按实际使用的尺度归一化权重
+    double weightSum = 0.0;
+    for (int i = 0; i < scales; i++)
+    {
+        weightSum += kMsWeight[i];
+    }
+    double result = 1.0;
+    for (int i = 0; i < scales - 1; i++)
+    {
+        result *= std::pow(std::max(cs[i], 0.0), kMsWeight[i] / weightSum);
+    }
+    result *= std::pow(std::max(ssim[scales - 1], 0.0), kMsWeight[scales - 1] / weightSum);
+    return result;
+}
+
+int simplest_yuv420_ssim(const std::string& filename1, const std::string& filename2, int width, int height, int number)
+{
+    std::ifstream iFile1(filename1, std::ios::in | std::ios::binary);
+    std::ifstream iFile2(filename2, std::ios::in | std::ios::binary);
+    if (!iFile1.is_open() || !iFile2.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {} or {}", filename1, filename2);
+        return -1;
+    }
+
+    int      frameSize = width * height * 3 / 2; // YUV420P每帧大小
+    int      ySize     = width * height;         // Y分量大小
+    uint8_t* frame1    = new uint8_t[frameSize];
+    uint8_t* frame2    = new uint8_t[frameSize];
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile1.read(reinterpret_cast<char*>(frame1), frameSize) || !iFile2.read(reinterpret_cast<char*>(frame2), frameSize))
+        {
+            break;
+        }
+
+        double y = ssim_plane_8x8(frame1, width, frame2, width, width, height);
+        double u = ssim_plane_8x8(frame1 + ySize, width / 2, frame2 + ySize, width / 2, width / 2, height / 2);
+        double v = ssim_plane_8x8(frame1 + ySize * 5 / 4, width / 2, frame2 + ySize * 5 / 4, width / 2, width / 2, height / 2);
+        // 按平面像素数加权：Y:U:V = 4:1:1
+        double all = (4 * y + u + v) / 6;
+        SPDLOG_INFO("Frame {}: SSIM Y = {:.4f} U = {:.4f} V = {:.4f} All = {:.4f}", i, y, u, v, all);
+    }
+
+    delete[] frame1;
+    delete[] frame2;
+    iFile1.close();
+    iFile2.close();
+
+    return 0;
+}
+
+int simplest_yuv420_msssim(const std::string& filename1, const std::string& filename2, int width, int height, int number)
+{
+    std::ifstream iFile1(filename1, std::ios::in | std::ios::binary);
+    std::ifstream iFile2(filename2, std::ios::in | std::ios::binary);
+    if (!iFile1.is_open() || !iFile2.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {} or {}", filename1, filename2);
+        return -1;
+    }
+
+    int      frameSize = width * height * 3 / 2; // YUV420P每帧大小
+    uint8_t* frame1    = new uint8_t[frameSize];
+    uint8_t* frame2    = new uint8_t[frameSize];
+
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile1.read(reinterpret_cast<char*>(frame1), frameSize) || !iFile2.read(reinterpret_cast<char*>(frame2), frameSize))
+        {
+            break;
+        }
+
+        double ssim = ssim_plane_gaussian(frame1, width, frame2, width, width, height);
+        double ms   = msssim_plane(frame1, width, frame2, width, width, height);
+        SPDLOG_INFO("Frame {}: SSIM(gaussian) = {:.4f} MS-SSIM = {:.4f}", i, ssim, ms);
+    }
+
+    delete[] frame1;
+    delete[] frame2;
+    iFile1.close();
+    iFile2.close();
+
+    return 0;
+}
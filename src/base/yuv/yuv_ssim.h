@@ -0,0 +1,72 @@
+#ifndef __YUV_SSIM_H__
+#define __YUV_SSIM_H__
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief   计算单个平面的SSIM（8x8窗口，步长4）
+ * 先求每个4x4块的 Σa、Σb、Σa²+Σb²、Σab，再由相邻2x2个块拼成8x8窗口，
+ * 相邻窗口共享块和，避免重复累加
+ * @param   plane1                  [IN]        平面1
+ * @param   stride1                 [IN]        平面1行跨度（字节）
+ * @param   plane2                  [IN]        平面2
+ * @param   stride2                 [IN]        平面2行跨度（字节）
+ * @param   width                   [IN]        平面宽度
+ * @param   height                  [IN]        平面高度
+ * @return  平均SSIM，平面小于8x8时返回1.0
+ */
+double ssim_plane_8x8(const uint8_t* plane1, int stride1, const uint8_t* plane2, int stride2, int width, int height);
+
+/**
+ * @brief   计算单个平面的SSIM（11x11高斯窗口，sigma=1.5）
+ * 高斯窗口可分离，先水平后垂直，垂直方向使用11行环形缓冲区滑动累加
+ * @param   plane1                  [IN]        平面1
+ * @param   stride1                 [IN]        平面1行跨度（字节）
+ * @param   plane2                  [IN]        平面2
+ * @param   stride2                 [IN]        平面2行跨度（字节）
+ * @param   width                   [IN]        平面宽度
+ * @param   height                  [IN]        平面高度
+ * @param   cs                      [OUT]       对比度-结构分量均值，可为空
+ * @return  平均SSIM，平面小于11x11时返回1.0
+ */
+double ssim_plane_gaussian(const uint8_t* plane1, int stride1, const uint8_t* plane2, int stride2, int width, int height, double* cs = nullptr);
+
+/**
+ * @brief   计算单个平面的MS-SSIM（5个尺度，Wang 2003 权重）
+ * 每个尺度2x2均值下采样，尺度过小时提前结束并对剩余权重归一化
+ * @param   plane1                  [IN]        平面1
+ * @param   stride1                 [IN]        平面1行跨度（字节）
+ * @param   plane2                  [IN]        平面2
+ * @param   stride2                 [IN]        平面2行跨度（字节）
+ * @param   width                   [IN]        平面宽度
+ * @param   height                  [IN]        平面高度
+ * @return  MS-SSIM
+ */
+double msssim_plane(const uint8_t* plane1, int stride1, const uint8_t* plane2, int stride2, int width, int height);
+
+/**
+ * @brief   计算两个YUV420P像素数据的SSIM（8x8窗口）
+ * @param   filename1               [IN]        yuv420 输入文件路径
+ * @param   filename2               [IN]        yuv420 输入文件路径2
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_ssim(const std::string& filename1, const std::string& filename2, int width, int height, int number);
+
+/**
+ * @brief   计算两个YUV420P像素数据亮度分量的MS-SSIM
+ * @param   filename1               [IN]        yuv420 输入文件路径
+ * @param   filename2               [IN]        yuv420 输入文件路径2
+ * @param   width                   [IN]        yuv420 图像帧的宽度
+ * @param   height                  [IN]        yuv420 图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ */
+int simplest_yuv420_msssim(const std::string& filename1, const std::string& filename2, int width, int height, int number);
+
+#endif
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "base/common/parallel.hpp"
+#include "yuv_plane.h"
+#include "yuv_stats.h"
+
+namespace
+{
+    constexpr int kSubTables        = 4;  // 每个线程的交错子直方图个数
+    constexpr int kMinRowsPerThread = 32; // 每个线程最少处理的行数
+
+    typedef uint32_t Histogram[kSubTables][256];
+
+    /**
+     * @brief   一行像素计入直方图
+     * 散列式的计数无法用 SSE2/NEON 向量化，这里每次读 8 个字节再拆开，
+     * 相邻像素落在不同的子直方图上，消除相同值连续出现时的存储-加载依赖
+     */
+    void histogram_row(const uint8_t* src, int width, Histogram hist)
+    {
+        int x = 0;
+        for (; x + 8 <= width; x += 8)
+        {
+            uint64_t v;
+            memcpy(&v, src + x, sizeof(v));
+            hist[0][v & 0xff]++;
+            hist[1][(v >> 8) & 0xff]++;
+            hist[2][(v >> 16) & 0xff]++;
+            hist[3][(v >> 24) & 0xff]++;
+            hist[0][(v >> 32) & 0xff]++;
+            hist[1][(v >> 40) & 0xff]++;
+            hist[2][(v >> 48) & 0xff]++;
+            hist[3][v >> 56]++;
+        }
+        for (; x < width; x++)
+        {
+            hist[x & 3][src[x]]++;
+        }
+    }
+
+    /**
+     * @brief   一行交织色度计入 U、V 直方图
+     * @param   width                   [IN]        色度宽度（UV 对数）
+     */
+    void histogram_row_uv(const uint8_t* src, int width, Histogram histU, Histogram histV)
+    {
+        int x = 0;
+        for (; x + 4 <= width; x += 4)
+        {
+            uint64_t v;
+            memcpy(&v, src + x * 2, sizeof(v));
+            histU[0][v & 0xff]++;
+            histV[0][(v >> 8) & 0xff]++;
+            histU[1][(v >> 16) & 0xff]++;
+            histV[1][(v >> 24) & 0xff]++;
+            histU[2][(v >> 32) & 0xff]++;
+            histV[2][(v >> 40) & 0xff]++;
+            histU[3][(v >> 48) & 0xff]++;
+            histV[3][v >> 56]++;
+        }
+        for (; x < width; x++)
+        {
+            histU[x & 3][src[x * 2]]++;
+            histV[x & 3][src[x * 2 + 1]]++;
+        }
+    }
+
+    void histogram_merge(const Histogram partial, uint32_t* histogram)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            histogram[i] += partial[0][i] + partial[1][i] + partial[2][i] + partial[3][i];
+        }
+    }
+
+    /**
+     * @brief   对平面做直方图，线程各自累加局部直方图，最后合并
+     */
+    void histogram_plane(const uint8_t* plane, int stride, int width, int height, uint32_t* histogram)
+    {
+        std::mutex mutex;
+
+        auto rows = [&](int begin, int end) {
+            Histogram local = {};
+            for (int y = begin; y < end; y++)
+            {
+                histogram_row(plane + static_cast<size_t>(y) * stride, width, local);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            histogram_merge(local, histogram);
+        };
+        parallel_for_rows(height, rows, kMinRowsPerThread);
+    }
+
+    /**
+     * @brief   由直方图计算最小/最大/均值/方差
+     */
+    void plane_finish(PlaneStats& stats)
+    {
+        uint64_t count = 0, sum = 0, sumSq = 0;
+        stats.min      = -1;
+        stats.max      = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            uint64_t n = stats.histogram[i];
+            if (n == 0)
+            {
+                continue;
+            }
+            if (stats.min < 0)
+            {
+                stats.min = i;
+            }
+            stats.max = i;
+            count += n;
+            sum += n * i;
+            sumSq += n * i * i;
+        }
+        stats.min      = std::max(stats.min, 0);
+        stats.mean     = count ? static_cast<double>(sum) / count : 0.0;
+        stats.variance = count ? static_cast<double>(sumSq) / count - stats.mean * stats.mean : 0.0;
+    }
+} // namespace
+
+FrameAnalyzer::FrameAnalyzer(YuvFormat format, int width, int height)
+    : m_format(format)
+    , m_width(width)
+    , m_height(height)
+    , m_black_luma(32)
+    , m_black_ratio(0.98)
+    , m_frozen_mafd(0.25)
+    , m_scene_threshold(0.3)
+    , m_index(0)
+    , m_last_mafd(0.0)
+    , m_sad(0)
+    , m_previous(static_cast<size_t>(width) * height)
+    , m_stats()
+{
+}
+
+FrameAnalyzer& FrameAnalyzer::SetBlack(int luma, double ratio)
+{
+    m_black_luma  = std::clamp(luma, 0, 255);
+    m_black_ratio = ratio;
+    return *this;
+}
+
+FrameAnalyzer& FrameAnalyzer::SetFrozen(double mafd)
+{
+    m_frozen_mafd = mafd;
+    return *this;
+}
+
+FrameAnalyzer& FrameAnalyzer::SetSceneThreshold(double score)
+{
+    m_scene_threshold = score;
+    return *this;
+}
+
+void FrameAnalyzer::Reset()
+{
+    m_index     = 0;
+    m_last_mafd = 0.0;
+}
+
+const FrameStats& FrameAnalyzer::Analyze(const YuvFrame& frame)
+{
+    m_stats       = FrameStats();
+    m_stats.index = m_index;
+
+    AnalyzeLuma(frame);
+    AnalyzeChroma(frame);
+    for (auto& plane : m_stats.planes)
+    {
+        plane_finish(plane);
+    }
+
+    double   pixels = static_cast<double>(m_width) * m_height;
+    uint64_t dark   = 0;
+    for (int i = 0; i <= m_black_luma; i++)
+    {
+        dark += m_stats.planes[0].histogram[i];
+    }
+    m_stats.black_ratio = dark / pixels;
+    m_stats.black       = m_stats.black_ratio >= m_black_ratio;
+
+    if (m_index > 0)
+    {
+        m_stats.mafd         = m_sad / pixels;
+        m_stats.scene_score  = std::clamp(std::min(m_stats.mafd, std::fabs(m_stats.mafd - m_last_mafd)) / 100.0, 0.0, 1.0);
+        m_stats.frozen       = m_stats.mafd <= m_frozen_mafd;
+        m_stats.scene_change = m_stats.scene_score >= m_scene_threshold;
+        m_last_mafd          = m_stats.mafd;
+    }
+
+    m_index++;
+    return m_stats;
+}
+
+void FrameAnalyzer::AnalyzeLuma(const YuvFrame& frame)
+{
+    std::mutex mutex;
+    bool       compare = m_index > 0;
+    m_sad              = 0;
+
+    // 直方图、与上一帧的 SAD、保存本帧亮度在同一趟里完成
+    auto rows = [&](int begin, int end) {
+        Histogram local = {};
+        uint64_t  sad   = 0;
+        for (int y = begin; y < end; y++)
+        {
+            const uint8_t* row      = frame.data[0] + static_cast<size_t>(y) * frame.stride[0];
+            uint8_t*       previous = m_previous.Data() + static_cast<size_t>(y) * m_width;
+            histogram_row(row, m_width, local);
+            if (compare)
+            {
+                sad += plane_sad(row, m_width, previous, m_width, m_width, 1);
+            }
+            memcpy(previous, row, m_width);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        histogram_merge(local, m_stats.planes[0].histogram);
+        m_sad += sad;
+    };
+    parallel_for_rows(m_height, rows, kMinRowsPerThread);
+}
+
+void FrameAnalyzer::AnalyzeChroma(const YuvFrame& frame)
+{
+    int shiftX, shiftY;
+    yuv_chroma_shift(m_format, shiftX, shiftY);
+    int chromaWidth  = (m_width + (1 << shiftX) - 1) >> shiftX;
+    int chromaHeight = (m_height + (1 << shiftY) - 1) >> shiftY;
+
+    if (!yuv_is_semi_planar(m_format))
+    {
+        histogram_plane(frame.data[1], frame.stride[1], chromaWidth, chromaHeight, m_stats.planes[1].histogram);
+        histogram_plane(frame.data[2], frame.stride[2], chromaWidth, chromaHeight, m_stats.planes[2].histogram);
+        return;
+    }
+
+    // NV12 的 UV 交织，NV21 的 VU 交织
+    uint32_t*  histU = m_stats.planes[m_format == YUV_FORMAT_NV12 ? 1 : 2].histogram;
+    uint32_t*  histV = m_stats.planes[m_format == YUV_FORMAT_NV12 ? 2 : 1].histogram;
+    std::mutex mutex;
+
+    auto rows = [&](int begin, int end) {
+        Histogram localU = {};
+        Histogram localV = {};
+        for (int y = begin; y < end; y++)
+        {
+            histogram_row_uv(frame.data[1] + static_cast<size_t>(y) * frame.stride[1], chromaWidth, localU, localV);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        histogram_merge(localU, histU);
+        histogram_merge(localV, histV);
+    };
+    parallel_for_rows(chromaHeight, rows, kMinRowsPerThread);
+}
+
+int simplest_yuv_stats(const std::string& filename, YuvFormat format, int width, int height, int number)
+{
+    std::ifstream iFile(filename, std::ios::in | std::ios::binary);
+    std::ofstream oFile(filename + ".stats", std::ios::out);
+    if (!iFile.is_open())
+    {
+        SPDLOG_ERROR("Failed to open file: {}", filename);
+        return -1;
+    }
+
+    int                  frameSize = yuv_frame_size(format, width, height); // 每帧字节数
+    std::vector<uint8_t> buffer(frameSize);
+    YuvFrame             frame = yuv_frame_wrap(buffer.data(), format, width, height);
+    FrameAnalyzer        analyzer(format, width, height);
+    int                  blackStart  = -1; // 当前黑帧区间的起点
+    int                  frozenStart = -1; // 当前静止区间的起点（含作为参照的前一帧）
+    int                  frames      = 0;
+    int                  scenes      = 0;
+
+    oFile << "frame,y_min,y_max,y_mean,y_variance,u_mean,v_mean,black_ratio,mafd,scene_score,black,frozen,scene_change\n";
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < number; i++)
+    {
+        if (!iFile.read(reinterpret_cast<char*>(buffer.data()), frameSize))
+        {
+            break;
+        }
+        const FrameStats& stats = analyzer.Analyze(frame);
+        const PlaneStats& y     = stats.planes[0];
+        oFile << fmt::format("{},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.4f},{:.3f},{:.4f},{:d},{:d},{:d}\n", i, y.min, y.max, y.mean, y.variance, stats.planes[1].mean, stats.planes[2].mean, stats.black_ratio, stats.mafd,
+                             stats.scene_score, stats.black, stats.frozen, stats.scene_change);
+
+        if (stats.black && blackStart < 0)
+        {
+            blackStart = i;
+        }
+        else if (!stats.black && blackStart >= 0)
+        {
+            SPDLOG_INFO("Black frames: {}-{}", blackStart, i - 1);
+            blackStart = -1;
+        }
+        if (stats.frozen && frozenStart < 0)
+        {
+            frozenStart = i - 1;
+        }
+        else if (!stats.frozen && frozenStart >= 0)
+        {
+            SPDLOG_INFO("Frozen frames: {}-{}", frozenStart, i - 1);
+            frozenStart = -1;
+        }
+        if (stats.scene_change)
+        {
+            SPDLOG_INFO("Scene change at frame {}: score = {:.3f}", i, stats.scene_score);
+            scenes++;
+        }
+        frames++;
+    }
+    if (blackStart >= 0)
+    {
+        SPDLOG_INFO("Black frames: {}-{}", blackStart, frames - 1);
+    }
+    if (frozenStart >= 0)
+    {
+        SPDLOG_INFO("Frozen frames: {}-{}", frozenStart, frames - 1);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    SPDLOG_INFO("Stats {}x{} {}: {} frames, {} scene changes, {:.0f} fps", width, height, yuv_format_name(format), frames, scenes, seconds > 0 ? frames / seconds : 0.0);
+
+    iFile.close();
+    oFile.close();
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#ifndef __YUV_STATS_H__
+#define __YUV_STATS_H__
+
+#include <cstdint>
+#include <string>
+
+#include "base/common/aligned_buffer.hpp"
+#include "yuv_frame.h"
+
+/**
+ * @brief   单个平面的统计量
+ */
+typedef struct PlaneStats
+{
+    uint32_t histogram[256]; // 直方图
+    int      min;            // 最小值
+    int      max;            // 最大值
+    double   mean;           // 均值
+    double   variance;       // 方差
+} PlaneStats;
+
+/**
+ * @brief   单帧的统计结果
+ */
+typedef struct FrameStats
+{
+    int        index;        // 帧序号
+    PlaneStats planes[3];    // Y、U、V 平面统计
+    double     black_ratio;  // 黑像素（亮度不超过黑电平）占比
+    double     mafd;         // 与上一帧亮度的平均绝对差，第一帧为 0
+    double     scene_score;  // 场景切换分数 [0, 1]
+    bool       black;        // 黑帧
+    bool       frozen;       // 静止帧（与上一帧几乎相同）
+    bool       scene_change; // 场景切换
+} FrameStats;
+
+/**
+ * @brief   逐帧统计分析器（流式，按顺序送入帧）
+ * 1. 亮度一趟完成：直方图、与上一帧的 SAD（psadbw）以及保存本帧亮度供下一帧比较，每行只读一次
+ * 2. 直方图按行带多线程，每个线程在自己的局部直方图上累加，行带结束时合并一次；
+ *    线程内再拆成 4 张交错的子直方图，相邻像素值相同时不会互相等待同一计数器
+ * 3. 最小/最大/均值/方差由直方图得出，不需要再遍历像素
+ * 场景切换分数与 ffmpeg select 滤镜的 scene 一致：min(mafd, |mafd - 上一帧 mafd|) / 100
+ */
+class FrameAnalyzer
+{
+public:
+    /**
+     * @param   format                  [IN]        像素格式
+     * @param   width                   [IN]        图像帧的宽度
+     * @param   height                  [IN]        图像帧的高度
+     */
+    FrameAnalyzer(YuvFormat format, int width, int height);
+    ~FrameAnalyzer() = default;
+
+    /**
+     * @brief   黑帧判定：亮度不超过 luma 的像素占比不小于 ratio
+     */
+    FrameAnalyzer& SetBlack(int luma, double ratio);
+
+    /**
+     * @brief   静止帧判定：与上一帧的平均绝对差不超过 mafd
+     */
+    FrameAnalyzer& SetFrozen(double mafd);
+
+    /**
+     * @brief   场景切换判定：场景切换分数不小于 score
+     */
+    FrameAnalyzer& SetSceneThreshold(double score);
+
+    /**
+     * @brief   分析下一帧
+     * @param   frame                   [IN]        帧视图，格式和尺寸与构造参数一致
+     * @return  本帧统计结果，在下一次调用前有效
+     */
+    const FrameStats& Analyze(const YuvFrame& frame);
+
+    /**
+     * @brief   重新开始一个序列（清除上一帧）
+     */
+    void Reset();
+
+private:
+    void AnalyzeLuma(const YuvFrame& frame);
+    void AnalyzeChroma(const YuvFrame& frame);
+
+private:
+    YuvFormat              m_format;          // 像素格式
+    int                    m_width;           // 宽度
+    int                    m_height;          // 高度
+    int                    m_black_luma;      // 黑电平
+    double                 m_black_ratio;     // 黑帧的黑像素占比阈值
+    double                 m_frozen_mafd;     // 静止帧阈值
+    double                 m_scene_threshold; // 场景切换阈值
+    int                    m_index;           // 下一帧的序号
+    double                 m_last_mafd;       // 上一帧的 mafd
+    uint64_t               m_sad;             // 本帧亮度 SAD
+    AlignedBuffer<uint8_t> m_previous;        // 上一帧亮度
+    FrameStats             m_stats;           // 本帧统计结果
+};
+
+/**
+ * @brief   统计YUV像素数据序列：逐帧直方图、均值、方差，并检测黑帧、静止帧和场景切换
+ * @param   filename                [IN]        输入文件路径
+ * @param   format                  [IN]        像素格式
+ * @param   width                   [IN]        图像帧的宽度
+ * @param   height                  [IN]        图像帧的高度
+ * @param   number                  [IN]        处理的帧数
+ * @return  0                                   成功
+ *          其他                                失败
+ * 每帧一行写入 <filename>.stats（CSV），黑帧、静止帧区间和场景切换输出到日志
+ */
+int simplest_yuv_stats(const std::string& filename, YuvFormat format, int width, int height, int number);
+
+#endif
@@ -14,6 +14,7 @@ OutputAudio::OutputAudio(SyncClock* sync, AVRational time_base, const AudioParam
     m_audio_buf_size  = 0;
     m_audio_buf_index = 0;
     m_pts             = AV_NOPTS_VALUE;
+    m_loudness_frames = 0;
 }
 
 OutputAudio::~OutputAudio()
@@ -37,8 +38,13 @@ void OutputAudio::read_audio_data(void* udata, Uint8* stream, int len)
             if (frame)
             {
                 audio->m_pts = frame->pts;
+                // 浮点输入且声道数与输出一致时由多相重采样器处理，不需要 swr
+                int  channels = frame->ch_layout.nb_channels;
+                bool planar   = frame->format == AV_SAMPLE_FMT_FLTP;
+                bool native   = (planar || frame->format == AV_SAMPLE_FMT_FLT) && channels == audio->m_dst_params.ch_layout.nb_channels;
                 // 检查是否需要重采样
-                if (((frame->format != audio->m_dst_params.fmt) ||
+                if (!native &&
+                    ((frame->format != audio->m_dst_params.fmt) ||
                      (frame->sample_rate != audio->m_dst_params.freq) ||
                      (av_channel_layout_compare(&frame->ch_layout, &audio->m_dst_params.ch_layout))) &&
                     (audio->m_swr_ctx == nullptr))
@@ -60,7 +66,33 @@ void OutputAudio::read_audio_data(void* udata, Uint8* stream, int len)
                         return;
                     }
                 }
-                if (audio->m_swr_ctx)
+                if (native)
+                {
+                    // 采样率变化时重建重采样器，采样率相同时只做平面转交织
+                    if (!audio->m_resampler || audio->m_resampler->InputRate() != frame->sample_rate)
+                    {
+                        audio->m_resampler = std::make_unique<Resampler>(frame->sample_rate, audio->m_dst_params.freq, channels);
+                    }
+                    int out_samples = audio->m_resampler->MaxOutput(frame->nb_samples);
+                    av_fast_malloc(&audio->m_audio_buf, (unsigned int*)&audio->m_audio_buf_size, out_samples * channels * sizeof(float));
+                    if (audio->m_audio_buf == nullptr)
+                    {
+                        spdlog::error("Failed to allocate audio buffer");
+                        return;
+                    }
+                    float* out         = reinterpret_cast<float*>(audio->m_audio_buf);
+                    int    convert_len = 0;
+                    if (planar)
+                    {
+                        convert_len = audio->m_resampler->Process(reinterpret_cast<const float* const*>(frame->extended_data), frame->nb_samples, out, out_samples);
+                    }
+                    else
+                    {
+                        convert_len = audio->m_resampler->ProcessInterleaved(reinterpret_cast<const float*>(frame->data[0]), frame->nb_samples, out, out_samples);
+                    }
+                    audio->m_audio_buf_size = convert_len * channels * sizeof(float);
+                }
+                else if (audio->m_swr_ctx)
                 {
                     // 重采样处理
                     uint8_t** in          = frame->extended_data;
@@ -89,6 +121,26 @@ void OutputAudio::read_audio_data(void* udata, Uint8* stream, int len)
                     memcpy(audio->m_audio_buf, frame->data[0], audio->m_audio_buf_size);
                 }
                 av_frame_free(&frame);
+
+                // 变速在输出采样率上进行，计算量只与输出时长有关，高倍速时不增加负担
+                double speed = audio->m_sync->GetSpeed();
+                if (audio->m_audio_buf && (speed != 1.0 || audio->m_stretcher))
+                {
+                    audio->StretchAudio(speed);
+                }
+
+                // 测量实际送给 SDL 的数据，每秒打印一次瞬时 / 短期响度
+                if (audio->m_audio_buf && audio->m_loudness)
+                {
+                    int frames = static_cast<int>(audio->m_audio_buf_size / (audio->m_loudness->Channels() * sizeof(float)));
+                    audio->m_loudness->Process(reinterpret_cast<const float*>(audio->m_audio_buf), frames);
+                    audio->m_loudness_frames += frames;
+                    if (audio->m_loudness_frames >= audio->m_dst_params.freq)
+                    {
+                        audio->m_loudness_frames = 0;
+                        spdlog::debug("loudness M: {:.1f} LUFS, S: {:.1f} LUFS", audio->m_loudness->Momentary(), audio->m_loudness->ShortTerm());
+                    }
+                }
             }
             else
             {
@@ -125,6 +177,34 @@ void OutputAudio::read_audio_data(void* udata, Uint8* stream, int len)
     }
 }
 
+void OutputAudio::StretchAudio(double speed)
+{
+    int channels = m_dst_params.ch_layout.nb_channels;
+    if (!m_stretcher)
+    {
+        m_stretcher = std::make_unique<TimeStretcher>(m_dst_params.freq, channels);
+    }
+    m_stretcher->SetSpeed(speed);
+
+    // m_audio_buf 为交织 float（m_dst_params.fmt），输出不足一跳时本次为空，下次回调补齐
+    int frames   = static_cast<int>(m_audio_buf_size / (channels * sizeof(float)));
+    int capacity = m_stretcher->MaxOutput(frames);
+    m_stretch_buf.resize(static_cast<size_t>(capacity) * channels);
+    int    count = m_stretcher->Process(reinterpret_cast<const float*>(m_audio_buf), frames, m_stretch_buf.data(), capacity);
+    size_t bytes = count * channels * sizeof(float);
+
+    // 慢放时输出比输入长，输入已拷入 m_stretcher，缓冲区可以直接重新分配
+    av_fast_malloc(&m_audio_buf, (unsigned int*)&m_audio_buf_size, bytes);
+    if (m_audio_buf == nullptr)
+    {
+        spdlog::error("Failed to allocate audio buffer");
+        m_audio_buf_size = 0;
+        return;
+    }
+    memcpy(m_audio_buf, m_stretch_buf.data(), bytes);
+    m_audio_buf_size = bytes;
+}
+
 bool OutputAudio::Init()
 {
     int ret = 0;
@@ -138,7 +218,7 @@ bool OutputAudio::Init()
     SDL_AudioSpec wanted_spec;
     SDL_zero(wanted_spec);
     wanted_spec.freq     = m_src_params.freq;
-    wanted_spec.format   = AUDIO_S16SYS;
+    wanted_spec.format   = AUDIO_F32SYS;
     wanted_spec.channels = 2;
     wanted_spec.silence  = 0;
     wanted_spec.samples  = 1024 * 2;
@@ -152,9 +232,10 @@ bool OutputAudio::Init()
         return false;
     }
     av_channel_layout_default(&m_dst_params.ch_layout, wanted_spec.channels);
-    m_dst_params.fmt        = AV_SAMPLE_FMT_S16;
+    m_dst_params.fmt        = AV_SAMPLE_FMT_FLT;
     m_dst_params.freq       = wanted_spec.freq;
     m_dst_params.frame_size = wanted_spec.samples;
+    m_loudness              = std::make_unique<LoudnessMeter>(m_dst_params.freq, wanted_spec.channels);
     SDL_PauseAudio(0);
 
     return true;
@@ -170,4 +251,12 @@ void OutputAudio::DeInit()
     {
         swr_free(&m_swr_ctx);
     }
+    m_resampler.reset();
+    m_stretcher.reset();
+
+    if (m_loudness)
+    {
+        spdlog::info("loudness I: {:.1f} LUFS, LRA: {:.1f} LU, true peak: {:.1f} dBTP", m_loudness->Integrated(), m_loudness->LoudnessRange(), m_loudness->TruePeak());
+        m_loudness.reset();
+    }
 }
\ No newline at end of file
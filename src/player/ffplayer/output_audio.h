@@ -11,6 +11,12 @@ extern "C" {
 }
 #endif
 
+#include <memory>
+#include <vector>
+
+#include "base/common/loudness.hpp"
+#include "base/common/resample.hpp"
+#include "base/common/timestretch.hpp"
 #include "queue_av_frame.h"
 #include "sync_clock.hpp"
 
@@ -33,16 +39,25 @@ public:
 
     static void read_audio_data(void* udata, Uint8* stream, int len);
 
+private:
+    void StretchAudio(double speed);
+
 public:
     SyncClock*    m_sync;        // 同步时钟
     AVRational    m_time_base;   // 时间基
     QueueAVFrame* m_frame_queue; // 输入帧队列
     AudioParams   m_src_params;  // 解码后的参数
     AudioParams   m_dst_params;  // SDL实际输出的格式
-    SwrContext*   m_swr_ctx;     // 重采样上下文
+    SwrContext*   m_swr_ctx;     // 重采样上下文（格式或声道布局需要转换时）
+
+    std::unique_ptr<Resampler>     m_resampler;   // 多相重采样器（浮点输入且声道数一致时）
+    std::unique_ptr<TimeStretcher> m_stretcher;   // 变速不变调（倍速不为 1 后创建）
+    std::vector<float>             m_stretch_buf; // 变速输出
+    std::unique_ptr<LoudnessMeter> m_loudness;    // 输出响度计（EBU R128）
 
     uint8_t* m_audio_buf;        // 重采样缓冲区
     size_t   m_audio_buf_size;   // 缓冲区大小
     size_t   m_audio_buf_index;  // 当前读取位置
     int64_t  m_pts;              // 当前帧的时间戳
+    int64_t  m_loudness_frames;  // 距离上次打印响度的帧数
 };
\ No newline at end of file
@@ -1,5 +1,8 @@
+#include <algorithm>
+
 #include <spdlog/spdlog.h>
 
+#include "base/common/timestretch.hpp"
 #include "output_video.h"
 
 OutputVideo::OutputVideo(SyncClock* sync, AVRational time_base, QueueAVFrame* queue, int width, int height)
@@ -77,6 +80,14 @@ bool OutputVideo::MainLoop()
                 spdlog::info("SDLK_ESCAPE");
                 return false;
             }
+            if (event.key.keysym.sym == SDLK_UP || event.key.keysym.sym == SDLK_DOWN)
+            {
+                // 上/下键每次调整 0.25 倍速，范围与音频变速一致
+                double step  = event.key.keysym.sym == SDLK_UP ? 0.25 : -0.25;
+                double speed = std::clamp(m_sync->GetSpeed() + step, TimeStretcher::kMinSpeed, TimeStretcher::kMaxSpeed);
+                m_sync->SetSpeed(speed);
+                spdlog::info("speed: {}", speed);
+            }
             break;
         case SDL_QUIT:
             spdlog::info("SDL_QUIT");
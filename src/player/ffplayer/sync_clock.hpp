@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <limits>
 
@@ -24,6 +25,7 @@ public:
     {
         pts_       = pts;
         pts_drift_ = pts - time;
+        time_      = time;
     }
 
     void SetClock(double pts)
@@ -34,8 +36,22 @@ public:
 
     double GetClock()
     {
+        // 两次设置之间时钟按倍速前进
         double time = GetTimeSeconds();
-        return pts_drift_ + time;
+        return pts_drift_ + time + (time - time_) * (speed_.load() - 1.0);
+    }
+
+    /**
+     * @brief   设置播放倍速，音频输出按它变速不变调，视频按时钟同步
+     */
+    void SetSpeed(double speed)
+    {
+        speed_.store(speed);
+    }
+
+    double GetSpeed() const
+    {
+        return speed_.load();
     }
 
 private:
@@ -48,6 +64,8 @@ private:
     }
 
 private:
-    double pts_       = 0.0;
-    double pts_drift_ = 0.0;
+    double              pts_       = 0.0;
+    double              pts_drift_ = 0.0;
+    double              time_      = 0.0;
+    std::atomic<double> speed_{1.0};
 };